@@ -4,25 +4,30 @@
 int main()
 {
 
-    struct TinyUTCTime utc_tm = {0, 55, 19, 28, 4, 2025}; // Example UTC time
-    int32_t unix_ts;
-    
-    err_t result = tinyutc_utc_to_unix(&utc_tm, &unix_ts);
+    struct TinyUTCTime utc_tm = {2025, 4, 28, 19, 55, 0, 0}; // Example UTC time
+    tinyutc_time_t unix_ts;
 
-    printf("Unix Timestamp: %d\n", unix_ts);
-    printf("UTC Time: %02d:%02d:%02d %02d/%02d/%04d\n", utc_tm.hour, utc_tm.minute, utc_tm.second, utc_tm.day, utc_tm.month, utc_tm.year);
+    tinyutc_utc_to_unix(&utc_tm, &unix_ts);
 
-    tinyutc_unix_to_utc(unix_ts, &utc_tm);
+    printf("Unix Timestamp: %u\n", unix_ts);
     printf("UTC Time: %02d:%02d:%02d %02d/%02d/%04d\n", utc_tm.hour, utc_tm.minute, utc_tm.second, utc_tm.day, utc_tm.month, utc_tm.year);
 
-    printf("Setting up an alarm 10 days into the future\n");
+    printf("Setting up an alarm 10 days and 7 seconds into the future\n");
 
-    // int32_t alarm_ts = unix_ts + (10); // 10 days in seconds
-    int32_t alarm_ts = unix_ts + (10 * _TINYUTC_SECS_PER_DAY); // 10 days in seconds
+    // No need to go through a timestamp, the date is updated in place
+    struct TinyUTCTime alarm_tm = utc_tm;
+    tinyutc_add_days(&alarm_tm, 10);
+    tinyutc_add_seconds(&alarm_tm, 7);
 
-    tinyutc_unix_to_utc(alarm_ts, &utc_tm);
+    printf("UTC Time: %02d:%02d:%02d %02d/%02d/%04d\n", alarm_tm.hour, alarm_tm.minute, alarm_tm.second, alarm_tm.day, alarm_tm.month, alarm_tm.year);
 
-    printf("Unix Timestamp: %d\n", alarm_ts);
-    printf("UTC Time: %02d:%02d:%02d %02d/%02d/%04d\n", utc_tm.hour, utc_tm.minute, utc_tm.second, utc_tm.day, utc_tm.month, utc_tm.year);
+    printf("Setting up a monthly alarm, on the last day of the month\n");
 
-}
\ No newline at end of file
+    alarm_tm = (struct TinyUTCTime){2025, 1, 31, 8, 0, 0, 0};
+    for (int i = 0; i < 3; i++)
+    {
+        printf("UTC Time: %02d:%02d:%02d %02d/%02d/%04d\n", alarm_tm.hour, alarm_tm.minute, alarm_tm.second, alarm_tm.day, alarm_tm.month, alarm_tm.year);
+        // Clamped to 28/02, then kept on the 28th (use a copy of the first alarm to come back to the 31st)
+        tinyutc_add_months(&alarm_tm, 1, TINYUTC_MONTH_CLAMP);
+    }
+}
@@ -16,12 +16,12 @@ int main()
     tinyutc_time_t current_timestamp = 0;
     tinyutc_utc_to_unix(&current_time, &current_timestamp);
 
-    // I want an alarm 10 days and 7 seconds in the future
-    tinyutc_time_t alarm_timestamp = current_timestamp + 10 * _TINYUTC_SECS_PER_DAY + 7;
+    // I want an alarm 10 days and 7 seconds in the future.
+    // The date is updated in place, without converting back and forth to a timestamp.
+    struct TinyUTCTime alarm_time = current_time;
 
-    struct TinyUTCTime alarm_time = {0};
-
-    tinyutc_unix_to_utc(&alarm_time, alarm_timestamp);
+    tinyutc_add_days(&alarm_time, 10);
+    tinyutc_add_seconds(&alarm_time, 7);
 
     // Some microcontrollers needs the week day to exhaustively set it up.
     uint8_t week_day = tinyutc_get_week_day(&current_time, 0);
@@ -0,0 +1,268 @@
+/**
+ * @file http_date.c
+ * @brief HTTP-date (RFC 7231) parser and formatter for TinyUTC library.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "tinyutc.h"
+#include "iso8601_parser.h"
+#include "http_date.h"
+#include "tinyutc_digits.h"
+#include "tinyutc_names.h"
+
+// End of the full day names of the RFC 850 form, after their three first letters
+static const char *const _http_day_suffixes[7] = {"day", "sday", "nesday", "rsday", "day", "urday", "day"};
+
+/**
+ * @brief Reads a fixed number of digits.
+ *
+ * @return The value, or -1 if a character is not a digit.
+ */
+static inline int32_t _http_digits(const char *str, int count)
+{
+    int32_t value = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t digit = (uint32_t)((unsigned char)str[i] - '0');
+        if (digit > 9)
+        {
+            return -1;
+        }
+        value = value * 10 + (int32_t)digit;
+    }
+    return value;
+}
+
+/**
+ * @brief Reads "hh:mm:ss", without checking the ranges.
+ */
+static inline bool _http_time(struct TinyUTCTime *utc_tm, const char *str)
+{
+    int32_t hour = _http_digits(str, 2);
+    int32_t minute = _http_digits(str + 3, 2);
+    int32_t second = _http_digits(str + 6, 2);
+
+    if (hour < 0 || minute < 0 || second < 0 || str[2] != ':' || str[5] != ':')
+    {
+        return false;
+    }
+    utc_tm->hour = (uint8_t)hour;
+    utc_tm->minute = (uint8_t)minute;
+    utc_tm->second = (uint8_t)second;
+    return true;
+}
+
+/**
+ * @brief Checks the ranges of a parsed date, and its week day.
+ */
+static err_t _http_check(const struct TinyUTCTime *utc_tm, int week_day)
+{
+    if (utc_tm->hour > 23 || utc_tm->minute > 59 || utc_tm->second > 60)
+    {
+        return TINYUTC_ISO8601_INVALID_TIME;
+    }
+    if (utc_tm->year < _TINYUTC_MIN_YEAR || utc_tm->day < 1 ||
+        utc_tm->day > _TINYUTC_GET_DAYS_IN_MONTH(utc_tm->month - 1, utc_tm->year) ||
+        tinyutc_get_week_day(utc_tm, false) != week_day)
+    {
+        return TINYUTC_ISO8601_INVALID_DATE;
+    }
+    return TINYUTC_ISO8601_OK;
+}
+
+/**
+ * @brief Parses the IMF-fixdate form, "Sun, 06 Nov 1994 08:49:37 GMT", of 29 characters.
+ */
+static err_t _parse_imf_fixdate(struct TinyUTCTime *utc_tm, const char *str)
+{
+    int week_day = _tinyutc_week_day_from_name(str);
+    int month = _tinyutc_month_from_name(str + 8);
+    int32_t day = _http_digits(str + 5, 2);
+    int32_t year = _http_digits(str + 12, 4);
+
+    if (week_day < 0 || month < 0 || day < 0 || year < 0 || str[3] != ',' || str[4] != ' ' || str[7] != ' ' ||
+        str[11] != ' ' || str[16] != ' ' || !_http_time(utc_tm, str + 17) ||
+        _tinyutc_load_name(str + 25) != _TINYUTC_NAME(' ', 'G', 'M') || str[28] != 'T')
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+
+    utc_tm->year = (uint16_t)year;
+    utc_tm->month = (uint8_t)month;
+    utc_tm->day = (uint8_t)day;
+    return _http_check(utc_tm, week_day);
+}
+
+/**
+ * @brief Parses the asctime form, "Sun Nov  6 08:49:37 1994", of 24 characters.
+ *
+ * The day is padded with a space, but a zero is accepted too.
+ */
+static err_t _parse_asctime(struct TinyUTCTime *utc_tm, const char *str)
+{
+    int week_day = _tinyutc_week_day_from_name(str);
+    int month = _tinyutc_month_from_name(str + 4);
+    int32_t day = str[8] == ' ' ? _http_digits(str + 9, 1) : _http_digits(str + 8, 2);
+    int32_t year = _http_digits(str + 20, 4);
+
+    if (week_day < 0 || month < 0 || day < 0 || year < 0 || str[3] != ' ' || str[7] != ' ' || str[10] != ' ' ||
+        !_http_time(utc_tm, str + 11) || str[19] != ' ')
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+
+    utc_tm->year = (uint16_t)year;
+    utc_tm->month = (uint8_t)month;
+    utc_tm->day = (uint8_t)day;
+    return _http_check(utc_tm, week_day);
+}
+
+/**
+ * @brief Parses the RFC 850 form, "Sunday, 06-Nov-94 08:49:37 GMT", of 30 to 33 characters.
+ */
+static err_t _parse_rfc850(struct TinyUTCTime *utc_tm, const char *str, size_t len)
+{
+    int week_day = _tinyutc_week_day_from_name(str);
+    const char *suffix;
+    size_t suffix_len;
+
+    if (week_day < 0)
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+
+    // The rest of the day name tells where the date starts
+    suffix = _http_day_suffixes[week_day];
+    suffix_len = strlen(suffix);
+    if (len != 3 + suffix_len + 24 || memcmp(str + 3, suffix, suffix_len) != 0)
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+    str += 3 + suffix_len;
+
+    int month = _tinyutc_month_from_name(str + 5);
+    int32_t day = _http_digits(str + 2, 2);
+    int32_t year = _http_digits(str + 9, 2);
+
+    if (month < 0 || day < 0 || year < 0 || str[0] != ',' || str[1] != ' ' || str[4] != '-' || str[8] != '-' ||
+        str[11] != ' ' || !_http_time(utc_tm, str + 12) || _tinyutc_load_name(str + 20) != _TINYUTC_NAME(' ', 'G', 'M') ||
+        str[23] != 'T')
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+
+    utc_tm->year = (uint16_t)(year < 69 ? 2000 + year : 1900 + year);
+    utc_tm->month = (uint8_t)month;
+    utc_tm->day = (uint8_t)day;
+    return _http_check(utc_tm, week_day);
+}
+
+err_t tinyutc_parse_http_date(struct TinyUTCTime *utc_tm, const char *http_date, size_t len)
+{
+    if (utc_tm == 0 || http_date == 0)
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+    if (len == 0)
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING;
+    }
+
+    utc_tm->microseconds = 0;
+    if (len == 29 && http_date[3] == ',')
+    {
+        return _parse_imf_fixdate(utc_tm, http_date);
+    }
+    if (len == 24)
+    {
+        return _parse_asctime(utc_tm, http_date);
+    }
+    if (len >= 30 && len <= 33)
+    {
+        return _parse_rfc850(utc_tm, http_date, len);
+    }
+    return TINYUTC_ISO8601_INVALID_FORMAT;
+}
+
+err_t tinyutc_parse_http_date_to_unix(const char *http_date, size_t len, tinyutc_time_t *unix_ts)
+{
+    struct TinyUTCTime utc_tm;
+    err_t error = tinyutc_parse_http_date(&utc_tm, http_date, len);
+
+    if (error != TINYUTC_ISO8601_OK)
+    {
+        return error;
+    }
+    if (unix_ts == 0 || tinyutc_utc_to_unix(&utc_tm, unix_ts) != 0)
+    {
+        return TINYUTC_ISO8601_INVALID_DATE;
+    }
+    return TINYUTC_ISO8601_OK;
+}
+
+/**
+ * @brief Writes an IMF-fixdate, whose fields are in range, to a buffer large enough.
+ *
+ * Every field and separator has a fixed position.
+ */
+static size_t _format_http_date(const struct TinyUTCTime *utc_tm, uint8_t week_day, char *buf)
+{
+    uint32_t century = _TINYUTC_DIV_100(utc_tm->year);
+
+    memcpy(buf, _tinyutc_week_day_name(week_day), 3);
+    buf[3] = ',';
+    buf[4] = ' ';
+    _tinyutc_format_pair(buf + 5, utc_tm->day);
+    buf[7] = ' ';
+    memcpy(buf + 8, _tinyutc_month_name(utc_tm->month), 3);
+    buf[11] = ' ';
+    _tinyutc_format_pair(buf + 12, century);
+    _tinyutc_format_pair(buf + 14, utc_tm->year - century * 100);
+    buf[16] = ' ';
+    _tinyutc_format_pair(buf + 17, utc_tm->hour);
+    buf[19] = ':';
+    _tinyutc_format_pair(buf + 20, utc_tm->minute);
+    buf[22] = ':';
+    _tinyutc_format_pair(buf + 23, utc_tm->second);
+    memcpy(buf + 25, " GMT", 5); // With the terminator
+
+    return TINYUTC_HTTP_DATE_SIZE - 1;
+}
+
+size_t tinyutc_format_http_date(const struct TinyUTCTime *utc_tm, char *buf, size_t cap)
+{
+    if (utc_tm == 0 || buf == 0 || cap < TINYUTC_HTTP_DATE_SIZE || utc_tm->year < _TINYUTC_MIN_YEAR || utc_tm->year > 9999 ||
+        utc_tm->month < 1 || utc_tm->month > 12 || utc_tm->day < 1 || utc_tm->day > 31 || utc_tm->hour > 23 ||
+        utc_tm->minute > 59 || utc_tm->second > 60)
+    {
+        return 0;
+    }
+
+    return _format_http_date(utc_tm, (uint8_t)tinyutc_get_week_day(utc_tm, false), buf);
+}
+
+size_t tinyutc_format_unix_http_date(tinyutc_time_t unix_ts, char *buf, size_t cap)
+{
+    struct TinyUTCTime utc_tm;
+
+    if (buf == 0 || cap < TINYUTC_HTTP_DATE_SIZE || tinyutc_unix_to_utc(&utc_tm, unix_ts) != 0 || utc_tm.year > 9999)
+    {
+        return 0;
+    }
+
+    return _format_http_date(&utc_tm, tinyutc_unix_get_week_day(unix_ts, false), buf);
+}
@@ -0,0 +1,100 @@
+/**
+ * @file http_date.h
+ * @brief Header file for HTTP-date (RFC 7231) parsing and formatting functions.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * HTTP-dates are the dates of the `Date:`, `Last-Modified:` or `Expires:` headers,
+ * always in UTC ("GMT"). Senders must use the fixed length IMF-fixdate form,
+ * "Sun, 06 Nov 1994 08:49:37 GMT" (RFC 1123), and recipients must also accept the
+ * obsolete RFC 850 "Sunday, 06-Nov-94 08:49:37 GMT" and asctime "Sun Nov  6 08:49:37 1994"
+ * forms. Names are case-sensitive, and recognized by a perfect hash of their three
+ * letters. Errors are the codes of the ISO 8601 parser.
+ */
+
+#ifndef HTTP_DATE_H
+#define HTTP_DATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "tinyutc.h"
+#include "iso8601_parser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// "Sun, 06 Nov 1994 08:49:37 GMT" and its terminator
+#define TINYUTC_HTTP_DATE_SIZE 30
+
+    /**
+     * @brief Parses an HTTP-date, in any of its three forms, to a UTC time structure.
+     *
+     * The whole string must be the date. Two digits years of the RFC 850 form are
+     * between 1969 and 2068, as with the `%y` of `strptime`. The week day must be the
+     * one of the date. A leap second (60) is accepted.
+     *
+     * @param[out] utc_tm    Pointer to the TinyUTCTime structure, set on success
+     *                       (microseconds are 0).
+     * @param[in]  http_date The HTTP-date, not necessarily null-terminated.
+     * @param[in]  len       Number of characters of `http_date`.
+     * @return TINYUTC_ISO8601_OK on success, TINYUTC_ISO8601_INVALID_FORMAT if the string
+     *         is not an HTTP-date, TINYUTC_ISO8601_INVALID_DATE for a day out of its month,
+     *         a year out of range or a wrong week day, TINYUTC_ISO8601_INVALID_TIME for a
+     *         time out of range.
+     */
+    err_t tinyutc_parse_http_date(struct TinyUTCTime *utc_tm, const char *http_date, size_t len);
+
+    /**
+     * @brief Parses an HTTP-date, in any of its three forms, to a Unix timestamp.
+     *
+     * A leap second is the first second of the next minute.
+     *
+     * @param[in]  http_date The HTTP-date, not necessarily null-terminated.
+     * @param[in]  len       Number of characters of `http_date`.
+     * @param[out] unix_ts   The Unix timestamp, set on success.
+     * @return The same codes as `tinyutc_parse_http_date`, and TINYUTC_ISO8601_INVALID_DATE
+     *         for dates which do not fit in `tinyutc_time_t`.
+     */
+    err_t tinyutc_parse_http_date_to_unix(const char *http_date, size_t len, tinyutc_time_t *unix_ts);
+
+    /**
+     * @brief Formats a UTC time structure as an IMF-fixdate.
+     *
+     * The week day is computed from the date, and microseconds are ignored.
+     *
+     * @param[in]  utc_tm Pointer to the TinyUTCTime structure to format.
+     * @param[out] buf    Buffer receiving the date and a terminating '\0'.
+     * @param[in]  cap    Size of `buf`, at least `TINYUTC_HTTP_DATE_SIZE`.
+     * @return 29, the number of characters written without the terminator, or 0 if
+     *         `buf` is too small or a field is out of range (year after 9999).
+     */
+    size_t tinyutc_format_http_date(const struct TinyUTCTime *utc_tm, char *buf, size_t cap);
+
+    /**
+     * @brief Formats a Unix timestamp as an IMF-fixdate.
+     *
+     * @param[in]  unix_ts The Unix timestamp.
+     * @param[out] buf     Buffer receiving the date and a terminating '\0'.
+     * @param[in]  cap     Size of `buf`, at least `TINYUTC_HTTP_DATE_SIZE`.
+     * @return 29, the number of characters written without the terminator, or 0 if
+     *         `buf` is too small or the date is out of range (year after 9999).
+     */
+    size_t tinyutc_format_unix_http_date(tinyutc_time_t unix_ts, char *buf, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HTTP_DATE_H
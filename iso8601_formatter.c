@@ -0,0 +1,340 @@
+/**
+ * @file iso8601_formatter.c
+ * @brief ISO 8601 date and time formatter for TinyUTC library.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "tinyutc.h"
+#include "iso8601_formatter.h"
+#include "tinyutc_digits.h"
+
+/**
+ * @brief Number of characters of a datetime formatted with `flags`, without the terminator.
+ */
+static inline size_t _format_length(uint32_t flags, int32_t utc_offset)
+{
+    size_t len = (flags & TINYUTC_FORMAT_BASIC) ? 15 : 19; // "YYYYMMDDThhmmss" or "YYYY-MM-DDThh:mm:ss"
+
+    if (flags & TINYUTC_FORMAT_MICROSECONDS)
+    {
+        len += 7;
+    }
+    else if (flags & TINYUTC_FORMAT_MILLISECONDS)
+    {
+        len += 4;
+    }
+
+    if ((flags & TINYUTC_FORMAT_OFFSET) || ((flags & TINYUTC_FORMAT_ZULU) && utc_offset != 0))
+    {
+        len += (flags & TINYUTC_FORMAT_BASIC) ? 5 : 6;
+    }
+    else if (flags & TINYUTC_FORMAT_ZULU)
+    {
+        len += 1;
+    }
+
+    return len;
+}
+
+/**
+ * @brief Writes the fraction of second selected by the flags, if any.
+ *
+ * @return The end of the fraction.
+ */
+static inline char *_format_fraction(char *end, uint32_t microseconds, uint32_t flags)
+{
+    if (flags & (TINYUTC_FORMAT_MICROSECONDS | TINYUTC_FORMAT_MILLISECONDS))
+    {
+        end[0] = '.';
+        return _tinyutc_format_fraction(end + 1, microseconds, (flags & TINYUTC_FORMAT_MICROSECONDS) ? 6 : 3);
+    }
+
+    return end;
+}
+
+/**
+ * @brief Writes a datetime, whose fields and offset are in range, to a buffer large enough.
+ *
+ * The date and the time are written at fixed positions for each form, then the fraction
+ * and the suffix follow.
+ *
+ * @return The number of characters written, without the terminator.
+ */
+static size_t _format_datetime(const struct TinyUTCTime *local, int32_t utc_offset, char *buf, uint32_t flags)
+{
+    uint32_t century = _TINYUTC_DIV_100(local->year);
+    char *end;
+
+    _tinyutc_format_pair(buf, century);
+    _tinyutc_format_pair(buf + 2, local->year - century * 100);
+
+    if (flags & TINYUTC_FORMAT_BASIC)
+    {
+        _tinyutc_format_pair(buf + 4, local->month);
+        _tinyutc_format_pair(buf + 6, local->day);
+        buf[8] = (flags & TINYUTC_FORMAT_SPACE) ? ' ' : 'T';
+        _tinyutc_format_pair(buf + 9, local->hour);
+        _tinyutc_format_pair(buf + 11, local->minute);
+        _tinyutc_format_pair(buf + 13, local->second);
+        end = buf + 15;
+    }
+    else
+    {
+        buf[4] = '-';
+        _tinyutc_format_pair(buf + 5, local->month);
+        buf[7] = '-';
+        _tinyutc_format_pair(buf + 8, local->day);
+        buf[10] = (flags & TINYUTC_FORMAT_SPACE) ? ' ' : 'T';
+        _tinyutc_format_pair(buf + 11, local->hour);
+        buf[13] = ':';
+        _tinyutc_format_pair(buf + 14, local->minute);
+        buf[16] = ':';
+        _tinyutc_format_pair(buf + 17, local->second);
+        end = buf + 19;
+    }
+
+    end = _format_fraction(end, local->microseconds, flags);
+
+    if ((flags & TINYUTC_FORMAT_OFFSET) || ((flags & TINYUTC_FORMAT_ZULU) && utc_offset != 0))
+    {
+        uint32_t magnitude = utc_offset < 0 ? 0U - (uint32_t)utc_offset : (uint32_t)utc_offset;
+        uint32_t hours = _TINYUTC_DIV_SECS_PER_HOUR(magnitude);
+        uint32_t minutes = _TINYUTC_DIV_SECS_PER_MIN(magnitude - hours * _TINYUTC_SECS_PER_HOUR);
+
+        end[0] = utc_offset < 0 ? '-' : '+';
+        _tinyutc_format_pair(end + 1, hours);
+        if (flags & TINYUTC_FORMAT_BASIC)
+        {
+            _tinyutc_format_pair(end + 3, minutes);
+            end += 5;
+        }
+        else
+        {
+            end[3] = ':';
+            _tinyutc_format_pair(end + 4, minutes);
+            end += 6;
+        }
+    }
+    else if (flags & TINYUTC_FORMAT_ZULU)
+    {
+        *end++ = 'Z';
+    }
+
+    *end = '\0';
+    return (size_t)(end - buf);
+}
+
+/**
+ * @brief Checks the fields of a structure before formatting, leap seconds allowed.
+ */
+static inline bool _is_formattable(const struct TinyUTCTime *local)
+{
+    return local->year <= 9999 && local->month >= 1 && local->month <= 12 && local->day >= 1 && local->day <= 31 &&
+           local->hour <= 23 && local->minute <= 59 && local->second <= 60 && local->microseconds <= 999999;
+}
+
+/**
+ * @brief Checks an offset: a whole number of minutes, within +/-23:59.
+ */
+static inline bool _is_valid_offset(int32_t utc_offset)
+{
+    uint32_t magnitude = utc_offset < 0 ? 0U - (uint32_t)utc_offset : (uint32_t)utc_offset;
+    uint32_t secs; // Seconds past the hour
+
+    if (magnitude >= _TINYUTC_SECS_PER_DAY)
+    {
+        return false;
+    }
+
+    secs = magnitude - _TINYUTC_DIV_SECS_PER_HOUR(magnitude) * _TINYUTC_SECS_PER_HOUR;
+    return _TINYUTC_DIV_SECS_PER_MIN(secs) * _TINYUTC_SECS_PER_MIN == secs;
+}
+
+/**
+ * @brief Converts a timestamp to the local time of an offset.
+ *
+ * The offset is added to the timestamp when the sum stays in the range of `tinyutc_time_t`,
+ * so that the cursor can be used, and to the structure otherwise.
+ *
+ * @return true on success, false if the local time can not be represented.
+ */
+static bool _to_local_time(struct TinyUTCCursor *cursor, struct TinyUTCTime *local, tinyutc_time_t unix_ts, uint32_t micros,
+                           int32_t utc_offset)
+{
+    int64_t ts = (int64_t)unix_ts;
+
+    // Checked before adding, 64 bits timestamps could overflow
+    if (utc_offset >= 0 ? ts <= _TINYUTC_TIME_MAX - utc_offset : ts >= _TINYUTC_TIME_MIN - utc_offset)
+    {
+        if (tinyutc_cursor_unix_to_utc(cursor, local, (tinyutc_time_t)(ts + utc_offset)) != 0)
+        {
+            return false;
+        }
+    }
+    else if (tinyutc_unix_to_utc(local, unix_ts) != 0 || tinyutc_add_seconds(local, utc_offset) != 0)
+    {
+        return false;
+    }
+
+    local->microseconds = micros;
+    return true;
+}
+
+size_t tinyutc_format_iso8601(const struct TinyUTCTime *utc_tm, char *buf, size_t cap, uint32_t flags)
+{
+    if (utc_tm == 0 || buf == 0 || !_is_formattable(utc_tm) || cap <= _format_length(flags, 0))
+    {
+        return 0;
+    }
+
+    return _format_datetime(utc_tm, 0, buf, flags);
+}
+
+size_t tinyutc_format_unix_iso8601(tinyutc_time_t unix_ts, uint32_t micros, int32_t utc_offset, char *buf, size_t cap,
+                                   uint32_t flags)
+{
+    struct TinyUTCCursor cursor;
+    struct TinyUTCTime local;
+
+    if (buf == 0 || !_is_valid_offset(utc_offset) || cap <= _format_length(flags, utc_offset))
+    {
+        return 0;
+    }
+
+    tinyutc_cursor_init(&cursor);
+    if (!_to_local_time(&cursor, &local, unix_ts, micros, utc_offset) || !_is_formattable(&local))
+    {
+        return 0;
+    }
+
+    return _format_datetime(&local, utc_offset, buf, flags);
+}
+
+size_t tinyutc_format_unix_iso8601_batch(char *buf, size_t stride, const tinyutc_time_t *unix_ts, const uint32_t *micros,
+                                         size_t count, int32_t utc_offset, uint32_t flags)
+{
+    struct TinyUTCCursor cursor;
+    struct TinyUTCTime local;
+    size_t formatted = 0;
+
+    if (buf == 0 || unix_ts == 0 || !_is_valid_offset(utc_offset) || stride <= _format_length(flags, utc_offset))
+    {
+        return 0;
+    }
+
+    tinyutc_cursor_init(&cursor);
+    for (size_t i = 0; i < count; i++, buf += stride)
+    {
+        if (!_to_local_time(&cursor, &local, unix_ts[i], micros != 0 ? micros[i] : 0, utc_offset) || !_is_formattable(&local))
+        {
+            buf[0] = '\0';
+            continue;
+        }
+
+        _format_datetime(&local, utc_offset, buf, flags);
+        formatted++;
+    }
+
+    return formatted;
+}
+
+void tinyutc_format_cache_init(struct TinyUTCFormatCache *cache, int32_t utc_offset, uint32_t flags)
+{
+    tinyutc_cursor_init(&cache->cursor);
+    cache->second = 0;
+    cache->utc_offset = utc_offset;
+    cache->flags = flags;
+    cache->len = _is_valid_offset(utc_offset) ? (uint8_t)_format_length(flags, utc_offset) : 0;
+    cache->is_valid = false;
+    cache->text[0] = '\0';
+    cache->hits = 0;
+    cache->misses = 0;
+}
+
+/**
+ * @brief Moves the cached datetime to another second.
+ *
+ * Within the same day, only the time pairs which changed are written again, at their
+ * fixed positions, and the date, separators and suffix are kept.
+ *
+ * @return false if the local time can not be formatted (the cache is then left unchanged).
+ */
+static bool _format_cache_move(struct TinyUTCFormatCache *cache, tinyutc_time_t unix_ts)
+{
+    struct TinyUTCTime local;
+    bool is_basic = cache->flags & TINYUTC_FORMAT_BASIC;
+
+    if (!_to_local_time(&cache->cursor, &local, unix_ts, 0, cache->utc_offset) || !_is_formattable(&local))
+    {
+        return false;
+    }
+
+    if (!cache->is_valid || local.day != cache->local.day || local.month != cache->local.month || local.year != cache->local.year)
+    {
+        _format_datetime(&local, cache->utc_offset, cache->text, cache->flags);
+    }
+    else
+    {
+        if (local.hour != cache->local.hour)
+        {
+            _tinyutc_format_pair(cache->text + (is_basic ? 9 : 11), local.hour);
+        }
+        if (local.minute != cache->local.minute)
+        {
+            _tinyutc_format_pair(cache->text + (is_basic ? 11 : 14), local.minute);
+        }
+        _tinyutc_format_pair(cache->text + (is_basic ? 13 : 17), local.second);
+    }
+
+    cache->local = local;
+    cache->second = unix_ts;
+    cache->is_valid = true;
+    return true;
+}
+
+size_t tinyutc_format_cache_unix_iso8601(struct TinyUTCFormatCache *cache, tinyutc_time_t unix_ts, uint32_t micros, char *buf,
+                                         size_t cap)
+{
+    if (buf == 0 || cache->len == 0 || cap <= cache->len || micros > 999999)
+    {
+        return 0;
+    }
+
+    if (cache->is_valid && unix_ts == cache->second)
+    {
+        cache->hits++;
+    }
+    else
+    {
+        if (!_format_cache_move(cache, unix_ts))
+        {
+            return 0;
+        }
+        cache->misses++;
+    }
+
+    // Copied with its terminator, 16 to 33 bytes, as two blocks of 16 which overlap, or leave the
+    // byte 16 between them, then the fraction is written over the cached one
+    memcpy(buf, cache->text, 16);
+    if (cache->len == TINYUTC_FORMAT_MAX_SIZE - 1)
+    {
+        buf[16] = cache->text[16];
+    }
+    memcpy(buf + cache->len + 1 - 16, cache->text + cache->len + 1 - 16, 16);
+    _format_fraction(buf + ((cache->flags & TINYUTC_FORMAT_BASIC) ? 15 : 19), micros, cache->flags);
+
+    return cache->len;
+}
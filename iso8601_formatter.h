@@ -0,0 +1,157 @@
+/**
+ * @file iso8601_formatter.h
+ * @brief Header file for ISO 8601 date and time formatting functions.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Datetimes are written two digits at a time from a lookup table, at positions
+ * known from the flags: no libc function is called, and nothing is allocated.
+ * Only years 0000 to 9999 can be written, as ISO 8601 needs an agreement between
+ * both sides for more digits.
+ */
+
+#ifndef ISO8601_FORMATTER_H
+#define ISO8601_FORMATTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "tinyutc.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TINYUTC_FORMAT_BASIC 0x01        // "YYYYMMDDThhmmss" instead of "YYYY-MM-DDThh:mm:ss"
+#define TINYUTC_FORMAT_MILLISECONDS 0x02 // ".fff" fraction of second
+#define TINYUTC_FORMAT_MICROSECONDS 0x04 // ".ffffff" fraction of second, over milliseconds
+#define TINYUTC_FORMAT_ZULU 0x08         // "Z" suffix for UTC
+#define TINYUTC_FORMAT_OFFSET 0x10       // "+hh:mm" suffix ("+hhmm" in basic format), over "Z"
+#define TINYUTC_FORMAT_SPACE 0x20        // ' ' between the date and the time, as RFC 3339 allows
+
+// "YYYY-MM-DDThh:mm:ss.ffffff+hh:mm" and its terminator, enough for any flags
+#define TINYUTC_FORMAT_MAX_SIZE 33
+
+    /**
+     * @brief Formats a UTC time structure as an ISO 8601 datetime.
+     *
+     * The structure is in UTC: `TINYUTC_FORMAT_OFFSET` writes "+00:00", and
+     * `TINYUTC_FORMAT_ZULU` writes "Z". Without either of them, nothing tells
+     * the datetime is in UTC. Leap seconds are written as they are.
+     *
+     * @param[in]  utc_tm Pointer to the TinyUTCTime structure to format.
+     * @param[out] buf    Buffer receiving the datetime and a terminating '\0'.
+     * @param[in]  cap    Size of `buf`, `TINYUTC_FORMAT_MAX_SIZE` is always enough.
+     * @param[in]  flags  Combination of `TINYUTC_FORMAT_*` flags, or 0.
+     * @return The number of characters written, without the terminator, or 0 if
+     *         `buf` is too small, or a field is out of range (year after 9999).
+     */
+    size_t tinyutc_format_iso8601(const struct TinyUTCTime *utc_tm, char *buf, size_t cap, uint32_t flags);
+
+    /**
+     * @brief Formats a Unix timestamp as an ISO 8601 datetime, in the local time of an offset.
+     *
+     * With `TINYUTC_FORMAT_OFFSET`, the offset is written after the time. With
+     * `TINYUTC_FORMAT_ZULU`, a zero offset is written "Z", and others as with
+     * `TINYUTC_FORMAT_OFFSET`. Without either of them, the local time is written
+     * alone.
+     *
+     * @param[in]  unix_ts    The Unix timestamp.
+     * @param[in]  micros     Microseconds of the timestamp, in range 0-999999.
+     * @param[in]  utc_offset Offset of the local time, in seconds, a whole number
+     *                        of minutes within +/-23:59 (same sign as "+hh:mm").
+     * @param[out] buf        Buffer receiving the datetime and a terminating '\0'.
+     * @param[in]  cap        Size of `buf`, `TINYUTC_FORMAT_MAX_SIZE` is always enough.
+     * @param[in]  flags      Combination of `TINYUTC_FORMAT_*` flags, or 0.
+     * @return The number of characters written, without the terminator, or 0 if
+     *         `buf` is too small, or the offset or the local time is out of range.
+     */
+    size_t tinyutc_format_unix_iso8601(tinyutc_time_t unix_ts, uint32_t micros, int32_t utc_offset, char *buf, size_t cap,
+                                       uint32_t flags);
+
+    /**
+     * @brief Formats an array of Unix timestamps as ISO 8601 datetimes, in the local time of an offset.
+     *
+     * Each datetime is formatted as by `tinyutc_format_unix_iso8601`, in its own record of
+     * `stride` bytes. Timestamps are converted with a `TinyUTCCursor`, so sorted timestamps
+     * (e.g. log records) only split their time of the day. A timestamp that cannot be
+     * formatted leaves an empty string in its record.
+     *
+     * @param[out] buf        Buffer of at least `count * stride` bytes.
+     * @param[in]  stride     Size of each record, `TINYUTC_FORMAT_MAX_SIZE` is always enough.
+     * @param[in]  unix_ts    Array of `count` Unix timestamps.
+     * @param[in]  micros     Array of `count` microseconds, or NULL.
+     * @param[in]  count      Number of timestamps to format.
+     * @param[in]  utc_offset Offset of the local time, as in `tinyutc_format_unix_iso8601`.
+     * @param[in]  flags      Combination of `TINYUTC_FORMAT_*` flags, or 0.
+     * @return The number of timestamps formatted.
+     */
+    size_t tinyutc_format_unix_iso8601_batch(char *buf, size_t stride, const tinyutc_time_t *unix_ts, const uint32_t *micros,
+                                             size_t count, int32_t utc_offset, uint32_t flags);
+
+    /**
+     * @struct TinyUTCFormatCache
+     * @brief  Last formatted second, for timestamps formatted many times per second (e.g. log lines).
+     *
+     * A timestamp in the cached second only copies the cached datetime and writes its
+     * fraction. A timestamp in another second of the same day only rewrites the time
+     * fields which changed, and other days are converted by the cursor of the cache.
+     *
+     * Initialize with `tinyutc_format_cache_init`, the offset and flags are the same for
+     * every datetime. Fields are not meant to be written by the user, but the counters
+     * can be read (and reset) freely.
+     */
+    struct TinyUTCFormatCache
+    {
+        struct TinyUTCCursor cursor;        // Date of the cached second
+        struct TinyUTCTime local;           // Fields of the cached second, in local time
+        tinyutc_time_t second;              // Timestamp of the cached second
+        int32_t utc_offset;                 // Offset of the local time, in seconds
+        uint32_t flags;                     // TINYUTC_FORMAT_* flags
+        uint8_t len;                        // Length of the datetimes, 0 if the offset is invalid
+        bool is_valid;                      // False until a first datetime is formatted
+        char text[TINYUTC_FORMAT_MAX_SIZE]; // Datetime of the cached second, fraction included
+        uint32_t hits;                      // Datetimes in the cached second
+        uint32_t misses;                    // Datetimes in another second
+    };
+
+    /**
+     * @brief Initializes a format cache, with nothing cached and counters set to 0.
+     *
+     * @param[out] cache      The cache to initialize.
+     * @param[in]  utc_offset Offset of the local time, as in `tinyutc_format_unix_iso8601`.
+     * @param[in]  flags      Combination of `TINYUTC_FORMAT_*` flags, or 0.
+     */
+    void tinyutc_format_cache_init(struct TinyUTCFormatCache *cache, int32_t utc_offset, uint32_t flags);
+
+    /**
+     * @brief Formats a Unix timestamp as an ISO 8601 datetime, reusing the previous second.
+     *
+     * Results are the same as `tinyutc_format_unix_iso8601`, with the offset and flags of the cache.
+     *
+     * @param[in,out] cache  The cache, updated to the second of `unix_ts`.
+     * @param[in]     unix_ts The Unix timestamp.
+     * @param[in]     micros Microseconds of the timestamp, in range 0-999999.
+     * @param[out]    buf    Buffer receiving the datetime and a terminating '\0'.
+     * @param[in]     cap    Size of `buf`, `TINYUTC_FORMAT_MAX_SIZE` is always enough.
+     * @return The number of characters written, without the terminator, or 0 if
+     *         `buf` is too small, or the offset or the local time is out of range.
+     */
+    size_t tinyutc_format_cache_unix_iso8601(struct TinyUTCFormatCache *cache, tinyutc_time_t unix_ts, uint32_t micros, char *buf,
+                                             size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ISO8601_FORMATTER_H
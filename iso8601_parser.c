@@ -13,12 +13,14 @@
  * http://www.wtfpl.net/ for more details.
  */
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include "tinyutc.h"
 #include "iso8601_parser.h"
 
 // As this is the only string function used in this file, I will implement it here.
+// It is only called once per string, by the functions taking null-terminated strings.
 static size_t __tinyutc_strlen(const char *str)
 {
     // BSD implementation of strlen
@@ -30,37 +32,71 @@ static size_t __tinyutc_strlen(const char *str)
 }
 
 /**
- * @brief Converts a string representation of an unsigned integer to a uint32_t.
+ * @brief Bounded cursor over the parsed string.
  *
- * This function takes a string and its length as input, and converts the string
- * to an unsigned 32-bit integer. The string is expected to contain only numeric
- * characters, and its length should not exceed the maximum number of digits
- * representable by a uint32_t.
+ * Every byte is read at most once, and never at or past `len`: the string does
+ * not need to be null-terminated.
+ */
+struct _TinyUTCISOScanner
+{
+    const char *str;
+    size_t len;
+    size_t pos;
+};
+
+/**
+ * @brief Returns the current character, without consuming it.
  *
- * @param str Pointer to the null-terminated string containing the numeric characters.
- * @param len The maximum number of characters to parse.
- * @return The converted unsigned 32-bit integer.
+ * @param scanner Pointer to the scanner.
+ * @return The character, or -1 at the end of the string.
  */
-static err_t _str_to_uint(const char *str, int len)
+static inline int _scan_peek(const struct _TinyUTCISOScanner *scanner)
 {
-    uint32_t result = 0;
+    return scanner->pos < scanner->len ? (unsigned char)scanner->str[scanner->pos] : -1;
+}
+
+static inline bool _scan_is_digit(int c)
+{
+    return c >= '0' && c <= '9';
+}
 
-    if (__tinyutc_strlen(str) < len)
+/**
+ * @brief Consumes the current character if it is the expected one.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param expected Expected character.
+ * @return true if the character was consumed.
+ */
+static inline bool _scan_accept(struct _TinyUTCISOScanner *scanner, char expected)
+{
+    if (_scan_peek(scanner) != (unsigned char)expected)
     {
-        return -1; // Invalid length
+        return false;
     }
+    scanner->pos++;
+    return true;
+}
+
+/**
+ * @brief Consumes exactly `count` digits, and converts them to an unsigned integer.
+ *
+ * @param scanner Pointer to the scanner.
+ * @param count The number of digits to parse.
+ * @return The converted integer, or -1 if the string ends or a character is not a digit.
+ */
+static int32_t _scan_uint(struct _TinyUTCISOScanner *scanner, int count)
+{
+    int32_t result = 0;
 
-    for (int i = 0; i < len; i++)
+    for (int i = 0; i < count; i++)
     {
-        if (str[i] == 0)
-        {
-            return -1; // Invalid length
-        }
-        if (str[i] < '0' || str[i] > '9')
+        int c = _scan_peek(scanner);
+        if (!_scan_is_digit(c))
         {
-            return -1; // Invalid character
+            return -1; // Invalid character or length
         }
-        result = result * 10 + (str[i] - '0');
+        result = result * 10 + (c - '0');
+        scanner->pos++;
     }
     return result;
 }
@@ -79,7 +115,7 @@ static err_t __tidy_utc_struct(struct TinyUTCTime *utc_tm, int utc_offset)
     bool has_extra_leap_second = utc_tm->second == 60; // Set the leap second flag
 
     tinyutc_time_t unix_ts;
-    uint8_t error = tinyutc_utc_to_unix(utc_tm, &unix_ts);
+    err_t error = tinyutc_utc_to_unix(utc_tm, &unix_ts);
     if (error < 0)
     {
         return -1; // Invalid date
@@ -106,8 +142,15 @@ static err_t __tidy_utc_struct(struct TinyUTCTime *utc_tm, int utc_offset)
     return 0; // Success
 }
 
+/**
+ * @brief Sets the date of an ISO 8601 week date, counting days from the first monday of the year.
+ *
+ * @return 0 on success, -1 on an invalid week, day of the week, or a date out of range.
+ */
 static err_t _parse_date_from_weekno(struct TinyUTCTime *utc_tm, uint16_t year, uint8_t weekno, uint8_t dayno)
 {
+    uint32_t days;
+
     if (weekno < 1 || weekno > 53)
     {
         return -1; // Invalid week number
@@ -118,547 +161,519 @@ static err_t _parse_date_from_weekno(struct TinyUTCTime *utc_tm, uint16_t year,
         return -1; // Invalid day of the week
     }
 
-    // By ISO 8601, week 1 is the first week with a Thursday in it.
-    // This means that the 4th of January is always in week 1.
-    // I did not check that rigorously, but intuitively, it works,
-    // plus everyone on the internet says so.
-
-    struct TinyUTCTime january_4th = {
-        .year = year,
-        .month = 1,
-        .day = 4,
-        .hour = 0,
-        .minute = 0,
-        .second = 0,
-        .microseconds = 0};
+    if (year < _TINYUTC_MIN_YEAR)
+    {
+        return -1; // Invalid date
+    }
 
-    uint8_t week_day = tinyutc_get_week_day(&january_4th, true); // Get the week day of January 4th
+    // By ISO 8601, week 1 is the first week with a Thursday in it,
+    // so the 4th of January is always in week 1.
+    days = _tinyutc_iso_week_start(year) + (weekno - 1) * 7 + (dayno - 1);
 
-    tinyutc_time_t january_4th_unix;
-    uint8_t error = tinyutc_utc_to_unix(&january_4th, &january_4th_unix);
-    if (error < 0)
+    // The first week of 1970 starts in 1969, and the last week of 65535 ends in 65536
+    if ((int32_t)days < _TINYUTC_MIN_DAYS || (int32_t)days > (int32_t)_TINYUTC_MAX_DAYS)
     {
         return -1; // Invalid date
     }
 
-    tinyutc_time_t week1 = january_4th_unix - (week_day - 1) * _TINYUTC_SECS_PER_DAY; // Get the Unix timestamp of the first day of week 1
+    _tinyutc_civil_from_days(days, &utc_tm->year, &utc_tm->month, &utc_tm->day);
 
-    uint16_t days_offset = (weekno - 1) * 7 + (dayno - 1); // Calculate the offset in days from week 1
+    return 0;
+}
 
-    struct TinyUTCTime new_date = {0};
+/**
+ * @brief Sets the date of an ISO 8601 ordinal date.
+ *
+ * @return 0 on success, -1 on an invalid ordinal day, or a year out of range.
+ */
+static err_t _parse_date_from_ordinal(struct TinyUTCTime *utc_tm, uint16_t year, uint16_t ordinal_day)
+{
+    if (ordinal_day < 1 ||
+        (ordinal_day > 366 && _TINYUTC_IS_LEAP_YEAR(year)) ||
+        (ordinal_day > 365 && !_TINYUTC_IS_LEAP_YEAR(year)))
+    {
+        return -1; // Invalid ordinal day
+    }
 
-    tinyutc_unix_to_utc(&new_date, week1 + days_offset * _TINYUTC_SECS_PER_DAY); // Convert the Unix timestamp back to a TinyUTCTime structure
+    if (year < _TINYUTC_MIN_YEAR)
+    {
+        return -1; // Invalid date
+    }
 
-    // Set the UTC time structure with the new date
-    utc_tm->year = new_date.year;
-    utc_tm->month = new_date.month;
-    utc_tm->day = new_date.day;
+    utc_tm->year = year;
+    _tinyutc_month_day_from_ordinal(year, ordinal_day, &utc_tm->month, &utc_tm->day);
 
     return 0;
 }
 
-static int _parse_offset(const char *iso8601_offset, int *utc_offset)
+/**
+ * @brief Parses a date, in the calendar ("YYYY-MM-DD", "YYYYMMDD"), week ("YYYY-Www-D", "YYYYWwwD")
+ *        or ordinal ("YYYY-DDD", "YYYYDDD") format.
+ *
+ * The format is told apart from the characters already read: a 'W' after the year is a
+ * week date, and a third digit after the month digits is an ordinal day.
+ *
+ * @param utc_tm Pointer to a TinyUTCTime structure, whose date is set.
+ * @param scanner Pointer to the scanner, moved after the date.
+ * @return 0 on success, TINYUTC_ISO8601_INVALID_DATE otherwise.
+ */
+static err_t _scan_date(struct TinyUTCTime *utc_tm, struct _TinyUTCISOScanner *scanner)
 {
-    int cursor, pattern_len, mult, hour_offset, minute_offset;
-
-    pattern_len = __tinyutc_strlen(iso8601_offset);
+    int32_t year, first, digit;
+    bool use_separator;
 
-    if (*iso8601_offset == 'z' || *iso8601_offset == 'Z')
+    // Parse year
+    year = _scan_uint(scanner, 4);
+    if (year < 0)
     {
-        return 1; // Cursor position after parsing the offset
+        return TINYUTC_ISO8601_INVALID_DATE; // Invalid year
     }
+    utc_tm->year = (uint16_t)year;
 
-    if (pattern_len > 6 || pattern_len < 3 || pattern_len == 4)
+    use_separator = _scan_accept(scanner, '-');
+
+    if (_scan_accept(scanner, 'W'))
     {
-        LOG_DBG("File %s, line %d : Invalid offset format (len %d)\n", __FILE__, __LINE__, pattern_len);
-        return -1; // Invalid offset format
+        int32_t weekno = _scan_uint(scanner, 2);
+        int32_t dayno = 1;
+
+        // The day of the week can only be omitted at the end of the string
+        if (scanner->pos < scanner->len)
+        {
+            if (use_separator && !_scan_accept(scanner, '-'))
+            {
+                return TINYUTC_ISO8601_INVALID_DATE; // Inconsistent separator
+            }
+            dayno = _scan_uint(scanner, 1);
+        }
+
+        if (weekno < 0 || dayno < 0 || _parse_date_from_weekno(utc_tm, utc_tm->year, weekno, dayno) < 0)
+        {
+            return TINYUTC_ISO8601_INVALID_DATE; // Invalid week number or day of the week
+        }
+        return 0;
     }
 
-    if (*iso8601_offset == '+')
+    // Two digits, which are either the month or the beginning of the ordinal day
+    first = _scan_uint(scanner, 2);
+    if (first < 0)
     {
-        mult = 1;
+        return TINYUTC_ISO8601_INVALID_DATE;
     }
-    else if (*iso8601_offset == '-')
+
+    if (use_separator && _scan_accept(scanner, '-'))
     {
-        mult = -1;
+        // YYYY-MM-DD
+        digit = _scan_uint(scanner, 2);
     }
     else
     {
-        LOG_DBG("File %s, line %d : Invalid offset format offset char begin: %c\n", __FILE__, __LINE__, *iso8601_offset);
-        return -1; // Invalid offset format
-    }
-
-    cursor = 1;
-
-    // Parse hour
-    hour_offset = _str_to_uint(iso8601_offset + cursor, 2);
-    if (hour_offset < 0 || hour_offset > 23)
-    {
-        return -1; // Invalid hour
-    }
+        // YYYYMMDD, YYYY-DDD or YYYYDDD, all followed by a third digit
+        digit = _scan_uint(scanner, 1);
+        if (digit < 0)
+        {
+            return TINYUTC_ISO8601_INVALID_DATE; // Reduced precision or inconsistent separator
+        }
 
-    cursor += 2;
+        if (use_separator || !_scan_is_digit(_scan_peek(scanner)))
+        {
+            if (_parse_date_from_ordinal(utc_tm, utc_tm->year, first * 10 + digit) < 0)
+            {
+                return TINYUTC_ISO8601_INVALID_DATE; // Invalid ordinal day
+            }
+            return 0;
+        }
 
-    if (iso8601_offset[cursor] == ':')
-    {
-        cursor++; // Skip separator
+        digit = digit * 10 + _scan_uint(scanner, 1);
     }
 
-    minute_offset = _str_to_uint(iso8601_offset + cursor, 2);
-
-    if (minute_offset < 0 || minute_offset > 59)
+    if (first < 1 || first > 12 || digit < 1 || digit > 31)
     {
-        return -1; // Invalid minute
+        return TINYUTC_ISO8601_INVALID_DATE; // Invalid month or day
     }
+    utc_tm->month = (uint8_t)first;
+    utc_tm->day = (uint8_t)digit;
 
-    *utc_offset = mult * (hour_offset * 3600 + minute_offset * 60); // Convert to total minutes
-
-    return cursor + 2; // Return the cursor position after parsing the offset
+    return 0;
 }
 
-static int _parse_microseconds(struct TinyUTCTime *utc_tm, const char *iso8601_time_tail)
+/**
+ * @brief Parses a UTC offset, "Z", "+hh", "+hhmm" or "+hh:mm", if any.
+ *
+ * @param scanner Pointer to the scanner, moved after the offset.
+ * @param utc_offset Pointer to the offset, in seconds, set when present.
+ * @return 0 on success, TINYUTC_ISO8601_INVALID_OFFSET otherwise.
+ */
+static err_t _scan_offset(struct _TinyUTCISOScanner *scanner, int *utc_offset)
 {
-    int cursor = 0;
-    int result = 0;
-    // Check for fractionnal seconds
-    uint8_t fraction_len = 0;
-    uint8_t rest_len = __tinyutc_strlen(iso8601_time_tail);
+    int32_t hour_offset, minute_offset = 0;
+    int mult;
 
-    // Find offset, if any
-    while (fraction_len < rest_len &&
-           iso8601_time_tail[fraction_len] != '+' &&
-           iso8601_time_tail[fraction_len] != '-' &&
-           iso8601_time_tail[fraction_len] != 'Z' &&
-           iso8601_time_tail[fraction_len] != 'z' &&
-           fraction_len <= 7)
+    if (_scan_accept(scanner, 'Z') || _scan_accept(scanner, 'z'))
     {
-        fraction_len++;
+        return 0;
     }
-    if (fraction_len == 7)
+
+    if (_scan_accept(scanner, '+'))
     {
-        return -1; // Invalid fraction length
+        mult = 1;
     }
-
-    result = _str_to_uint(iso8601_time_tail + cursor, fraction_len);
-
-    if (result < 0)
+    else if (_scan_accept(scanner, '-'))
     {
-        return -1; // Invalid fraction
+        mult = -1;
     }
-
-    for (int i = fraction_len; i < 6; i++)
+    else
     {
-        result *= 10; // Shift to the left
+        return 0; // No offset
     }
 
-    utc_tm->microseconds = result; // Set the microseconds
-    cursor += fraction_len;
-
-    return cursor;
-}
-
-static int _parse_time_component(const char *iso8601_time_part, uint8_t *component, bool *reached_end)
-{
-    int end = 0, result = 0;
-    int pattern_len = __tinyutc_strlen(iso8601_time_part);
-    if (pattern_len < 1)
+    hour_offset = _scan_uint(scanner, 2);
+    if (hour_offset < 0 || hour_offset > 23)
     {
-        LOG_DBG("File %s, line %d : While parsing time component, component too short (%d)\n", __FILE__, __LINE__, pattern_len);
-        return -1;
+        LOG_DBG("File %s, line %d : Invalid offset hours\n", __FILE__, __LINE__);
+        return TINYUTC_ISO8601_INVALID_OFFSET; // Invalid hour
     }
 
-    // Find the end of the component
-    for (end = 1; (end < pattern_len && end < 2); end++)
+    if (_scan_accept(scanner, ':') || _scan_is_digit(_scan_peek(scanner)))
     {
-        if (iso8601_time_part[end + 1] == '+' ||
-            iso8601_time_part[end + 1] == '-' ||
-            iso8601_time_part[end + 1] == 'Z' ||
-            iso8601_time_part[end + 1] == 'z' ||
-            iso8601_time_part[end + 1] == 0)
+        minute_offset = _scan_uint(scanner, 2);
+        if (minute_offset < 0 || minute_offset > 59)
         {
-            *reached_end = true; // Found the end of the component
-            end++;
-            break; // Found the end of the component
+            LOG_DBG("File %s, line %d : Invalid offset minutes\n", __FILE__, __LINE__);
+            return TINYUTC_ISO8601_INVALID_OFFSET; // Invalid minute
         }
     }
 
-    // Parse digits
-    result = _str_to_uint(iso8601_time_part, end);
-    if (result < 0)
-    {
-        LOG_DBG("File %s, line %d : While parsing time component, unable to parse int. %s [0:%d]\n", __FILE__, __LINE__, iso8601_time_part, end);
-        return -1; // Invalid hour
-    }
-
-    *component = (uint8_t)result; // Set the component
+    *utc_offset = mult * (hour_offset * 3600 + minute_offset * 60); // Convert to seconds
 
-    return end;
+    return 0;
 }
 
-static int _parse_time(const char *iso8601_time, struct TinyUTCTime *utc_tm, int *utc_offset)
+/**
+ * @brief Parses a time, "hh", "hh:mm", "hh:mm:ss" or without separators, with an optional
+ *        fraction of second and UTC offset.
+ *
+ * The last component may have a single digit when it ends the string.
+ *
+ * @param utc_tm Pointer to a TinyUTCTime structure, whose time is set.
+ * @param scanner Pointer to the scanner, moved after the time.
+ * @param utc_offset Pointer to the offset, in seconds, set when present.
+ * @return 0 on success, or a negative TinyUTCISO8601ErrorCode.
+ */
+static err_t _scan_time(struct TinyUTCTime *utc_tm, struct _TinyUTCISOScanner *scanner, int *utc_offset)
 {
-    int cursor = 0, result = 0, pattern_len = 0;
-    bool use_separator = false;
-
     uint8_t hms[3] = {0};
+    bool use_separator = false;
+    int32_t component;
+    int c, i;
 
-    pattern_len = __tinyutc_strlen(iso8601_time);
-
-    if (pattern_len < 2)
-    {
-        LOG_DBG("File %s, line %d : While parsing time, pattern length is too short: %d\n", __FILE__, __LINE__, pattern_len);
-        return TINYUTC_ISO8601_INVALID_TIME; // Invalid time format
-    }
-
-    uint8_t component = 0;
-    bool reached_end = false;
-    int i;
     for (i = 0; i < 3; i++)
     {
-        result = _parse_time_component(iso8601_time + cursor, &component, &reached_end);
-        if (result < 0)
+        component = _scan_uint(scanner, (i > 0 && scanner->len - scanner->pos == 1) ? 1 : 2);
+        if (component < 0)
         {
             LOG_DBG("File %s, line %d : While parsing time, unable to parse component %d\n", __FILE__, __LINE__, i);
             return TINYUTC_ISO8601_INVALID_TIME; // Invalid time component
         }
-        cursor += result;   // Move the cursor
-        hms[i] = component; // Store the component
+        hms[i] = (uint8_t)component;
 
-        if (reached_end)
+        c = _scan_peek(scanner);
+        if (i == 2 || (c != ':' && !_scan_is_digit(c)))
         {
             break; // No more components to parse
         }
 
-        // Check separator inconsistency
-        if (i == 0)
+        // The first separator dictates separator usage
+        if (c == ':')
         {
-            // First encounter dictates separator usage
-            if (iso8601_time[cursor] == ':')
+            if (i > 0 && !use_separator)
             {
-                cursor++; // Skip separator
-                use_separator = true;
+                LOG_DBG("File %s, line %d : Inconsistent use of separator after time component %d\n", __FILE__, __LINE__, i);
+                return TINYUTC_ISO8601_INCONSISTENT_TIME_SEPARATOR;
             }
+            use_separator = true;
+            scanner->pos++; // Skip separator
         }
-        else if (i < 2)
+        else if (use_separator)
         {
-            if (iso8601_time[cursor] != ':' && use_separator)
-            {
-                LOG_DBG("File %s, line %d : Inconsistent use of separator after time component %d\n", __FILE__, __LINE__, i);
-                return TINYUTC_ISO8601_INCONSISTENT_TIME_SEPARATOR; // Invalid time format
-            }
-            else if (iso8601_time[cursor] == ':' && !use_separator)
-            {
-                LOG_DBG("File %s, line %d : Inconsistent use of separator after time component %d\n", __FILE__, __LINE__, i);
-                return TINYUTC_ISO8601_INCONSISTENT_TIME_SEPARATOR; // Invalid time format
-            }
-            else
-            {
-                if (use_separator)
-                {
-                    cursor++; // Skip separator
-                }
-            }
+            LOG_DBG("File %s, line %d : Inconsistent use of separator after time component %d\n", __FILE__, __LINE__, i);
+            return TINYUTC_ISO8601_INCONSISTENT_TIME_SEPARATOR;
         }
     }
 
-    // Check limits
-    if (hms[2] < 0 || hms[2] > 60)
-    {
-        // We allow leap seconds
-        LOG_DBG("File %s, line %d : Seconds %d not in range 0-60\n", __FILE__, __LINE__, hms[2]);
-        return TINYUTC_ISO8601_INVALID_TIME; // Invalid minute
-    }
-
-    if (hms[1] < 0 || hms[1] > 59)
+    // Check limits, we allow leap seconds
+    if (hms[0] > 24 || hms[1] > 59 || hms[2] > 60)
     {
-        LOG_DBG("File %s, line %d : Minutes %d not in range 0-59\n", __FILE__, __LINE__, hms[1]);
-        return TINYUTC_ISO8601_INVALID_TIME; // Invalid minute
+        LOG_DBG("File %s, line %d : Time %d:%d:%d out of range\n", __FILE__, __LINE__, hms[0], hms[1], hms[2]);
+        return TINYUTC_ISO8601_INVALID_TIME;
     }
 
-    if (hms[0] < 0 || hms[0] > 24)
+    // 24:00:00 is a valid time, but it means midnight on the next day
+    if (hms[0] == 24 && (hms[1] != 0 || hms[2] != 0))
     {
-        LOG_DBG("File %s, line %d : Hours %d not in range 0-24\n", __FILE__, __LINE__, hms[0]);
-        return TINYUTC_ISO8601_INVALID_TIME; // Invalid hour
-    }
-
-    // 24:00:00 is a valid time, but it means midthight on the next day
-    if (hms[0] == 24)
-    {
-        if (hms[1] != 0 || hms[2] != 0)
-        {
-            LOG_DBG("File %s, line %d : Hours set to 24, but minutes and seonds not set to 0.\n", __FILE__, __LINE__);
-            return TINYUTC_ISO8601_INVALID_TIME; // Invalid hour
-        }
-        // Let as-is, it will be tidied up later
+        LOG_DBG("File %s, line %d : Hours set to 24, but minutes and seconds not set to 0.\n", __FILE__, __LINE__);
+        return TINYUTC_ISO8601_INVALID_TIME;
     }
 
     utc_tm->hour = hms[0];   // Set the hour
     utc_tm->minute = hms[1]; // Set the minute
     utc_tm->second = hms[2]; // Set the second
-
     utc_tm->microseconds = 0;
 
-    if (i == 3 && !reached_end)
+    // Fractional seconds, only after the seconds
+    if (i == 2 && (_scan_accept(scanner, '.') || _scan_accept(scanner, ',')))
     {
-        // We reached seconds, without so there may be microseconds
-        // Check for fractionnal seconds
-        if (iso8601_time[cursor] == '.' || iso8601_time[cursor] == ',')
+        uint32_t fraction = 0;
+        int fraction_len = 0;
+
+        while (_scan_is_digit(c = _scan_peek(scanner)))
         {
-            cursor++;
-            result = _parse_microseconds(utc_tm, iso8601_time + cursor);
-            if (result < 0)
+            if (fraction_len == 6)
             {
                 LOG_DBG("File %s, line %d : Invalid fractionnal time.\n", __FILE__, __LINE__);
-                return TINYUTC_ISO8601_TIME_FRACTION_TOO_LONG; // Invalid fraction
+                return TINYUTC_ISO8601_TIME_FRACTION_TOO_LONG;
             }
-            cursor += result; // Move the cursor
+            fraction = fraction * 10 + (c - '0');
+            fraction_len++;
+            scanner->pos++;
         }
-        else
+        if (fraction_len == 0)
         {
-            utc_tm->microseconds = 0; // Set the microseconds
+            return TINYUTC_ISO8601_INVALID_TIME; // Separator without digits
         }
+        for (; fraction_len < 6; fraction_len++)
+        {
+            fraction *= 10; // Shift to the left
+        }
+        utc_tm->microseconds = fraction;
     }
 
-    if (cursor == pattern_len)
-    {
-        return cursor; // No offset present
-    }
+    return _scan_offset(scanner, utc_offset);
+}
+
+/**
+ * SWAR (SIMD within a register) masks for the canonical "YYYY-MM-DDTHH:MM:SS[.ffffff]Z" layout.
+ * The string is loaded in little-endian 64 bits words: the first character is the lowest byte.
+ * Digit masks have 0xFF on the digits, separator patterns the expected separators elsewhere.
+ */
+#define _TINYUTC_SWAR_ONES 0x0101010101010101ULL
+#define _TINYUTC_SWAR_DATE_DIGITS 0x00FFFF00FFFFFFFFULL // "YYYY-MM-"
+#define _TINYUTC_SWAR_DATE_SEPARATORS 0x2D00002D00000000ULL
+#define _TINYUTC_SWAR_TIME_DIGITS 0xFFFF00FFFF00FFFFULL // "DDTHH:MM"
+#define _TINYUTC_SWAR_TIME_SEPARATORS 0x00003A0000540000ULL
+#define _TINYUTC_SWAR_SECOND_DIGITS 0x00FFFF00ULL // ":SS"
+#define _TINYUTC_SWAR_SECOND_SEPARATORS 0x0000003AULL
+#define _TINYUTC_SWAR_FRACTION_DIGITS 0x00FFFFFFFFFFFF00ULL // ".ffffffZ"
+#define _TINYUTC_SWAR_FRACTION_SEPARATORS 0x5A0000000000002EULL
+
+static inline uint64_t _swar_load(const char *str, int count)
+{
+    uint64_t word = 0;
 
-    int tmp_cursor = _parse_offset(&(iso8601_time[cursor]), utc_offset);
-    if (tmp_cursor < 0)
+    // Folded into a single load by compilers, whatever the endianness of the target
+    for (int i = 0; i < count; i++)
     {
-        LOG_DBG("File %s, line %d : Unable to parse time offset.\n", __FILE__, __LINE__);
-        return TINYUTC_ISO8601_INVALID_OFFSET; // Invalid offset format
+        word |= (uint64_t)(unsigned char)str[i] << (8 * i);
     }
-
-    return cursor + tmp_cursor; // Return the cursor position after parsing the offset
+    return word;
 }
 
-static int _parse_common_date(struct TinyUTCTime *utc_tm, const char *iso8601)
+/**
+ * @brief Checks that a word has digits on the digit mask, and the separators elsewhere,
+ *        then converts the digits to their values.
+ *
+ * A byte is a digit when its high nibble is 3, and stays 3 after adding 6 (low nibble up to 9).
+ * Separators are replaced by '0' before the check, and end up as 0.
+ *
+ * @param word Pointer to the word, replaced by the digit values.
+ * @return true if the layout matches.
+ */
+static inline bool _swar_check_digits(uint64_t *word, uint64_t digits, uint64_t separators)
 {
-    int cursor, result, pattern_len;
-    bool use_separator = false;
-
-    pattern_len = __tinyutc_strlen(iso8601);
+    uint64_t value = (*word & digits) | (0x30 * _TINYUTC_SWAR_ONES & ~digits);
 
-    if (pattern_len < 4)
+    if ((*word & ~digits) != separators ||
+        ((value & 0xF0 * _TINYUTC_SWAR_ONES) | (((value + 0x06 * _TINYUTC_SWAR_ONES) & 0xF0 * _TINYUTC_SWAR_ONES) >> 4)) != 0x33 * _TINYUTC_SWAR_ONES)
     {
-        return TINYUTC_ISO8601_INVALID_DATE; // Invalid date format
+        return false;
     }
+    *word = value - 0x30 * _TINYUTC_SWAR_ONES;
+    return true;
+}
 
-    // Parse year
-    result = _str_to_uint(iso8601, 4);
-    if (result < 0)
-    {
-        return TINYUTC_ISO8601_INVALID_DATE; // Invalid year
-    }
-    utc_tm->year = (uint16_t)result;
+/**
+ * @brief Combines each digit with the next one, the byte i becoming 10 * digit[i] + digit[i + 1].
+ */
+static inline uint64_t _swar_pairs(uint64_t digits)
+{
+    return digits * 10 + (digits >> 8);
+}
 
-    cursor = 4;
+#define _TINYUTC_SWAR_BYTE(WORD, INDEX) ((uint8_t)((WORD) >> (8 * (INDEX))))
 
-    if (cursor >= pattern_len)
-    {
-        return 0;
-    }
+/**
+ * @brief Parses the canonical "YYYY-MM-DDTHH:MM:SSZ" and "YYYY-MM-DDTHH:MM:SS.ffffffZ" layouts,
+ *        a few words at a time, without any per-character branch.
+ *
+ * Anything else, including valid but unusual values (24:00:00, leap seconds, days past the end
+ * of the month), is left to the generic parser, so that both give the same results.
+ *
+ * @param utc_tm Pointer to a TinyUTCTime structure, set on success.
+ * @param iso8601 String to parse.
+ * @param len Number of characters available in `iso8601`.
+ * @param consumed Pointer to the number of characters parsed, or NULL if the whole string must match.
+ * @param unix_ts Pointer to the Unix timestamp of the datetime, set on success.
+ * @return true if the string was parsed, false to fall back on the generic parser.
+ */
+static bool _parse_canonical_datetime(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed,
+                                      tinyutc_time_t *unix_ts)
+{
+    struct TinyUTCTime result = {0};
+    size_t end;
 
-    // Check for separator
-    if (iso8601[cursor] == '-')
+    // Reject the other layouts on the terminator first, before loading anything
+    if (len >= 20 && iso8601[19] == 'Z')
     {
-        use_separator = true;
-        cursor++; // Invalid date format
+        end = 20;
     }
-
-    // Parse month
-
-    result = _str_to_uint(iso8601 + cursor, 2);
-    if (result < 1 || result > 12)
+    else if (len >= 27 && iso8601[19] == '.' && iso8601[26] == 'Z')
     {
-        return TINYUTC_ISO8601_INVALID_DATE; // Invalid month
+        end = 27;
     }
-    utc_tm->month = (uint8_t)result;
-    cursor += 2;
-
-    if (cursor >= pattern_len)
+    else
     {
-        return 0;
+        return false;
     }
 
-    // Check for separator
-    if (iso8601[cursor] != '-' && use_separator)
+    if (consumed == 0 && len != end)
     {
-        return TINYUTC_ISO8601_DATE_SEPARATOR_INCONSISTENCY; // Invalid date format
+        return false;
     }
-    else if (iso8601[cursor] == '-' && !use_separator)
+
+    uint64_t date = _swar_load(iso8601, 8);
+    uint64_t time = _swar_load(iso8601 + 8, 8);
+    uint64_t second = _swar_load(iso8601 + 16, 3);
+
+    if (!_swar_check_digits(&date, _TINYUTC_SWAR_DATE_DIGITS, _TINYUTC_SWAR_DATE_SEPARATORS) ||
+        !_swar_check_digits(&time, _TINYUTC_SWAR_TIME_DIGITS, _TINYUTC_SWAR_TIME_SEPARATORS) ||
+        !_swar_check_digits(&second, _TINYUTC_SWAR_SECOND_DIGITS, _TINYUTC_SWAR_SECOND_SEPARATORS))
     {
-        return TINYUTC_ISO8601_DATE_SEPARATOR_INCONSISTENCY; // Invalid date format
+        return false;
     }
-    else
+
+    if (end == 27)
     {
-        if (use_separator)
+        uint64_t fraction = _swar_load(iso8601 + 19, 8);
+        if (!_swar_check_digits(&fraction, _TINYUTC_SWAR_FRACTION_DIGITS, _TINYUTC_SWAR_FRACTION_SEPARATORS))
         {
-            cursor++; // Skip separator
+            return false;
         }
+        fraction = _swar_pairs(fraction);
+        result.microseconds = _TINYUTC_SWAR_BYTE(fraction, 1) * 10000UL + _TINYUTC_SWAR_BYTE(fraction, 3) * 100UL + _TINYUTC_SWAR_BYTE(fraction, 5);
     }
 
-    // Parse day
-    result = _str_to_uint(iso8601 + cursor, 2);
-    if (result < 1 || result > 31)
-    {
-        return TINYUTC_ISO8601_INVALID_DATE; // Invalid day
-    }
-    utc_tm->day = (uint8_t)result;
-
-    return cursor + 2;
-}
-
-static int _parse_uncommon_date(struct TinyUTCTime *utc_tm, const char *iso8601)
-{
-    int cursor, result, pattern_len, dayno, ordinal_day;
-    bool use_separator = false;
+    date = _swar_pairs(date);
+    time = _swar_pairs(time);
+    second = _swar_pairs(second);
 
-    pattern_len = __tinyutc_strlen(iso8601);
+    result.year = _TINYUTC_SWAR_BYTE(date, 0) * 100 + _TINYUTC_SWAR_BYTE(date, 2);
+    result.month = _TINYUTC_SWAR_BYTE(date, 5);
+    result.day = _TINYUTC_SWAR_BYTE(time, 0);
+    result.hour = _TINYUTC_SWAR_BYTE(time, 3);
+    result.minute = _TINYUTC_SWAR_BYTE(time, 6);
+    result.second = _TINYUTC_SWAR_BYTE(second, 1);
 
-    if (pattern_len < 4)
+    // The conversion checks the range of the year, as the generic parser does
+    if (result.month < 1 || result.month > 12 || result.day < 1 ||
+        result.day > _TINYUTC_GET_DAYS_IN_MONTH(result.month - 1, result.year) ||
+        result.hour > 23 || result.minute > 59 || result.second > 59 ||
+        tinyutc_utc_to_unix(&result, unix_ts) < 0)
     {
-        return TINYUTC_ISO8601_INVALID_DATE; // Invalid date format
+        return false;
     }
 
-    // Parse year
-    result = _str_to_uint(iso8601, 4);
-    if (result < 0)
+    *utc_tm = result;
+    if (consumed != 0)
     {
-        return TINYUTC_ISO8601_INVALID_DATE; // Invalid year
+        *consumed = end;
     }
-    utc_tm->year = (uint16_t)result;
+    return true;
+}
 
-    cursor = 4;
+/**
+ * @brief Checks the canonical "YYYY-MM-DDTHH:MM:SS[.ffffff]Z" layouts, as `_parse_canonical_datetime`
+ *        parses them, but without building the time structure.
+ *
+ * The time pairs are range checked all at once: each of them gets a bias that sets its
+ * high bit when it is past its maximum.
+ *
+ * @return true if the string is a valid canonical datetime, false to fall back on the generic checks.
+ */
+static bool _validate_canonical_datetime(const char *iso8601, size_t len)
+{
+    uint32_t year, month, day;
 
-    // Check for separator
-    if (iso8601[cursor] == '-')
+    if (!(len == 20 && iso8601[19] == 'Z') && !(len == 27 && iso8601[19] == '.' && iso8601[26] == 'Z'))
     {
-        use_separator = true;
-        cursor++; // Invalid date format
+        return false;
     }
 
-    if (iso8601[cursor] == 'W')
-    {
-        cursor++;
-        // Parse week number
-        result = _str_to_uint(iso8601 + cursor, 2);
-
-        cursor += 2;
-
-        dayno = 1;
-
-        if (pattern_len > cursor)
-        {
-
-            if (iso8601[cursor] != '-' && use_separator)
-            {
-                return TINYUTC_ISO8601_DATE_SEPARATOR_INCONSISTENCY; // Invalid date format
-            }
-            else if (iso8601[cursor] == '-' && !use_separator)
-            {
-                return TINYUTC_ISO8601_DATE_SEPARATOR_INCONSISTENCY; // Invalid date format
-            }
-            else
-            {
-                if (use_separator)
-                {
-                    cursor++; // Skip separator
-                }
-            }
-
-            dayno = _str_to_uint(iso8601 + cursor, 1);
-
-            cursor++;
-        }
+    uint64_t date = _swar_load(iso8601, 8);
+    uint64_t time = _swar_load(iso8601 + 8, 8);
+    uint64_t second = _swar_load(iso8601 + 16, 3);
 
-        if (_parse_date_from_weekno(utc_tm, utc_tm->year, result, dayno) < 0)
-        {
-            return TINYUTC_ISO8601_INVALID_DATE; // Invalid week number or day of the week
-        }
-    }
-    else
+    if (!_swar_check_digits(&date, _TINYUTC_SWAR_DATE_DIGITS, _TINYUTC_SWAR_DATE_SEPARATORS) ||
+        !_swar_check_digits(&time, _TINYUTC_SWAR_TIME_DIGITS, _TINYUTC_SWAR_TIME_SEPARATORS) ||
+        !_swar_check_digits(&second, _TINYUTC_SWAR_SECOND_DIGITS, _TINYUTC_SWAR_SECOND_SEPARATORS))
     {
-        ordinal_day = _str_to_uint(iso8601 + cursor, 3);
-        if (ordinal_day < 1 ||
-            (ordinal_day > 366 && _TINYUTC_IS_LEAP_YEAR(utc_tm->year)) ||
-            (ordinal_day > 365 && !_TINYUTC_IS_LEAP_YEAR(utc_tm->year)))
-        {
-            return TINYUTC_ISO8601_INVALID_DATE; // Invalid ordinal day
-        }
-
-        struct TinyUTCTime january_1st = {
-            .year = utc_tm->year,
-            .month = 1,
-            .day = 1,
-            .hour = 0,
-            .minute = 0,
-            .second = 0,
-            .microseconds = 0}; // January 1st of the given year
+        return false;
+    }
 
-        tinyutc_time_t current_date;
-        uint8_t error = tinyutc_utc_to_unix(&january_1st, &current_date);
-        if (error < 0)
+    if (len == 27)
+    {
+        uint64_t fraction = _swar_load(iso8601 + 19, 8);
+        if (!_swar_check_digits(&fraction, _TINYUTC_SWAR_FRACTION_DIGITS, _TINYUTC_SWAR_FRACTION_SEPARATORS))
         {
-            return TINYUTC_ISO8601_INVALID_DATE; // Invalid date
+            return false;
         }
-
-        current_date += (ordinal_day - 1) * _TINYUTC_SECS_PER_DAY; // Calculate the Unix timestamp of the given ordinal day
-
-        struct TinyUTCTime new_date = {0};
-        tinyutc_unix_to_utc(&new_date, current_date); // Convert the Unix timestamp back to a TinyUTCTime structure
-
-        utc_tm->month = new_date.month; // Set the month
-        utc_tm->day = new_date.day;     // Set the day
-
-        cursor += 3;
     }
 
-    return cursor;
-}
-
-static int _tinyutc_parse_iso8601_date(struct TinyUTCTime *utc_tm, const char *iso8601_date)
-{
-
-    // Try to pase date in common format
-    int _cursor = _parse_common_date(utc_tm, iso8601_date);
+    date = _swar_pairs(date);
+    time = _swar_pairs(time);
+    second = _swar_pairs(second);
 
-    if (_cursor >= 0)
+    // Hours (byte 3) up to 23, minutes (byte 6) and seconds up to 59, leap seconds are left to the generic checks
+    if (((time + ((uint64_t)(128 - 24) << 24) + ((uint64_t)(128 - 60) << 48)) & 0x0080000080000000ULL) ||
+        ((second + ((uint64_t)(128 - 60) << 8)) & 0x8000ULL))
     {
-        return _cursor; // Date parsed successfully
+        return false;
     }
 
-    // Try to parse date in uncommon format
-    _cursor = _parse_uncommon_date(utc_tm, iso8601_date);
+    year = _TINYUTC_SWAR_BYTE(date, 0) * 100 + _TINYUTC_SWAR_BYTE(date, 2);
+    month = _TINYUTC_SWAR_BYTE(date, 5);
+    day = _TINYUTC_SWAR_BYTE(time, 0);
 
-    if (_cursor >= 0)
-    {
-        return _cursor; // Invalid date format
-    }
-
-    return TINYUTC_ISO8601_INVALID_DATE;
+    // Without an offset, the datetime fits if the whole of its day does
+    return month >= 1 && month <= 12 && day >= 1 && day <= _TINYUTC_GET_DAYS_IN_MONTH(month - 1, year) &&
+           year >= _TINYUTC_MIN_YEAR && _tinyutc_does_time_fit((int32_t)_tinyutc_days_from_civil(year, month, day), _TINYUTC_SECS_PER_DAY - 1);
 }
 
 err_t tinyutc_parse_iso8601_date(struct TinyUTCTime *utc_tm, const char *iso8601_date)
 {
-    int pattern_len, cursor;
     // Check if the input string is NULL or empty
     if (iso8601_date == 0 || *iso8601_date == '\0')
     {
         return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
     }
-    pattern_len = __tinyutc_strlen(iso8601_date);
 
-    cursor = _tinyutc_parse_iso8601_date(utc_tm, iso8601_date);
+    struct _TinyUTCISOScanner scanner = {iso8601_date, __tinyutc_strlen(iso8601_date), 0};
 
-    if (cursor < 0)
+    if (_scan_date(utc_tm, &scanner) < 0)
     {
-        return cursor; // Invalid date format
+        return TINYUTC_ISO8601_INVALID_DATE; // Invalid date format
     }
 
-    if (cursor != pattern_len)
+    if (scanner.pos != scanner.len)
     {
         return TINYUTC_ISO8601_EXTRANEOUS_DATE_COMPONENTS; // To much data present
     }
@@ -668,37 +683,34 @@ err_t tinyutc_parse_iso8601_date(struct TinyUTCTime *utc_tm, const char *iso8601
 
 err_t tinyutc_parse_iso8601_time(struct TinyUTCTime *utc_tm, const char *iso8601_time)
 {
-    int pattern_len, cursor, utc_offset = 0;
+    int utc_offset = 0;
+    err_t error;
 
-    pattern_len = __tinyutc_strlen(iso8601_time);
     // Check if the input string is NULL or empty
     if (iso8601_time == 0 || *iso8601_time == '\0')
     {
         return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
     }
 
-    cursor = 0;
-    // ISO8601 allow a "T" as starting character
-    if (*iso8601_time == 'T')
-    {
-        cursor++; // Skip separator
-    }
+    struct _TinyUTCISOScanner scanner = {iso8601_time, __tinyutc_strlen(iso8601_time), 0};
 
-    cursor += _parse_time(&(iso8601_time[cursor]), utc_tm, &utc_offset);
+    // ISO8601 allow a "T" as starting character
+    _scan_accept(&scanner, 'T');
 
-    if (cursor < 0)
+    error = _scan_time(utc_tm, &scanner, &utc_offset);
+    if (error < 0)
     {
-        return cursor; // Invalid time format
+        return error; // Invalid time format
     }
 
-    if (cursor != pattern_len)
+    if (scanner.pos != scanner.len)
     {
-        return TINYUTC_ISO8601_EXTRANEOUS_TIME_COMPONENTS; // UTC offset on time only is preposterous
+        return TINYUTC_ISO8601_EXTRANEOUS_TIME_COMPONENTS;
     }
 
     if (utc_offset != 0)
     {
-        return TINYUTC_ISO8601_UTC_OFFSET_WITHOUT_DATE;
+        return TINYUTC_ISO8601_UTC_OFFSET_WITHOUT_DATE; // UTC offset on time only is preposterous
     }
 
     // Tidy utc struct artifically : if 24:00:00, set to 00:00:00,
@@ -711,60 +723,1406 @@ err_t tinyutc_parse_iso8601_time(struct TinyUTCTime *utc_tm, const char *iso8601
     return 0;
 }
 
-err_t tinyutc_parse_iso8601_datetime(struct TinyUTCTime *utc_tm, const char *iso8601, bool use_strict_separator)
+/**
+ * @brief Parses a date, optionally followed by a separator, a time and an offset, without applying the offset.
+ *
+ * @param utc_tm Pointer to a TinyUTCTime structure, whose date and time are set.
+ * @param scanner Pointer to the scanner, moved after the datetime.
+ * @param is_whole_string true if the datetime must end the string.
+ * @param use_strict_separator true if the separator must be a 'T'.
+ * @param utc_offset Pointer to the offset, in seconds, set when present.
+ * @param has_time Pointer to a flag, set if a time follows the date.
+ * @return 0 on success, or a negative TinyUTCISO8601ErrorCode.
+ */
+static err_t _scan_datetime(struct TinyUTCTime *utc_tm, struct _TinyUTCISOScanner *scanner, bool is_whole_string,
+                            bool use_strict_separator, int *utc_offset, bool *has_time)
 {
-    int pattern_len, cursor;
+    const char *iso8601 = scanner->str;
+    err_t error;
 
-    pattern_len = __tinyutc_strlen(iso8601);
-
-    // Check if the input string is NULL or empty
-    if (iso8601 == 0 || *iso8601 == '\0')
-    {
-        return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
-    }
+    *has_time = false;
 
     // Parse the date
-    cursor = _tinyutc_parse_iso8601_date(utc_tm, iso8601);
-
-    if (cursor < 0)
+    if (_scan_date(utc_tm, scanner) < 0)
     {
         return TINYUTC_ISO8601_INVALID_DATE; // Invalid date format
     }
 
-    if (cursor == pattern_len)
+    // A time follows the separator, a 'T' or any character if not strict
+    if (scanner->len - scanner->pos >= 2 && (!use_strict_separator || iso8601[scanner->pos] == 'T') &&
+        _scan_is_digit((unsigned char)iso8601[scanner->pos + 1]))
     {
-        return 0; // No time or offset present
-    }
+        scanner->pos++; // Skip separator
 
-    // Skip separator
-    if (use_strict_separator)
-    {
-        if (iso8601[cursor] != 'T')
+        error = _scan_time(utc_tm, scanner, utc_offset);
+        if (error < 0)
         {
-            return TINYUTC_ISO8601_INVALID_MAIN_SEPARATOR; // Invalid separator
+            return error; // Invalid time format
         }
+        *has_time = true;
     }
-    cursor++;
-
-    // Parse the time
-
-    int utc_offset = 0;
-    int tmp_cursor = _parse_time(&(iso8601[cursor]), utc_tm, &utc_offset);
-    if (tmp_cursor < 0)
+    else
     {
-        return tmp_cursor; // Invalid date format
-    };
-    cursor += tmp_cursor; // Move the cursor
+        // No time, midnight
+        utc_tm->hour = 0;
+        utc_tm->minute = 0;
+        utc_tm->second = 0;
+        utc_tm->microseconds = 0;
+    }
+
+    if (is_whole_string && scanner->pos != scanner->len)
+    {
+        if (*has_time)
+        {
+            return TINYUTC_ISO8601_INVALID_FORMAT; // Extra characters after the time
+        }
+        if (use_strict_separator && iso8601[scanner->pos] != 'T')
+        {
+            return TINYUTC_ISO8601_INVALID_MAIN_SEPARATOR; // Invalid separator
+        }
+        return TINYUTC_ISO8601_INVALID_TIME; // Separator without a time
+    }
+
+    return 0;
+}
+
+err_t tinyutc_parse_iso8601_datetimen(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed,
+                                      bool use_strict_separator)
+{
+    struct _TinyUTCISOScanner scanner = {iso8601, len, 0};
+    tinyutc_time_t unix_ts;
+    int utc_offset = 0;
+    bool has_time;
+    err_t error;
+
+    // Check if the input string is NULL or empty
+    if (iso8601 == 0 || len == 0)
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
+    }
+
+    // Fast path for the most common layout
+    if (_parse_canonical_datetime(utc_tm, iso8601, len, consumed, &unix_ts))
+    {
+        return TINYUTC_ISO8601_OK;
+    }
+
+    error = _scan_datetime(utc_tm, &scanner, consumed == 0, use_strict_separator, &utc_offset, &has_time);
+    if (error < 0)
+    {
+        return error;
+    }
+
+    if (has_time && __tidy_utc_struct(utc_tm, utc_offset) < 0) // Tidy up the UTC structure
+    {
+        return TINYUTC_INTERNAL_ERROR;
+    }
+
+    if (consumed != 0)
+    {
+        *consumed = scanner.pos;
+    }
+
+    return TINYUTC_ISO8601_OK;
+}
+
+/**
+ * @brief Day number and seconds of the day of a parsed datetime, once its offset is applied.
+ *
+ * A leap second or 24:00:00 simply count as the next day. Hours and offsets are bounded,
+ * so a single carry brings the seconds back to the day.
+ *
+ * @return false if the datetime does not fit in `tinyutc_time_t`.
+ */
+static bool _local_to_days(const struct TinyUTCTime *local, int utc_offset, int32_t *days, int32_t *secs)
+{
+    if (local->year < _TINYUTC_MIN_YEAR)
+    {
+        return false; // Before the first representable year
+    }
+
+    *days = (int32_t)_tinyutc_days_from_civil(local->year, local->month, local->day);
+    *secs = local->hour * _TINYUTC_SECS_PER_HOUR + local->minute * _TINYUTC_SECS_PER_MIN + local->second - utc_offset;
+    if (*secs < 0)
+    {
+        *secs += _TINYUTC_SECS_PER_DAY;
+        (*days)--;
+    }
+    else if (*secs >= (int32_t)_TINYUTC_SECS_PER_DAY)
+    {
+        *secs -= _TINYUTC_SECS_PER_DAY;
+        (*days)++;
+    }
+
+    // The carry may also leave the years of the calendar
+    return *days >= _TINYUTC_MIN_DAYS && *days <= (int32_t)_TINYUTC_MAX_DAYS && _tinyutc_does_time_fit(*days, *secs);
+}
+
+/**
+ * @brief Bounded version of `tinyutc_parse_iso8601_to_unix`, see `tinyutc_parse_iso8601_datetimen`
+ *        for `len`, `consumed` and `use_strict_separator`.
+ */
+static err_t _parse_iso8601_to_unixn(const char *iso8601, size_t len, size_t *consumed, bool use_strict_separator,
+                                     tinyutc_time_t *unix_ts, uint32_t *micros)
+{
+    struct _TinyUTCISOScanner scanner = {iso8601, len, 0};
+    struct TinyUTCTime utc_tm = {0};
+    int utc_offset = 0;
+    bool has_time;
+    int32_t days, secs;
+    err_t error;
+
+    if (iso8601 == 0 || len == 0)
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
+    }
+
+    // The fast path already computed the timestamp to check the year range
+    if (!_parse_canonical_datetime(&utc_tm, iso8601, len, consumed, unix_ts))
+    {
+        error = _scan_datetime(&utc_tm, &scanner, consumed == 0, use_strict_separator, &utc_offset, &has_time);
+        if (error < 0)
+        {
+            return error;
+        }
+
+        if (!_local_to_days(&utc_tm, utc_offset, &days, &secs))
+        {
+            return TINYUTC_ISO8601_INVALID_DATE; // Does not fit in tinyutc_time_t
+        }
+
+        *unix_ts = _tinyutc_days_to_time((uint32_t)days) + (tinyutc_time_t)secs;
+
+        if (consumed != 0)
+        {
+            *consumed = scanner.pos;
+        }
+    }
+
+    if (micros != 0)
+    {
+        *micros = utc_tm.microseconds;
+    }
+
+    return TINYUTC_ISO8601_OK;
+}
+
+err_t tinyutc_parse_iso8601_to_unix(const char *iso8601, tinyutc_time_t *unix_ts, uint32_t *micros)
+{
+    // Check if the input string is NULL
+    if (iso8601 == 0)
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
+    }
+
+    return _parse_iso8601_to_unixn(iso8601, __tinyutc_strlen(iso8601), 0, true, unix_ts, micros);
+}
+
+err_t tinyutc_validate_iso8601_datetime(const char *iso8601, size_t len, uint32_t flags)
+{
+    struct _TinyUTCISOScanner scanner = {iso8601, len, 0};
+    struct TinyUTCTime local = {0};
+    int utc_offset = INT32_MIN; // Only set by signed offsets
+    int32_t days, secs;
+    uint16_t iso_year;
+    uint8_t week;
+    bool has_time;
+    err_t error;
+
+    if (iso8601 == 0 || len == 0)
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
+    }
+
+    // The canonical layout has a 'T', a time and an offset, so it meets every flag
+    if (_validate_canonical_datetime(iso8601, len))
+    {
+        return TINYUTC_ISO8601_OK;
+    }
+
+    error = _scan_datetime(&local, &scanner, true, (flags & TINYUTC_ISO8601_STRICT_SEPARATOR) != 0, &utc_offset, &has_time);
+    if (error < 0)
+    {
+        return error;
+    }
+
+    if ((flags & TINYUTC_ISO8601_REQUIRE_TIME) && !has_time)
+    {
+        return TINYUTC_ISO8601_INVALID_TIME; // Date only
+    }
+
+    // A time ends with a digit, unless it has an offset
+    if (utc_offset == INT32_MIN)
+    {
+        if ((flags & TINYUTC_ISO8601_REQUIRE_OFFSET) && (!has_time || (iso8601[len - 1] != 'Z' && iso8601[len - 1] != 'z')))
+        {
+            return TINYUTC_ISO8601_INVALID_OFFSET; // Local time
+        }
+        utc_offset = 0;
+    }
+
+    if (local.hour == 24 && local.microseconds != 0)
+    {
+        return TINYUTC_ISO8601_INVALID_TIME; // Past the end of the day
+    }
+
+    // The scanner only checks calendar days against 31, week and ordinal dates are always in their month
+    if (local.day > _TINYUTC_GET_DAYS_IN_MONTH(local.month - 1, local.year))
+    {
+        return TINYUTC_ISO8601_INVALID_DATE; // Past the end of the month
+    }
+
+    // Week 53 of a year with 52 weeks is the first week of the next year, and not in the year written
+    if (iso8601[4] == 'W' || iso8601[5] == 'W')
+    {
+        struct _TinyUTCISOScanner year_scanner = {iso8601, 4, 0};
+
+        if (tinyutc_get_iso_week(&local, &iso_year, &week) < 0 || iso_year != _scan_uint(&year_scanner, 4))
+        {
+            return TINYUTC_ISO8601_INVALID_DATE; // Invalid week number
+        }
+    }
+
+    if (!_local_to_days(&local, utc_offset, &days, &secs))
+    {
+        return TINYUTC_ISO8601_INVALID_DATE; // Does not fit in tinyutc_time_t
+    }
+
+    return TINYUTC_ISO8601_OK;
+}
+
+/**
+ * @brief Finds the next delimiter, eight bytes at a time.
+ *
+ * A byte equal to the delimiter is zero once xored with it, and zero bytes are found with
+ * the usual "has zero byte" trick, exact for the lowest one.
+ *
+ * @param str String to search.
+ * @param len Number of characters available in `str`.
+ * @param delimiter Character to find.
+ * @return The position of the delimiter, or `len` if there is none.
+ */
+static size_t _find_delimiter(const char *str, size_t len, char delimiter)
+{
+    const uint64_t pattern = (unsigned char)delimiter * _TINYUTC_SWAR_ONES;
+    size_t pos = 0;
+
+    for (; pos + 8 <= len; pos += 8)
+    {
+        uint64_t word = _swar_load(str + pos, 8) ^ pattern;
+        uint64_t zeros = (word - _TINYUTC_SWAR_ONES) & ~word & (0x80 * _TINYUTC_SWAR_ONES);
+
+        if (zeros != 0)
+        {
+            // Lowest zero byte, the first character being the lowest byte
+            for (; (zeros & 0x80) == 0; zeros >>= 8)
+            {
+                pos++;
+            }
+            return pos;
+        }
+    }
+
+    for (; pos < len && str[pos] != delimiter; pos++)
+        ;
+    return pos;
+}
+
+size_t tinyutc_parse_iso8601_bulk(tinyutc_time_t *unix_ts, uint32_t *micros, err_t *errors, size_t max_records, size_t *records,
+                                  const char *buffer, size_t len, char delimiter, bool is_end_of_input)
+{
+    // Canonical datetimes can not hold this delimiter, so it can only come right after them
+    bool is_canonical_delimiter = !_scan_is_digit((unsigned char)delimiter) && delimiter != '-' && delimiter != 'T' &&
+                                  delimiter != ':' && delimiter != '.' && delimiter != 'Z';
+    size_t pos = 0, count = 0;
+
+    while (count < max_records && pos < len)
+    {
+        const char *record = buffer + pos;
+        size_t available = len - pos;
+        size_t record_len;
+        struct TinyUTCTime utc_tm;
+        tinyutc_time_t ts = 0;
+        uint32_t us = 0;
+        err_t error;
+
+        // Fast path for the canonical layouts, without searching for the delimiter
+        if (is_canonical_delimiter && _parse_canonical_datetime(&utc_tm, record, available, &record_len, &ts))
+        {
+            if (delimiter == '\n' && record_len < available && record[record_len] == '\r')
+            {
+                record_len++; // CRLF line endings
+            }
+            if (record_len < available && record[record_len] == delimiter)
+            {
+                pos += record_len + 1;
+                unix_ts[count] = ts;
+                if (micros != 0)
+                {
+                    micros[count] = utc_tm.microseconds;
+                }
+                if (errors != 0)
+                {
+                    errors[count] = TINYUTC_ISO8601_OK;
+                }
+                count++;
+                continue;
+            }
+            ts = 0;
+        }
+
+        record_len = _find_delimiter(record, available, delimiter);
+        if (record_len == available && !is_end_of_input)
+        {
+            break; // Incomplete record, left for the next chunk
+        }
+        pos += record_len < available ? record_len + 1 : record_len;
+
+        // CRLF line endings
+        if (delimiter == '\n' && record_len > 0 && record[record_len - 1] == '\r')
+        {
+            record_len--;
+        }
+
+        error = _parse_iso8601_to_unixn(record, record_len, 0, true, &ts, &us);
+
+        unix_ts[count] = ts;
+        if (micros != 0)
+        {
+            micros[count] = us;
+        }
+        if (errors != 0)
+        {
+            errors[count] = error;
+        }
+        count++;
+    }
+
+    if (records != 0)
+    {
+        *records = count;
+    }
+    return pos;
+}
+
+err_t tinyutc_parse_iso8601_datetime(struct TinyUTCTime *utc_tm, const char *iso8601, bool use_strict_separator)
+{
+    // Check if the input string is NULL
+    if (iso8601 == 0)
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
+    }
+
+    return tinyutc_parse_iso8601_datetimen(utc_tm, iso8601, __tinyutc_strlen(iso8601), 0, use_strict_separator);
+}
+
+/**
+ * States of `struct TinyUTCIsoStream`, named after what the next character may be.
+ * The grammar is the one of `_scan_datetime`, the lookahead of the scanner being
+ * replaced by states waiting for the next character.
+ */
+enum _TinyUTCIsoStreamState
+{
+    _TINYUTC_STREAM_YEAR,
+    _TINYUTC_STREAM_AFTER_YEAR,        // '-', 'W' or the month
+    _TINYUTC_STREAM_WEEK,              // Week number
+    _TINYUTC_STREAM_AFTER_WEEK,        // Day of the week, or the end
+    _TINYUTC_STREAM_WEEK_DAY,          // Day of the week
+    _TINYUTC_STREAM_MONTH,             // Month, or the start of the ordinal day
+    _TINYUTC_STREAM_AFTER_MONTH,       // '-' and the day, or the third digit
+    _TINYUTC_STREAM_DAY,               // Day of the month
+    _TINYUTC_STREAM_ORDINAL,           // "YYYYDDD" or "YYYYMMDD", told apart by a fourth digit
+    _TINYUTC_STREAM_DATE_END,          // Separator, or the end
+    _TINYUTC_STREAM_SEPARATOR,         // First digit of the time
+    _TINYUTC_STREAM_TIME,              // Time component
+    _TINYUTC_STREAM_AFTER_TIME,        // Time separator, next component, or what follows the time
+    _TINYUTC_STREAM_AFTER_SECONDS,     // Fraction separator, offset, or the end
+    _TINYUTC_STREAM_FRACTION,          // Fraction digits
+    _TINYUTC_STREAM_OFFSET,            // 'Z', '+', '-', or the end
+    _TINYUTC_STREAM_OFFSET_HOUR,       // Hours of the offset
+    _TINYUTC_STREAM_AFTER_OFFSET_HOUR, // ':' or the minutes of the offset, or the end
+    _TINYUTC_STREAM_OFFSET_MINUTE,     // Minutes of the offset
+    _TINYUTC_STREAM_END,               // Nothing but the terminator
+    _TINYUTC_STREAM_DONE,              // Datetime complete
+    _TINYUTC_STREAM_ERROR,             // Skipping up to the terminator
+};
+
+#define _TINYUTC_STREAM_STRICT 0x01          // 'T' separator required
+#define _TINYUTC_STREAM_DATE_SEPARATOR 0x02  // Extended date format
+#define _TINYUTC_STREAM_TIME_SEPARATOR 0x04  // Extended time format
+#define _TINYUTC_STREAM_HAS_TIME 0x08        // A time follows the date
+#define _TINYUTC_STREAM_NEGATIVE_OFFSET 0x10 // '-' offset
+#define _TINYUTC_STREAM_PENDING_CR 0x20      // '\r' waiting for the next character
+
+#define _TINYUTC_STREAM_END_OF_INPUT (-1)
+
+/**
+ * @brief Resets the stream for the next datetime, keeping its settings.
+ */
+static void _stream_reset(struct TinyUTCIsoStream *stream)
+{
+    struct TinyUTCTime empty = {0};
+
+    stream->utc_tm = empty;
+    stream->utc_offset = 0;
+    stream->value = 0;
+    stream->digits = 0;
+    stream->first = 0;
+    stream->component = 0;
+    stream->state = _TINYUTC_STREAM_YEAR;
+    stream->flags &= _TINYUTC_STREAM_STRICT;
+    stream->error = TINYUTC_ISO8601_OK;
+}
+
+static inline void _stream_fail(struct TinyUTCIsoStream *stream, err_t error)
+{
+    stream->error = error;
+    stream->state = _TINYUTC_STREAM_ERROR;
+}
+
+/**
+ * @brief Appends a digit to the number being parsed.
+ *
+ * @return true when the number has `count` digits, it is then in `value`,
+ *         and the digit count is reset for the next one.
+ */
+static inline bool _stream_digit(struct TinyUTCIsoStream *stream, int c, uint8_t count)
+{
+    stream->value = stream->value * 10 + (uint32_t)(c - '0');
+    if (++stream->digits < count)
+    {
+        return false;
+    }
+    stream->digits = 0;
+    return true;
+}
+
+/**
+ * @brief Checks the time once its components are parsed, with the same limits as `_scan_time`.
+ *
+ * @return false on an invalid time, the stream having failed.
+ */
+static bool _stream_check_time(struct TinyUTCIsoStream *stream)
+{
+    const struct TinyUTCTime *utc_tm = &stream->utc_tm;
+
+    // We allow leap seconds, and 24:00:00 as midnight on the next day
+    if (utc_tm->hour > 24 || utc_tm->minute > 59 || utc_tm->second > 60 ||
+        (utc_tm->hour == 24 && (utc_tm->minute != 0 || utc_tm->second != 0)))
+    {
+        _stream_fail(stream, TINYUTC_ISO8601_INVALID_TIME);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stores the time component just parsed.
+ */
+static void _stream_set_time_component(struct TinyUTCIsoStream *stream)
+{
+    uint8_t *hms[3] = {&stream->utc_tm.hour, &stream->utc_tm.minute, &stream->utc_tm.second};
+
+    *hms[stream->component] = (uint8_t)stream->value;
+    stream->value = 0;
+    stream->digits = 0;
+}
+
+/**
+ * @brief Advances the stream by one character, or by the end of the datetime.
+ *
+ * A character ending a field is handed to the next state, so that each case only
+ * looks at the current character: the work per character is bounded.
+ *
+ * @param stream Pointer to the stream.
+ * @param c The character, or _TINYUTC_STREAM_END_OF_INPUT.
+ */
+static void _stream_step(struct TinyUTCIsoStream *stream, int c)
+{
+    const bool is_end = c == _TINYUTC_STREAM_END_OF_INPUT;
+    const bool is_digit = _scan_is_digit(c);
+
+    for (;;)
+    {
+        switch (stream->state)
+        {
+        case _TINYUTC_STREAM_YEAR:
+            if (!is_digit)
+            {
+                _stream_fail(stream, (is_end && stream->digits == 0) ? TINYUTC_ISO8601_EMPTY_STRING : TINYUTC_ISO8601_INVALID_DATE);
+            }
+            else if (_stream_digit(stream, c, 4))
+            {
+                stream->utc_tm.year = (uint16_t)stream->value;
+                stream->value = 0;
+                stream->state = _TINYUTC_STREAM_AFTER_YEAR;
+            }
+            return;
+
+        case _TINYUTC_STREAM_AFTER_YEAR:
+            if (c == '-' && !(stream->flags & _TINYUTC_STREAM_DATE_SEPARATOR))
+            {
+                stream->flags |= _TINYUTC_STREAM_DATE_SEPARATOR;
+                return;
+            }
+            if (c == 'W')
+            {
+                stream->state = _TINYUTC_STREAM_WEEK;
+                return;
+            }
+            if (!is_digit)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE);
+                return;
+            }
+            stream->state = _TINYUTC_STREAM_MONTH;
+            continue;
+
+        case _TINYUTC_STREAM_WEEK:
+        case _TINYUTC_STREAM_MONTH:
+            if (!is_digit)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE);
+            }
+            else if (_stream_digit(stream, c, 2))
+            {
+                stream->first = (uint8_t)stream->value;
+                stream->value = 0;
+                stream->state = stream->state == _TINYUTC_STREAM_WEEK ? _TINYUTC_STREAM_AFTER_WEEK : _TINYUTC_STREAM_AFTER_MONTH;
+            }
+            return;
+
+        case _TINYUTC_STREAM_AFTER_WEEK:
+            // The day of the week can only be omitted at the end of the string
+            if (is_end)
+            {
+                stream->state = _TINYUTC_STREAM_WEEK_DAY;
+                c = '1';
+                continue;
+            }
+            stream->state = _TINYUTC_STREAM_WEEK_DAY;
+            if (stream->flags & _TINYUTC_STREAM_DATE_SEPARATOR)
+            {
+                if (c != '-')
+                {
+                    _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE); // Inconsistent separator
+                }
+                return;
+            }
+            continue;
+
+        case _TINYUTC_STREAM_WEEK_DAY:
+            if (!_scan_is_digit(c) || _parse_date_from_weekno(&stream->utc_tm, stream->utc_tm.year, stream->first, (uint8_t)(c - '0')) < 0)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE);
+                return;
+            }
+            stream->state = _TINYUTC_STREAM_DATE_END;
+            if (is_end)
+            {
+                continue;
+            }
+            return;
+
+        case _TINYUTC_STREAM_AFTER_MONTH:
+            if (c == '-' && (stream->flags & _TINYUTC_STREAM_DATE_SEPARATOR))
+            {
+                stream->state = _TINYUTC_STREAM_DAY; // YYYY-MM-DD
+                return;
+            }
+            if (!is_digit)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE); // Reduced precision or inconsistent separator
+                return;
+            }
+            stream->value = (uint32_t)(c - '0');
+            if (stream->flags & _TINYUTC_STREAM_DATE_SEPARATOR)
+            {
+                // YYYY-DDD
+                if (_parse_date_from_ordinal(&stream->utc_tm, stream->utc_tm.year, stream->first * 10 + stream->value) < 0)
+                {
+                    _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE);
+                    return;
+                }
+                stream->value = 0;
+                stream->state = _TINYUTC_STREAM_DATE_END;
+                return;
+            }
+            stream->state = _TINYUTC_STREAM_ORDINAL;
+            return;
+
+        case _TINYUTC_STREAM_ORDINAL:
+            if (is_digit)
+            {
+                // YYYYMMDD
+                stream->value = stream->value * 10 + (uint32_t)(c - '0');
+                stream->state = _TINYUTC_STREAM_DAY;
+                stream->digits = 2; // Both digits of the day already read
+                continue;
+            }
+            // YYYYDDD
+            if (_parse_date_from_ordinal(&stream->utc_tm, stream->utc_tm.year, stream->first * 10 + stream->value) < 0)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE);
+                return;
+            }
+            stream->value = 0;
+            stream->state = _TINYUTC_STREAM_DATE_END;
+            continue;
+
+        case _TINYUTC_STREAM_DAY:
+            if (stream->digits < 2)
+            {
+                if (!is_digit)
+                {
+                    _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE);
+                    return;
+                }
+                if (!_stream_digit(stream, c, 2))
+                {
+                    return;
+                }
+            }
+            stream->digits = 0;
+            if (stream->first < 1 || stream->first > 12 || stream->value < 1 || stream->value > 31)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_DATE); // Invalid month or day
+                return;
+            }
+            stream->utc_tm.month = stream->first;
+            stream->utc_tm.day = (uint8_t)stream->value;
+            stream->value = 0;
+            stream->state = _TINYUTC_STREAM_DATE_END;
+            return;
+
+        case _TINYUTC_STREAM_DATE_END:
+            if (is_end)
+            {
+                stream->state = _TINYUTC_STREAM_DONE; // Date only, midnight
+            }
+            else if ((stream->flags & _TINYUTC_STREAM_STRICT) && c != 'T')
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_MAIN_SEPARATOR);
+            }
+            else
+            {
+                stream->state = _TINYUTC_STREAM_SEPARATOR;
+            }
+            return;
+
+        case _TINYUTC_STREAM_SEPARATOR:
+            if (!is_digit)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_TIME); // Separator without a time
+                return;
+            }
+            stream->flags |= _TINYUTC_STREAM_HAS_TIME;
+            stream->state = _TINYUTC_STREAM_TIME;
+            continue;
+
+        case _TINYUTC_STREAM_TIME:
+            if (is_digit)
+            {
+                if (_stream_digit(stream, c, 2))
+                {
+                    _stream_set_time_component(stream);
+                    if (stream->component < 2)
+                    {
+                        stream->state = _TINYUTC_STREAM_AFTER_TIME;
+                    }
+                    else if (_stream_check_time(stream))
+                    {
+                        stream->state = _TINYUTC_STREAM_AFTER_SECONDS;
+                    }
+                }
+                return;
+            }
+            // The last component may have a single digit when it ends the string
+            if (is_end && stream->component > 0 && stream->digits == 1)
+            {
+                _stream_set_time_component(stream);
+                if (_stream_check_time(stream))
+                {
+                    stream->state = _TINYUTC_STREAM_DONE;
+                }
+                return;
+            }
+            _stream_fail(stream, TINYUTC_ISO8601_INVALID_TIME);
+            return;
+
+        case _TINYUTC_STREAM_AFTER_TIME:
+            // The first separator dictates separator usage
+            if (c == ':')
+            {
+                if (stream->component > 0 && !(stream->flags & _TINYUTC_STREAM_TIME_SEPARATOR))
+                {
+                    _stream_fail(stream, TINYUTC_ISO8601_INCONSISTENT_TIME_SEPARATOR);
+                    return;
+                }
+                stream->flags |= _TINYUTC_STREAM_TIME_SEPARATOR;
+                stream->component++;
+                stream->state = _TINYUTC_STREAM_TIME;
+                return;
+            }
+            if (is_digit)
+            {
+                if (stream->flags & _TINYUTC_STREAM_TIME_SEPARATOR)
+                {
+                    _stream_fail(stream, TINYUTC_ISO8601_INCONSISTENT_TIME_SEPARATOR);
+                    return;
+                }
+                stream->component++;
+                stream->state = _TINYUTC_STREAM_TIME;
+                continue;
+            }
+            // No more components, and no fraction before the seconds
+            if (!_stream_check_time(stream))
+            {
+                return;
+            }
+            stream->state = _TINYUTC_STREAM_OFFSET;
+            continue;
+
+        case _TINYUTC_STREAM_AFTER_SECONDS:
+            if (c == '.' || c == ',')
+            {
+                stream->state = _TINYUTC_STREAM_FRACTION;
+                return;
+            }
+            stream->state = _TINYUTC_STREAM_OFFSET;
+            continue;
+
+        case _TINYUTC_STREAM_FRACTION:
+            if (is_digit)
+            {
+                if (stream->digits == 6)
+                {
+                    _stream_fail(stream, TINYUTC_ISO8601_TIME_FRACTION_TOO_LONG);
+                    return;
+                }
+                stream->value = stream->value * 10 + (uint32_t)(c - '0');
+                stream->digits++;
+                return;
+            }
+            if (stream->digits == 0)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_TIME); // Separator without digits
+                return;
+            }
+            for (; stream->digits < 6; stream->digits++)
+            {
+                stream->value *= 10; // Shift to the left
+            }
+            stream->utc_tm.microseconds = stream->value;
+            stream->value = 0;
+            stream->digits = 0;
+            stream->state = _TINYUTC_STREAM_OFFSET;
+            continue;
+
+        case _TINYUTC_STREAM_OFFSET:
+            if (c == 'Z' || c == 'z')
+            {
+                stream->state = _TINYUTC_STREAM_END;
+                return;
+            }
+            if (c == '+' || c == '-')
+            {
+                if (c == '-')
+                {
+                    stream->flags |= _TINYUTC_STREAM_NEGATIVE_OFFSET;
+                }
+                stream->state = _TINYUTC_STREAM_OFFSET_HOUR;
+                return;
+            }
+            stream->state = _TINYUTC_STREAM_END; // No offset
+            continue;
+
+        case _TINYUTC_STREAM_OFFSET_HOUR:
+        case _TINYUTC_STREAM_OFFSET_MINUTE:
+            if (!is_digit)
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_OFFSET);
+                return;
+            }
+            if (!_stream_digit(stream, c, 2))
+            {
+                return;
+            }
+            if (stream->value > (stream->state == _TINYUTC_STREAM_OFFSET_HOUR ? 23U : 59U))
+            {
+                LOG_DBG("File %s, line %d : Invalid offset\n", __FILE__, __LINE__);
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_OFFSET);
+                return;
+            }
+            if (stream->state == _TINYUTC_STREAM_OFFSET_HOUR)
+            {
+                stream->utc_offset = (int32_t)stream->value * 3600;
+                stream->state = _TINYUTC_STREAM_AFTER_OFFSET_HOUR;
+            }
+            else
+            {
+                stream->utc_offset += (int32_t)stream->value * 60;
+                stream->state = _TINYUTC_STREAM_END;
+            }
+            stream->value = 0;
+            return;
+
+        case _TINYUTC_STREAM_AFTER_OFFSET_HOUR:
+            if (c == ':')
+            {
+                stream->state = _TINYUTC_STREAM_OFFSET_MINUTE;
+                return;
+            }
+            stream->state = is_digit ? _TINYUTC_STREAM_OFFSET_MINUTE : _TINYUTC_STREAM_END;
+            continue;
+
+        case _TINYUTC_STREAM_END:
+            if (is_end)
+            {
+                stream->state = _TINYUTC_STREAM_DONE;
+            }
+            else
+            {
+                _stream_fail(stream, TINYUTC_ISO8601_INVALID_FORMAT); // Extra characters after the time
+            }
+            return;
+
+        default: // _TINYUTC_STREAM_ERROR, skipping up to the terminator
+            return;
+        }
+    }
+}
+
+void tinyutc_iso_stream_init(struct TinyUTCIsoStream *stream, char terminator, bool use_strict_separator)
+{
+    stream->terminator = terminator;
+    stream->flags = use_strict_separator ? _TINYUTC_STREAM_STRICT : 0;
+    _stream_reset(stream);
+}
+
+err_t tinyutc_iso_feed(struct TinyUTCIsoStream *stream, char c, struct TinyUTCTime *utc_tm)
+{
+    err_t error;
+
+    // A '\r' is only dropped right before a '\n' terminator
+    if (stream->flags & _TINYUTC_STREAM_PENDING_CR)
+    {
+        stream->flags &= ~_TINYUTC_STREAM_PENDING_CR;
+        if (c != stream->terminator)
+        {
+            _stream_step(stream, '\r');
+        }
+    }
+
+    if (c != stream->terminator)
+    {
+        if (c == '\r' && stream->terminator == '\n')
+        {
+            stream->flags |= _TINYUTC_STREAM_PENDING_CR;
+        }
+        else
+        {
+            _stream_step(stream, (unsigned char)c);
+        }
+        return TINYUTC_ISO8601_IN_PROGRESS;
+    }
+
+    _stream_step(stream, _TINYUTC_STREAM_END_OF_INPUT);
+    error = stream->error;
+
+    if (error == TINYUTC_ISO8601_OK)
+    {
+        int utc_offset = (stream->flags & _TINYUTC_STREAM_NEGATIVE_OFFSET) ? -stream->utc_offset : stream->utc_offset;
+
+        if ((stream->flags & _TINYUTC_STREAM_HAS_TIME) && __tidy_utc_struct(&stream->utc_tm, utc_offset) < 0)
+        {
+            error = TINYUTC_INTERNAL_ERROR;
+        }
+        else
+        {
+            *utc_tm = stream->utc_tm;
+        }
+    }
+
+    _stream_reset(stream);
+    return error;
+}
+
+size_t tinyutc_iso_feedn(struct TinyUTCIsoStream *stream, const char *buffer, size_t len, struct TinyUTCTime *utc_tm, err_t *result)
+{
+    size_t pos = 0;
+
+    *result = TINYUTC_ISO8601_IN_PROGRESS;
+    while (pos < len && *result == TINYUTC_ISO8601_IN_PROGRESS)
+    {
+        *result = tinyutc_iso_feed(stream, buffer[pos++], utc_tm);
+    }
+    return pos;
+}
+
+/**
+ * @brief Reads a number of `count` digits at a fixed position, already checked to be digits.
+ */
+static inline uint32_t _layout_number(const char *iso8601, uint8_t pos, uint8_t count)
+{
+    uint32_t result = 0;
+
+    for (uint8_t i = pos; i < pos + count; i++)
+    {
+        result = result * 10 + (uint32_t)(iso8601[i] - '0');
+    }
+    return result;
+}
+
+/**
+ * @brief Parses a datetime with a learned layout: the digits and separators are checked
+ *        a word at a time, and the fields are read at fixed positions.
+ *
+ * The date and separator are compared with the ones of the previous datetime, in the
+ * first two words: when they match, the cached date and day number are reused.
+ *
+ * Like the canonical fast path, unusual values are left to the generic parser, so that
+ * both give the same results. The offset is not applied.
+ *
+ * @param context Pointer to the context, with a learned layout, whose date cache is updated.
+ * @param local Pointer to a TinyUTCTime structure, set to the local datetime on success.
+ * @param days Pointer to the day number of the local date, set on success.
+ * @param utc_offset Pointer to the offset, in seconds, set on success.
+ * @param iso8601 String to parse.
+ * @param len Number of characters available in `iso8601`, all of them part of the datetime.
+ * @return true if the string was parsed, false to fall back on the generic parser.
+ */
+static bool _parse_with_layout(struct TinyUTCIsoContext *context, struct TinyUTCTime *local, int32_t *days, int *utc_offset,
+                               const char *iso8601, size_t len)
+{
+    const struct TinyUTCIsoLayout *layout = &context->layout;
+    struct TinyUTCTime result = {0};
+    size_t prefix_len = layout->hour != 0 ? layout->hour : layout->len; // Date and separator, at most 16 characters
+    uint64_t prefix[2] = {0, 0};
+
+    if (len != layout->len)
+    {
+        return false;
+    }
+
+    for (size_t w = 0; w * 8 < len; w++)
+    {
+        // Whole words are a single load, only the last one may be shorter
+        uint64_t word = (w + 1) * 8 <= len ? _swar_load(iso8601 + w * 8, 8) : _swar_load(iso8601 + w * 8, (int)(len - w * 8));
+        if (w < 2)
+        {
+            prefix[w] = w * 8 + 8 <= prefix_len ? word : (w * 8 < prefix_len ? word & ((1ULL << (8 * (prefix_len - w * 8))) - 1) : 0);
+        }
+        if (layout->offset != 0 && (layout->offset >> 3) == w && iso8601[layout->offset] == '-')
+        {
+            word ^= 0x06ULL << (8 * (layout->offset & 7)); // Both signs match the '+' of the layout
+        }
+        if (!_swar_check_digits(&word, layout->digits[w], layout->separators[w]))
+        {
+            return false;
+        }
+    }
+
+    if (context->is_prefix_valid && prefix[0] == context->prefix[0] && prefix[1] == context->prefix[1])
+    {
+        // Same day as the previous datetime
+        result.year = context->year;
+        result.month = context->month;
+        result.day = context->day;
+        *days = context->days;
+        context->prefix_hits++;
+    }
+    else
+    {
+        result.year = (uint16_t)_layout_number(iso8601, 0, 4);
+        result.month = (uint8_t)_layout_number(iso8601, layout->month, 2);
+        result.day = (uint8_t)_layout_number(iso8601, layout->day, 2);
+
+        if (result.year < _TINYUTC_MIN_YEAR || result.month < 1 || result.month > 12 || result.day < 1 ||
+            result.day > _TINYUTC_GET_DAYS_IN_MONTH(result.month - 1, result.year))
+        {
+            return false;
+        }
+        *days = (int32_t)_tinyutc_days_from_civil(result.year, result.month, result.day);
+
+        context->prefix[0] = prefix[0];
+        context->prefix[1] = prefix[1];
+        context->year = result.year;
+        context->month = result.month;
+        context->day = result.day;
+        context->days = *days;
+        context->is_prefix_valid = true;
+    }
+
+    *utc_offset = 0;
+    if (layout->hour != 0)
+    {
+        result.hour = (uint8_t)_layout_number(iso8601, layout->hour, 2);
+        result.minute = (uint8_t)_layout_number(iso8601, layout->minute, 2);
+        result.second = (uint8_t)_layout_number(iso8601, layout->second, 2);
+
+        if (result.hour > 23 || result.minute > 59 || result.second > 59)
+        {
+            return false;
+        }
+
+        if (layout->fraction_len != 0)
+        {
+            result.microseconds = _layout_number(iso8601, layout->fraction, layout->fraction_len);
+            for (uint8_t i = layout->fraction_len; i < 6; i++)
+            {
+                result.microseconds *= 10; // Shift to the left
+            }
+        }
+
+        if (layout->offset != 0)
+        {
+            uint32_t hour_offset = _layout_number(iso8601, layout->offset + 1, 2);
+            uint32_t minute_offset = layout->offset_minute != 0 ? _layout_number(iso8601, layout->offset_minute, 2) : 0;
+
+            if (hour_offset > 23 || minute_offset > 59)
+            {
+                return false;
+            }
+            *utc_offset = (int)(hour_offset * 3600 + minute_offset * 60);
+            if (iso8601[layout->offset] == '-')
+            {
+                *utc_offset = -*utc_offset;
+            }
+        }
+    }
+
+    *local = result;
+    return true;
+}
+
+/**
+ * @brief Applies the offset to a datetime parsed with a layout, as `__tidy_utc_struct` does.
+ *
+ * @return false if the datetime does not fit in `tinyutc_time_t`, to fall back on the generic parser.
+ */
+static bool _layout_to_utc(const struct TinyUTCIsoLayout *layout, struct TinyUTCTime *utc_tm, int32_t days, int utc_offset)
+{
+    int32_t local_secs, secs;
+
+    if (layout->hour == 0)
+    {
+        return true; // Date only, not converted by the generic parser either
+    }
+
+    local_secs = utc_tm->hour * _TINYUTC_SECS_PER_HOUR + utc_tm->minute * _TINYUTC_SECS_PER_MIN + utc_tm->second;
+    secs = local_secs - utc_offset;
+    if (!_tinyutc_does_time_fit(days, local_secs))
+    {
+        return false;
+    }
+
+    // Within the same day only the time changes, otherwise the date moves too
+    if (secs >= 0 && secs < (int32_t)_TINYUTC_SECS_PER_DAY)
+    {
+        if (!_tinyutc_does_time_fit(days, secs))
+        {
+            return false;
+        }
+        _tinyutc_split_seconds_of_day((uint32_t)secs, &utc_tm->hour, &utc_tm->minute, &utc_tm->second);
+        return true;
+    }
+    return __tidy_utc_struct(utc_tm, utc_offset) == 0;
+}
+
+/**
+ * @brief Computes the timestamp of a datetime parsed with a layout, from the day number
+ *        of its date, as `_parse_iso8601_to_unixn` does.
+ *
+ * @return false if the datetime does not fit in `tinyutc_time_t`, to fall back on the generic parser.
+ */
+static bool _layout_to_unix(const struct TinyUTCTime *local, int32_t days, int utc_offset, tinyutc_time_t *unix_ts)
+{
+    int32_t secs = local->hour * _TINYUTC_SECS_PER_HOUR + local->minute * _TINYUTC_SECS_PER_MIN + local->second - utc_offset;
+
+    // Hours and offsets are bounded, so a single carry brings them back to the day
+    if (secs < 0)
+    {
+        secs += _TINYUTC_SECS_PER_DAY;
+        days--;
+    }
+    else if (secs >= (int32_t)_TINYUTC_SECS_PER_DAY)
+    {
+        secs -= _TINYUTC_SECS_PER_DAY;
+        days++;
+    }
+
+    if (days < _TINYUTC_MIN_DAYS || days > (int32_t)_TINYUTC_MAX_DAYS || !_tinyutc_does_time_fit(days, secs))
+    {
+        return false;
+    }
+
+    *unix_ts = _tinyutc_days_to_time((uint32_t)days) + (tinyutc_time_t)secs;
+    return true;
+}
+
+/**
+ * @brief Marks `count` characters from `pos` as digits in a layout.
+ */
+static void _layout_set_digits(struct TinyUTCIsoLayout *layout, size_t pos, size_t count)
+{
+    for (; count > 0 && pos < _TINYUTC_ISO_LAYOUT_WORDS * 8; pos++, count--)
+    {
+        layout->digits[pos >> 3] |= 0xFFULL << (8 * (pos & 7));
+    }
+}
+
+/**
+ * @brief Learns the layout of a datetime the generic parser accepted.
+ *
+ * Only the full calendar layouts are learned: "YYYY-MM-DD" or "YYYYMMDD", optionally followed
+ * by any separator character, "hh:mm:ss" or "hhmmss", a fraction of 1 to 6 digits, and an offset
+ * "Z", "+hh", "+hhmm" or "+hh:mm". The layout is then checked on the datetime itself.
+ *
+ * @param context Pointer to the context, whose layout and date cache are set.
+ * @param iso8601 The datetime.
+ * @param len Number of characters of the datetime.
+ * @param expected The parsed local datetime, before its offset is applied.
+ * @param expected_offset The parsed offset, in seconds.
+ * @return true if the layout was learned.
+ */
+static bool _learn_layout(struct TinyUTCIsoContext *context, const char *iso8601, size_t len, const struct TinyUTCTime *expected,
+                          int expected_offset)
+{
+    struct TinyUTCIsoLayout learned = {0};
+    struct TinyUTCIsoContext probe = *context;
+    struct TinyUTCTime result;
+    int32_t days;
+    int utc_offset;
+    size_t pos;
+
+    if (len > _TINYUTC_ISO_LAYOUT_WORDS * 8)
+    {
+        return false;
+    }
+
+    // Date, the values being checked with the whole layout
+    learned.month = (len > 4 && iso8601[4] == '-') ? 5 : 4;
+    learned.day = learned.month == 5 ? 8 : 6;
+    _layout_set_digits(&learned, 0, 4);
+    _layout_set_digits(&learned, learned.month, 2);
+    _layout_set_digits(&learned, learned.day, 2);
+    pos = learned.day + 2u;
+
+    if (pos < len)
+    {
+        // Any separator, then the time
+        bool use_separator = pos + 3 < len && iso8601[pos + 3] == ':';
+
+        learned.hour = (uint8_t)(pos + 1);
+        learned.minute = (uint8_t)(learned.hour + (use_separator ? 3 : 2));
+        learned.second = (uint8_t)(learned.minute + (use_separator ? 3 : 2));
+        if (learned.minute + 2u >= len ||
+            (use_separator ? iso8601[learned.minute + 2] != ':' : !_scan_is_digit((unsigned char)iso8601[learned.minute + 2])))
+        {
+            return false; // No seconds, their place could be taken by an offset
+        }
+        _layout_set_digits(&learned, learned.hour, 2);
+        _layout_set_digits(&learned, learned.minute, 2);
+        _layout_set_digits(&learned, learned.second, 2);
+        pos = learned.second + 2u;
+
+        if (pos < len && (iso8601[pos] == '.' || iso8601[pos] == ','))
+        {
+            learned.fraction = (uint8_t)(pos + 1);
+            for (pos++; pos < len && _scan_is_digit((unsigned char)iso8601[pos]); pos++)
+            {
+                learned.fraction_len++;
+            }
+            if (learned.fraction_len == 0 || learned.fraction_len > 6)
+            {
+                return false;
+            }
+            _layout_set_digits(&learned, learned.fraction, learned.fraction_len);
+        }
+
+        if (pos < len && (iso8601[pos] == 'Z' || iso8601[pos] == 'z'))
+        {
+            pos++;
+        }
+        else if (pos < len && (iso8601[pos] == '+' || iso8601[pos] == '-'))
+        {
+            learned.offset = (uint8_t)pos;
+            _layout_set_digits(&learned, pos + 1, 2);
+            pos += 3;
+            if (pos < len)
+            {
+                learned.offset_minute = (uint8_t)(iso8601[pos] == ':' ? pos + 1 : pos);
+                _layout_set_digits(&learned, learned.offset_minute, 2);
+                pos = learned.offset_minute + 2u;
+            }
+        }
+    }
+
+    if (pos != len)
+    {
+        return false; // Week or ordinal date, reduced precision, ...
+    }
+
+    // The characters of this datetime outside the digits, none of them a digit
+    learned.len = (uint8_t)len;
+    for (pos = 0; pos < len; pos++)
+    {
+        uint64_t mask = 0xFFULL << (8 * (pos & 7));
+        uint64_t c = (pos == learned.offset && learned.offset != 0) ? '+' : (unsigned char)iso8601[pos];
+
+        if ((learned.digits[pos >> 3] & mask) == 0)
+        {
+            if (_scan_is_digit((int)c))
+            {
+                return false;
+            }
+            learned.separators[pos >> 3] |= c << (8 * (pos & 7));
+        }
+    }
+
+    probe.layout = learned;
+    probe.is_prefix_valid = false;
+    if (!_parse_with_layout(&probe, &result, &days, &utc_offset, iso8601, len) || utc_offset != expected_offset ||
+        result.year != expected->year || result.month != expected->month || result.day != expected->day ||
+        result.hour != expected->hour || result.minute != expected->minute || result.second != expected->second ||
+        result.microseconds != expected->microseconds)
+    {
+        return false;
+    }
+
+    // Keeps the date cache of the check
+    probe.prefix_hits = context->prefix_hits;
+    probe.is_learned = true;
+    *context = probe;
+    return true;
+}
+
+/**
+ * @brief Parses a datetime the layout of a context missed, with the generic parser, but
+ *        keeps its local fields and its offset apart, to learn its layout from them.
+ *
+ * @param context Pointer to the context.
+ * @param local Pointer to a TinyUTCTime structure, set to the local datetime.
+ * @param utc_offset Pointer to the offset, in seconds.
+ * @param has_time Pointer to a boolean, set if the datetime has a time.
+ * @param iso8601 String to parse.
+ * @param len Number of characters available in `iso8601`, all of them part of the datetime.
+ * @return err_t Error code indicating success or the type of parsing failure.
+ */
+static err_t _parse_missed_datetime(const struct TinyUTCIsoContext *context, struct TinyUTCTime *local, int *utc_offset, bool *has_time,
+                                    const char *iso8601, size_t len)
+{
+    struct _TinyUTCISOScanner scanner = {iso8601, len, 0};
+    tinyutc_time_t unix_ts;
+
+    *utc_offset = 0;
+    *has_time = true;
+    if (iso8601 == 0 || len == 0)
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING; // Invalid input
+    }
+
+    // The canonical layouts are UTC, their local datetime is already the result
+    if (_parse_canonical_datetime(local, iso8601, len, 0, &unix_ts))
+    {
+        return TINYUTC_ISO8601_OK;
+    }
+
+    return _scan_datetime(local, &scanner, true, context->use_strict_separator, utc_offset, has_time);
+}
+
+void tinyutc_iso_context_init(struct TinyUTCIsoContext *context, bool use_strict_separator)
+{
+    struct TinyUTCIsoLayout empty = {0};
+
+    context->layout = empty;
+    context->is_learned = false;
+    context->use_strict_separator = use_strict_separator;
+    context->hits = 0;
+    context->misses = 0;
+    context->prefix[0] = 0;
+    context->prefix[1] = 0;
+    context->days = 0;
+    context->year = 0;
+    context->month = 0;
+    context->day = 0;
+    context->is_prefix_valid = false;
+    context->prefix_hits = 0;
+}
+
+err_t tinyutc_iso_context_parse(struct TinyUTCIsoContext *context, struct TinyUTCTime *utc_tm, const char *iso8601, size_t len)
+{
+    struct TinyUTCTime result = {0};
+    int32_t days;
+    int utc_offset;
+    bool has_time;
+    err_t error;
 
-    if (cursor != pattern_len)
+    if (context->is_learned && iso8601 != 0 && _parse_with_layout(context, &result, &days, &utc_offset, iso8601, len) &&
+        _layout_to_utc(&context->layout, &result, days, utc_offset))
     {
-        return TINYUTC_ISO8601_INVALID_FORMAT; // Return the cursor position after parsing the offset
+        *utc_tm = result;
+        context->hits++;
+        return TINYUTC_ISO8601_OK;
     }
 
-    if (__tidy_utc_struct(utc_tm, utc_offset) < 0) // Tidy up the UTC structure
+    context->misses++;
+    error = _parse_missed_datetime(context, &result, &utc_offset, &has_time, iso8601, len);
+    if (error < 0)
+    {
+        return error;
+    }
+
+    *utc_tm = result;
+    if (has_time && __tidy_utc_struct(utc_tm, utc_offset) < 0)
     {
         return TINYUTC_INTERNAL_ERROR;
     }
 
+    // A new layout replaces the previous one, an unusual value of the same layout keeps it
+    _learn_layout(context, iso8601, len, &result, utc_offset);
+    return TINYUTC_ISO8601_OK;
+}
+
+err_t tinyutc_iso_context_parse_to_unix(struct TinyUTCIsoContext *context, const char *iso8601, size_t len, tinyutc_time_t *unix_ts,
+                                        uint32_t *micros)
+{
+    struct TinyUTCTime result = {0};
+    int32_t days, secs;
+    int utc_offset;
+    bool has_time;
+    err_t error;
+
+    if (context->is_learned && iso8601 != 0 && _parse_with_layout(context, &result, &days, &utc_offset, iso8601, len) &&
+        _layout_to_unix(&result, days, utc_offset, unix_ts))
+    {
+        if (micros != 0)
+        {
+            *micros = result.microseconds;
+        }
+        context->hits++;
+        return TINYUTC_ISO8601_OK;
+    }
+
+    context->misses++;
+    error = _parse_missed_datetime(context, &result, &utc_offset, &has_time, iso8601, len);
+    if (error < 0)
+    {
+        return error;
+    }
+
+    if (!_local_to_days(&result, utc_offset, &days, &secs))
+    {
+        return TINYUTC_ISO8601_INVALID_DATE; // Does not fit in tinyutc_time_t
+    }
+
+    *unix_ts = _tinyutc_days_to_time((uint32_t)days) + (tinyutc_time_t)secs;
+    if (micros != 0)
+    {
+        *micros = result.microseconds;
+    }
+
+    _learn_layout(context, iso8601, len, &result, utc_offset);
     return TINYUTC_ISO8601_OK;
 }
@@ -23,6 +23,7 @@
 #define LOG_DBG(...)
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -36,6 +37,7 @@ extern "C"
     enum TinyUTCISO8601ErrorCode
     {
         TINYUTC_ISO8601_OK = 0,
+        TINYUTC_ISO8601_IN_PROGRESS = 1, // Streaming parser waiting for more characters
         TINYUTC_ISO8601_INVALID_FORMAT = -1,
         TINYUTC_ISO8601_INVALID_DATE = -2,
         TINYUTC_ISO8601_INVALID_TIME = -3,
@@ -52,18 +54,275 @@ extern "C"
     };
 
     /**
-     * @brief Parses an ISO 8601 formatted time string into a TinyUTCTime structure.
+     * @brief Parses an ISO 8601 formatted datetime string into a TinyUTCTime structure.
      *
-     * This function takes a string representing a time in ISO 8601 format (e.g., "12:34:56" or "12:34:56Z")
-     * and fills the provided TinyUTCTime structure with the corresponding time values.
+     * This function attempts to parse the provided ISO 8601 datetime string and populate
+     * the given TinyUTCTime structure with the corresponding date and time values.
      *
-     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed time values.
-     * @param[in] iso8601_time Null-terminated string containing the ISO 8601 formatted time.
-     * @return err_t Error code indicating the result of the parsing operation.
-     *         Returns 0 on success, or a non-zero error code on failure (e.g., invalid format).
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed values.
+     * @param[in] iso8601 Null-terminated string containing the ISO 8601 datetime to parse.
+     * @param[in] use_strict_separator If true, requires strict use of 'T' as the date-time separator.
+     *                                 If false, allows any char as a valid separator.
+     * @return err_t Error code indicating success or the type of parsing failure.
      */
     err_t tinyutc_parse_iso8601_datetime(struct TinyUTCTime *utc_tm, const char *iso8601, bool use_strict_separator);
 
+    /**
+     * @brief Parses an ISO 8601 formatted datetime out of a string of known length.
+     *
+     * The string does not need to be null-terminated: each character is read at most once,
+     * and never past `len`. The date may be followed by a separator, a time, and an offset.
+     *
+     * When `consumed` is not NULL, the datetime may be followed by other characters (e.g.
+     * in a log line), and the number of characters parsed is stored there on success. When
+     * it is NULL, the whole `len` characters must be a datetime.
+     *
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed values.
+     * @param[in] iso8601 String containing the ISO 8601 datetime to parse.
+     * @param[in] len Number of characters available in `iso8601`.
+     * @param[out] consumed Pointer to the number of characters parsed, or NULL.
+     * @param[in] use_strict_separator If true, requires strict use of 'T' as the date-time separator.
+     *                                 If false, allows any char as a valid separator.
+     * @return err_t Error code indicating success or the type of parsing failure.
+     */
+    err_t tinyutc_parse_iso8601_datetimen(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed,
+                                          bool use_strict_separator);
+
+    /**
+     * @brief Parses an ISO 8601 formatted datetime string straight to a Unix timestamp.
+     *
+     * Same as `tinyutc_parse_iso8601_datetime` followed by `tinyutc_utc_to_unix`, with a strict
+     * 'T' separator, but the timestamp is computed once from the parsed fields and offset,
+     * without converting back and forth between structures. A leap second counts as the first
+     * second of the next minute, as it does with `tinyutc_utc_to_unix`.
+     *
+     * @param[in] iso8601 Null-terminated string containing the ISO 8601 datetime to parse.
+     * @param[out] unix_ts Pointer to the Unix timestamp of the datetime, in UTC.
+     * @param[out] micros Pointer to the microseconds of the datetime, or NULL.
+     * @return err_t Error code indicating success or the type of parsing failure. Datetimes
+     *         that do not fit in `tinyutc_time_t` are TINYUTC_ISO8601_INVALID_DATE.
+     */
+    err_t tinyutc_parse_iso8601_to_unix(const char *iso8601, tinyutc_time_t *unix_ts, uint32_t *micros);
+
+#define TINYUTC_ISO8601_STRICT_SEPARATOR 0x01 // 'T' required between the date and the time
+#define TINYUTC_ISO8601_REQUIRE_TIME 0x02     // Dates alone are rejected
+#define TINYUTC_ISO8601_REQUIRE_OFFSET 0x04   // Local times are rejected, "Z" or "+hh:mm" required
+
+    /**
+     * @brief Checks that a string is an ISO 8601 datetime, without parsing it into anything.
+     *
+     * Accepts the same layouts as `tinyutc_parse_iso8601_datetimen` without `consumed`, but is
+     * stricter on the values: the day must exist in its month (no February 30th), week 53 must
+     * exist in its year, 24:00:00 cannot have a fraction, and the datetime, once its offset is
+     * applied, must fit in `tinyutc_time_t`. A valid string is always parsed by `tinyutc_parse_iso8601_datetimen` and
+     * `tinyutc_parse_iso8601_to_unix` (the latter needs `TINYUTC_ISO8601_STRICT_SEPARATOR`).
+     *
+     * The canonical "YYYY-MM-DDTHH:MM:SS[.ffffff]Z" layout is checked a word at a time.
+     *
+     * @param[in] iso8601 String to check, not necessarily null-terminated.
+     * @param[in] len Number of characters of the datetime, all of them checked.
+     * @param[in] flags Combination of TINYUTC_ISO8601_STRICT_SEPARATOR, TINYUTC_ISO8601_REQUIRE_TIME
+     *                  and TINYUTC_ISO8601_REQUIRE_OFFSET, or 0.
+     * @return TINYUTC_ISO8601_OK if the datetime is valid, the error code of the first problem
+     *         found otherwise: TINYUTC_ISO8601_INVALID_TIME for a missing time, and
+     *         TINYUTC_ISO8601_INVALID_OFFSET for a missing offset.
+     */
+    err_t tinyutc_validate_iso8601_datetime(const char *iso8601, size_t len, uint32_t flags);
+
+    /**
+     * @brief Parses a buffer of delimiter-separated ISO 8601 datetimes to Unix timestamps.
+     *
+     * Each record is parsed as by `tinyutc_parse_iso8601_to_unix`, and has its own error code:
+     * an invalid record does not stop the parsing. Empty records give TINYUTC_ISO8601_EMPTY_STRING,
+     * and a '\r' ending a record is ignored when the delimiter is '\n'.
+     *
+     * Canonical records ("YYYY-MM-DDTHH:MM:SS[.ffffff]Z") go through the SWAR fast path of the
+     * parser, directly followed by their delimiter, which is not searched for. Records are still
+     * parsed one at a time: the SIMD kernels of `iso8601_simd.c`, an optional module, are not used.
+     *
+     * The last record of the buffer, when it is not followed by a delimiter, is left for the
+     * next chunk, unless `is_end_of_input` is set: the returned number of bytes consumed is
+     * where the next call should start.
+     *
+     * @param[out] unix_ts Array of at least `max_records` timestamps, 0 for invalid records.
+     * @param[out] micros Array of at least `max_records` microseconds, or NULL.
+     * @param[out] errors Array of at least `max_records` TinyUTCISO8601ErrorCode, or NULL.
+     * @param[in] max_records Maximum number of records to parse.
+     * @param[out] records Pointer to the number of records parsed, or NULL.
+     * @param[in] buffer Buffer of datetimes, not necessarily null-terminated.
+     * @param[in] len Number of characters available in `buffer`.
+     * @param[in] delimiter Character ending each record, e.g. '\n' or ','.
+     * @param[in] is_end_of_input true if no chunk follows this one.
+     * @return The number of bytes consumed, delimiters included.
+     */
+    size_t tinyutc_parse_iso8601_bulk(tinyutc_time_t *unix_ts, uint32_t *micros, err_t *errors, size_t max_records, size_t *records,
+                                      const char *buffer, size_t len, char delimiter, bool is_end_of_input);
+
+    /**
+     * @struct TinyUTCIsoStream
+     * @brief  Resumable ISO 8601 datetime parser, fed one character at a time.
+     *
+     * Parses the same datetimes as `tinyutc_parse_iso8601_datetime`, each one ended by a
+     * terminator character, without keeping the characters: the fields are accumulated as
+     * they arrive, with a bounded amount of work per character, so that it can be fed from
+     * an interrupt handler (e.g. a UART receiving GNSS or modem sentences).
+     *
+     * Initialize with `tinyutc_iso_stream_init`. Fields are not meant to be read or written
+     * by the user.
+     */
+    struct TinyUTCIsoStream
+    {
+        struct TinyUTCTime utc_tm; // Fields parsed so far
+        int32_t utc_offset;        // Offset parsed so far, in seconds, without its sign
+        uint32_t value;            // Number being parsed
+        uint8_t digits;            // Digits of `value`
+        uint8_t first;             // Week number, or the two digits after the year
+        uint8_t component;         // Time component being parsed, hours to seconds
+        uint8_t state;
+        uint8_t flags;
+        char terminator;
+        err_t error; // First error, reported with the terminator
+    };
+
+    /**
+     * @brief Initializes a stream, waiting for the first character of a datetime.
+     *
+     * @param[out] stream The stream to initialize.
+     * @param[in] terminator Character ending each datetime, e.g. '\n'. When it is '\n',
+     *                       a '\r' right before it is ignored.
+     * @param[in] use_strict_separator If true, requires strict use of 'T' as the date-time separator.
+     *                                 If false, allows any char as a valid separator.
+     */
+    void tinyutc_iso_stream_init(struct TinyUTCIsoStream *stream, char terminator, bool use_strict_separator);
+
+    /**
+     * @brief Feeds a character to a stream.
+     *
+     * After an error, characters are skipped up to the terminator, which reports it.
+     * The terminator also resets the stream for the next datetime.
+     *
+     * @param[in,out] stream The stream.
+     * @param[in] c The received character.
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure, only set when a datetime is parsed successfully.
+     * @return TINYUTC_ISO8601_IN_PROGRESS until the terminator, then the same error code
+     *         as `tinyutc_parse_iso8601_datetime` for the characters received before it.
+     */
+    err_t tinyutc_iso_feed(struct TinyUTCIsoStream *stream, char c, struct TinyUTCTime *utc_tm);
+
+    /**
+     * @brief Feeds a buffer to a stream, up to the first terminator.
+     *
+     * @param[in,out] stream The stream.
+     * @param[in] buffer Received characters.
+     * @param[in] len Number of characters available in `buffer`.
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure, only set when a datetime is parsed successfully.
+     * @param[out] result Pointer to the result of the last `tinyutc_iso_feed`, TINYUTC_ISO8601_IN_PROGRESS
+     *                    if no terminator was found.
+     * @return The number of characters consumed, the terminator included: the rest of the buffer
+     *         can be fed by another call.
+     */
+    size_t tinyutc_iso_feedn(struct TinyUTCIsoStream *stream, const char *buffer, size_t len, struct TinyUTCTime *utc_tm, err_t *result);
+
+#define _TINYUTC_ISO_LAYOUT_WORDS 4 // Up to 32 characters, "YYYY-MM-DDThh:mm:ss.ffffff+hh:mm"
+
+    /**
+     * @struct TinyUTCIsoLayout
+     * @brief  Layout of a datetime, learned by a `struct TinyUTCIsoContext`.
+     *
+     * Positions are counted from the start of the datetime, the year being at 0.
+     * Optional fields are at position 0 when absent.
+     */
+    struct TinyUTCIsoLayout
+    {
+        uint64_t digits[_TINYUTC_ISO_LAYOUT_WORDS];     // 0xFF on the digits, 8 characters per word
+        uint64_t separators[_TINYUTC_ISO_LAYOUT_WORDS]; // Expected characters outside the digits
+        uint8_t len;
+        uint8_t month;
+        uint8_t day;
+        uint8_t hour; // 0 for a date only
+        uint8_t minute;
+        uint8_t second;
+        uint8_t fraction;
+        uint8_t fraction_len;
+        uint8_t offset;        // Sign of a numeric offset
+        uint8_t offset_minute; // Minutes of a numeric offset
+    };
+
+    /**
+     * @struct TinyUTCIsoContext
+     * @brief  Parser context, specializing on the layout of the datetimes it parses.
+     *
+     * The first datetime goes through the generic parser, and its layout (basic or extended
+     * format, separator, fraction length, offset style) is learned. The next ones are parsed
+     * with fixed positions, as long as they have the same layout; any other datetime goes
+     * through the generic parser again, and its layout replaces the previous one.
+     *
+     * Week and ordinal dates, and reduced precision times, are not learned: they always go
+     * through the generic parser.
+     *
+     * The date of the last datetime parsed with the layout is cached too: the next datetime
+     * of the same day (the same date and separator characters, compared as two words) reuses
+     * its fields and day number, only the time being parsed.
+     *
+     * Initialize with `tinyutc_iso_context_init`. Fields are not meant to be written by
+     * the user, but the counters can be read (and reset) freely.
+     */
+    struct TinyUTCIsoContext
+    {
+        struct TinyUTCIsoLayout layout;
+        bool is_learned; // False until a layout is learned
+        bool use_strict_separator;
+        uint32_t hits;   // Datetimes parsed with the learned layout
+        uint32_t misses; // Datetimes parsed by the generic parser
+        uint64_t prefix[2]; // Date and separator characters of the cached day
+        int32_t days;       // Day number of the cached day, since 1970-01-01
+        uint16_t year;      // Date of the cached day
+        uint8_t month;
+        uint8_t day;
+        bool is_prefix_valid; // False until a date is cached
+        uint32_t prefix_hits; // Datetimes of the cached day
+    };
+
+    /**
+     * @brief Initializes a context, with no layout learned, no date cached and counters set to 0.
+     *
+     * @param[out] context The context to initialize.
+     * @param[in] use_strict_separator If true, requires strict use of 'T' as the date-time separator.
+     *                                 If false, allows any char as a valid separator.
+     */
+    void tinyutc_iso_context_init(struct TinyUTCIsoContext *context, bool use_strict_separator);
+
+    /**
+     * @brief Parses an ISO 8601 formatted datetime of known length, with the layout learned by the context.
+     *
+     * Results are the same as `tinyutc_parse_iso8601_datetimen` without `consumed`: the whole
+     * `len` characters must be a datetime.
+     *
+     * @param[in,out] context The context, learning the layout of the datetime if it is new.
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed values.
+     * @param[in] iso8601 String containing the ISO 8601 datetime to parse.
+     * @param[in] len Number of characters available in `iso8601`.
+     * @return err_t Error code indicating success or the type of parsing failure.
+     */
+    err_t tinyutc_iso_context_parse(struct TinyUTCIsoContext *context, struct TinyUTCTime *utc_tm, const char *iso8601, size_t len);
+
+    /**
+     * @brief Parses an ISO 8601 formatted datetime of known length straight to a Unix timestamp,
+     *        with the layout and the day learned by the context.
+     *
+     * Results are the same as `tinyutc_parse_iso8601_to_unix`, with the separator of the context:
+     * the timestamp of a datetime of the cached day is its day start plus its time of the day.
+     *
+     * @param[in,out] context The context, learning the layout of the datetime if it is new.
+     * @param[in] iso8601 String containing the ISO 8601 datetime to parse.
+     * @param[in] len Number of characters available in `iso8601`.
+     * @param[out] unix_ts Pointer to the Unix timestamp of the datetime, in UTC.
+     * @param[out] micros Pointer to the microseconds of the datetime, or NULL.
+     * @return err_t Error code indicating success or the type of parsing failure.
+     */
+    err_t tinyutc_iso_context_parse_to_unix(struct TinyUTCIsoContext *context, const char *iso8601, size_t len, tinyutc_time_t *unix_ts,
+                                            uint32_t *micros);
+
     /**
      * @brief Parses an ISO 8601 formatted date string into a TinyUTCTime structure.
      *
@@ -77,16 +336,15 @@ extern "C"
     err_t tinyutc_parse_iso8601_date(struct TinyUTCTime *utc_tm, const char *iso8601_date);
 
     /**
-     * @brief Parses an ISO 8601 formatted datetime string into a TinyUTCTime structure.
+     * @brief Parses an ISO 8601 formatted time string into a TinyUTCTime structure.
      *
-     * This function attempts to parse the provided ISO 8601 datetime string and populate
-     * the given TinyUTCTime structure with the corresponding date and time values.
+     * This function takes a string representing a time in ISO 8601 format (e.g., "12:34:56" or "12:34:56Z")
+     * and fills the provided TinyUTCTime structure with the corresponding time values.
      *
-     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed values.
-     * @param[in] iso8601 Null-terminated string containing the ISO 8601 datetime to parse.
-     * @param[in] use_strict_separator If true, requires strict use of 'T' as the date-time separator.
-     *                                 If false, allows any char as a valid separator.
-     * @return err_t Error code indicating success or the type of parsing failure.
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed time values.
+     * @param[in] iso8601_time Null-terminated string containing the ISO 8601 formatted time.
+     * @return err_t Error code indicating the result of the parsing operation.
+     *         Returns 0 on success, or a non-zero error code on failure (e.g., invalid format).
      */
     err_t tinyutc_parse_iso8601_time(struct TinyUTCTime *utc_tm, const char *iso8601_time);
 
@@ -0,0 +1,429 @@
+/**
+ * @file iso8601_simd.c
+ * @brief SIMD kernels for ISO 8601 datetime parsing.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "tinyutc.h"
+#include "iso8601_parser.h"
+#include "iso8601_simd.h"
+
+#if !defined(TINYUTC_NO_SIMD) && defined(__GNUC__) && defined(__SSE2__)
+#define _TINYUTC_SIMD_X86
+#include <immintrin.h>
+#define _TINYUTC_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if !defined(TINYUTC_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define _TINYUTC_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/**
+ * ISO 8601 datetime parsing kernels.
+ *
+ * The canonical layouts below are loaded in two 16 bytes halves, the first 16 characters
+ * and the last 16 ones (which may overlap, but never go past the end). Each half is checked
+ * against its pattern ('D' for a digit, 's' for the sign of the offset) with a few vector
+ * comparisons, then the digits are gathered with a shuffle and combined in pairs with a
+ * multiply-add. Anything else, including unusual values such as 24:00:00 or leap seconds,
+ * is left to `tinyutc_parse_iso8601_datetimen`, which gives the error codes.
+ */
+#define _TINYUTC_ISO8601_SKIP 0x80 // Shuffle index giving a zero
+
+struct _TinyUTCISO8601Layout
+{
+    char pattern[32];
+    uint8_t shuffle[32];
+    uint8_t length;
+    uint8_t sign_index;
+};
+
+/**
+ * Shuffles gather the digits in pairs:
+ *  - first half: year (two pairs), month, day, hour, minute
+ *  - last half: second, fraction (three pairs), offset hour, offset minute
+ */
+#define _TINYUTC_ISO8601_FIRST_HALF 0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP
+#define _TINYUTC_ISO8601_NO_FRACTION _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP
+#define _TINYUTC_ISO8601_NO_OFFSET _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP, _TINYUTC_ISO8601_SKIP
+
+enum _TinyUTCISO8601LayoutIndex
+{
+    _TINYUTC_ISO8601_ZULU,
+    _TINYUTC_ISO8601_FRACTION_ZULU,
+    _TINYUTC_ISO8601_OFFSET,
+    _TINYUTC_ISO8601_FRACTION_OFFSET,
+};
+
+static const struct _TinyUTCISO8601Layout _tinyutc_iso8601_layouts[] = {
+    [_TINYUTC_ISO8601_ZULU] = {
+        "DDDD-DD-DDTDD:DD"
+        "-DD-DDTDD:DD:DDZ",
+        {_TINYUTC_ISO8601_FIRST_HALF, 13, 14, _TINYUTC_ISO8601_NO_FRACTION, _TINYUTC_ISO8601_NO_OFFSET, _TINYUTC_ISO8601_NO_OFFSET},
+        20,
+        0,
+    },
+    [_TINYUTC_ISO8601_FRACTION_ZULU] = {
+        "DDDD-DD-DDTDD:DD"
+        "DD:DD:DD.DDDDDDZ",
+        {_TINYUTC_ISO8601_FIRST_HALF, 6, 7, 9, 10, 11, 12, 13, 14, _TINYUTC_ISO8601_NO_OFFSET, _TINYUTC_ISO8601_NO_OFFSET},
+        27,
+        0,
+    },
+    [_TINYUTC_ISO8601_OFFSET] = {
+        "DDDD-DD-DDTDD:DD"
+        "DTDD:DD:DDsDD:DD",
+        {_TINYUTC_ISO8601_FIRST_HALF, 8, 9, _TINYUTC_ISO8601_NO_FRACTION, 11, 12, 14, 15, _TINYUTC_ISO8601_NO_OFFSET},
+        25,
+        19,
+    },
+    [_TINYUTC_ISO8601_FRACTION_OFFSET] = {
+        "DDDD-DD-DDTDD:DD"
+        ":DD.DDDDDDsDD:DD",
+        {_TINYUTC_ISO8601_FIRST_HALF, 1, 2, 4, 5, 6, 7, 8, 9, 11, 12, 14, 15, _TINYUTC_ISO8601_NO_OFFSET},
+        32,
+        26,
+    },
+};
+
+typedef bool (*_tinyutc_iso8601_kernel_t)(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed);
+
+/**
+ * @brief Finds the canonical layout of a datetime from its terminators, if any.
+ *
+ * @return The layout, or NULL if the generic parser must be used.
+ */
+static const struct _TinyUTCISO8601Layout *_tinyutc_iso8601_layout(const char *iso8601, size_t len, size_t *consumed)
+{
+    const struct _TinyUTCISO8601Layout *layout;
+
+    if (len < 20)
+    {
+        return 0;
+    }
+
+    switch (iso8601[19])
+    {
+    case 'Z':
+        layout = &_tinyutc_iso8601_layouts[_TINYUTC_ISO8601_ZULU];
+        break;
+    case '+':
+    case '-':
+        layout = &_tinyutc_iso8601_layouts[_TINYUTC_ISO8601_OFFSET];
+        break;
+    case '.':
+        if (len < 27)
+        {
+            return 0;
+        }
+        if (iso8601[26] == 'Z')
+        {
+            layout = &_tinyutc_iso8601_layouts[_TINYUTC_ISO8601_FRACTION_ZULU];
+        }
+        else if (iso8601[26] == '+' || iso8601[26] == '-')
+        {
+            layout = &_tinyutc_iso8601_layouts[_TINYUTC_ISO8601_FRACTION_OFFSET];
+        }
+        else
+        {
+            return 0;
+        }
+        break;
+    default:
+        return 0;
+    }
+
+    // Without `consumed`, the whole string must be the datetime
+    if (len < layout->length || (consumed == 0 && len != layout->length))
+    {
+        return 0;
+    }
+    return layout;
+}
+
+/**
+ * @brief Checks the ranges of the fields and applies the offset, as the generic parser does.
+ *
+ * @param fields Digit pairs, see `_TINYUTC_ISO8601_FIRST_HALF`.
+ * @return true if the datetime was parsed, false to fall back on the generic parser.
+ */
+static bool _tinyutc_iso8601_finish(struct TinyUTCTime *utc_tm, const uint16_t fields[16], const struct _TinyUTCISO8601Layout *layout,
+                                    const char *iso8601, size_t *consumed)
+{
+    struct TinyUTCTime result = {
+        .year = (uint16_t)(fields[0] * 100 + fields[1]),
+        .month = (uint8_t)fields[2],
+        .day = (uint8_t)fields[3],
+        .hour = (uint8_t)fields[4],
+        .minute = (uint8_t)fields[5],
+        .second = (uint8_t)fields[8],
+        .microseconds = fields[9] * 10000UL + fields[10] * 100UL + fields[11]};
+    tinyutc_time_t unix_ts;
+    int utc_offset = 0;
+
+    if (result.month < 1 || result.month > 12 || result.day < 1 ||
+        result.day > _TINYUTC_GET_DAYS_IN_MONTH(result.month - 1, result.year) ||
+        result.hour > 23 || result.minute > 59 || result.second > 59)
+    {
+        return false;
+    }
+
+    if (layout->sign_index != 0)
+    {
+        if (fields[12] > 23 || fields[13] > 59)
+        {
+            return false;
+        }
+        utc_offset = (iso8601[layout->sign_index] == '-' ? -1 : 1) * (fields[12] * 3600 + fields[13] * 60);
+    }
+
+    if (tinyutc_utc_to_unix(&result, &unix_ts) < 0 ||
+        (utc_offset != 0 && tinyutc_unix_to_utc(&result, unix_ts - utc_offset) < 0))
+    {
+        return false;
+    }
+
+    *utc_tm = result;
+    if (consumed != 0)
+    {
+        *consumed = layout->length;
+    }
+    return true;
+}
+
+// Scalar kernel: the generic parser, with its own fast path for the canonical layouts
+static bool _tinyutc_scalar_iso8601(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed)
+{
+    (void)utc_tm;
+    (void)iso8601;
+    (void)len;
+    (void)consumed;
+    return false;
+}
+
+#ifdef _TINYUTC_SIMD_X86
+
+_TINYUTC_TARGET("sse4.1")
+static bool _tinyutc_sse41_iso8601(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed)
+{
+    const struct _TinyUTCISO8601Layout *layout = _tinyutc_iso8601_layout(iso8601, len, consumed);
+    uint16_t fields[16];
+
+    if (layout == 0)
+    {
+        return false;
+    }
+
+    for (int half = 0; half < 2; half++)
+    {
+        __m128i chars = _mm_loadu_si128((const __m128i *)(iso8601 + half * (layout->length - 16)));
+        __m128i pattern = _mm_loadu_si128((const __m128i *)(layout->pattern + 16 * half));
+        __m128i digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+        __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+        __m128i expects_digit = _mm_cmpeq_epi8(pattern, _mm_set1_epi8('D'));
+        __m128i matches = _mm_or_si128(_mm_cmpeq_epi8(chars, pattern), _mm_cmpeq_epi8(pattern, _mm_set1_epi8('s')));
+        __m128i valid = _mm_or_si128(_mm_and_si128(is_digit, expects_digit), _mm_andnot_si128(expects_digit, matches));
+
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+        {
+            return false;
+        }
+
+        __m128i gathered = _mm_shuffle_epi8(digits, _mm_loadu_si128((const __m128i *)(layout->shuffle + 16 * half)));
+        _mm_storeu_si128((__m128i *)(fields + 8 * half), _mm_maddubs_epi16(gathered, _mm_set1_epi16(0x010A)));
+    }
+
+    return _tinyutc_iso8601_finish(utc_tm, fields, layout, iso8601, consumed);
+}
+
+_TINYUTC_TARGET("avx2")
+static bool _tinyutc_avx2_iso8601(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed)
+{
+    const struct _TinyUTCISO8601Layout *layout = _tinyutc_iso8601_layout(iso8601, len, consumed);
+    uint16_t fields[16];
+
+    if (layout == 0)
+    {
+        return false;
+    }
+
+    __m256i chars = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)iso8601)),
+                                            _mm_loadu_si128((const __m128i *)(iso8601 + layout->length - 16)), 1);
+    __m256i pattern = _mm256_loadu_si256((const __m256i *)layout->pattern);
+    __m256i digits = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digits, _mm256_set1_epi8(9)), digits);
+    __m256i expects_digit = _mm256_cmpeq_epi8(pattern, _mm256_set1_epi8('D'));
+    __m256i matches = _mm256_or_si256(_mm256_cmpeq_epi8(chars, pattern), _mm256_cmpeq_epi8(pattern, _mm256_set1_epi8('s')));
+    __m256i valid = _mm256_or_si256(_mm256_and_si256(is_digit, expects_digit), _mm256_andnot_si256(expects_digit, matches));
+
+    if (_mm256_movemask_epi8(valid) != -1)
+    {
+        return false;
+    }
+
+    // The shuffle works within each 16 bytes half, as the gathering does
+    __m256i gathered = _mm256_shuffle_epi8(digits, _mm256_loadu_si256((const __m256i *)layout->shuffle));
+    _mm256_storeu_si256((__m256i *)fields, _mm256_maddubs_epi16(gathered, _mm256_set1_epi16(0x010A)));
+
+    return _tinyutc_iso8601_finish(utc_tm, fields, layout, iso8601, consumed);
+}
+
+#endif // _TINYUTC_SIMD_X86
+
+#ifdef _TINYUTC_SIMD_NEON
+
+static bool _tinyutc_neon_iso8601(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed)
+{
+    const struct _TinyUTCISO8601Layout *layout = _tinyutc_iso8601_layout(iso8601, len, consumed);
+    uint16_t fields[16];
+
+    if (layout == 0)
+    {
+        return false;
+    }
+
+    for (int half = 0; half < 2; half++)
+    {
+        uint8x16_t chars = vld1q_u8((const uint8_t *)iso8601 + half * (layout->length - 16));
+        uint8x16_t pattern = vld1q_u8((const uint8_t *)layout->pattern + 16 * half);
+        uint8x16_t digits = vsubq_u8(chars, vdupq_n_u8('0'));
+        uint8x16_t is_digit = vcleq_u8(digits, vdupq_n_u8(9));
+        uint8x16_t expects_digit = vceqq_u8(pattern, vdupq_n_u8('D'));
+        uint8x16_t matches = vorrq_u8(vceqq_u8(chars, pattern), vceqq_u8(pattern, vdupq_n_u8('s')));
+        uint8x16_t valid = vorrq_u8(vandq_u8(is_digit, expects_digit), vbicq_u8(matches, expects_digit));
+
+        if (vminvq_u8(valid) != 0xFF)
+        {
+            return false;
+        }
+
+        // Indexes out of the table give a zero, each pair is then 10 * low byte + high byte
+        uint16x8_t gathered = vreinterpretq_u16_u8(vqtbl1q_u8(digits, vld1q_u8(layout->shuffle + 16 * half)));
+        vst1q_u16(fields + 8 * half, vmlaq_n_u16(vshrq_n_u16(gathered, 8), vandq_u16(gathered, vdupq_n_u16(0xFF)), 10));
+    }
+
+    return _tinyutc_iso8601_finish(utc_tm, fields, layout, iso8601, consumed);
+}
+
+#endif // _TINYUTC_SIMD_NEON
+
+static _tinyutc_iso8601_kernel_t _tinyutc_get_iso8601_kernel_function(enum TinyUTCSimdKernel kernel)
+{
+    switch (kernel)
+    {
+    case TINYUTC_SIMD_SCALAR:
+        return _tinyutc_scalar_iso8601;
+#ifdef _TINYUTC_SIMD_X86
+    case TINYUTC_SIMD_SSE41:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.1") ? _tinyutc_sse41_iso8601 : 0;
+    case TINYUTC_SIMD_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? _tinyutc_avx2_iso8601 : 0;
+#endif
+#ifdef _TINYUTC_SIMD_NEON
+    case TINYUTC_SIMD_NEON:
+        return _tinyutc_neon_iso8601;
+#endif
+    default:
+        return 0;
+    }
+}
+
+static _Atomic(_tinyutc_iso8601_kernel_t) _tinyutc_iso8601_kernel_function = 0;
+
+// The kernel in use, detected on first use
+static _tinyutc_iso8601_kernel_t _tinyutc_load_iso8601_kernel(void)
+{
+    _tinyutc_iso8601_kernel_t function = atomic_load_explicit(&_tinyutc_iso8601_kernel_function, memory_order_relaxed);
+
+    if (function == 0)
+    {
+        // From the best to the worst
+        static const enum TinyUTCSimdKernel candidates[] = {TINYUTC_SIMD_AVX2, TINYUTC_SIMD_SSE41, TINYUTC_SIMD_NEON};
+
+        for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]) && function == 0; i++)
+        {
+            function = _tinyutc_get_iso8601_kernel_function(candidates[i]);
+        }
+        if (function == 0)
+        {
+            function = _tinyutc_scalar_iso8601;
+        }
+        atomic_store_explicit(&_tinyutc_iso8601_kernel_function, function, memory_order_relaxed);
+    }
+
+    return function;
+}
+
+err_t tinyutc_simd_set_iso8601_kernel(enum TinyUTCSimdKernel kernel)
+{
+    _tinyutc_iso8601_kernel_t function = _tinyutc_get_iso8601_kernel_function(kernel);
+
+    if (function == 0)
+    {
+        return -1; // Not available
+    }
+
+    atomic_store_explicit(&_tinyutc_iso8601_kernel_function, function, memory_order_relaxed);
+
+    return 0;
+}
+
+enum TinyUTCSimdKernel tinyutc_simd_get_iso8601_kernel(void)
+{
+    _tinyutc_iso8601_kernel_t function = _tinyutc_load_iso8601_kernel();
+
+    // Found back from the function, each kernel having its own
+    for (int kernel = TINYUTC_SIMD_SCALAR; kernel <= TINYUTC_SIMD_SSE41; kernel++)
+    {
+        if (_tinyutc_get_iso8601_kernel_function((enum TinyUTCSimdKernel)kernel) == function)
+        {
+            return (enum TinyUTCSimdKernel)kernel;
+        }
+    }
+
+    return TINYUTC_SIMD_SCALAR;
+}
+
+err_t tinyutc_simd_parse_iso8601_datetimen(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed,
+                                           bool use_strict_separator)
+{
+    if (iso8601 != 0 && _tinyutc_load_iso8601_kernel()(utc_tm, iso8601, len, consumed))
+    {
+        return TINYUTC_ISO8601_OK;
+    }
+
+    return tinyutc_parse_iso8601_datetimen(utc_tm, iso8601, len, consumed, use_strict_separator);
+}
+
+err_t tinyutc_simd_parse_iso8601_datetime(struct TinyUTCTime *utc_tm, const char *iso8601, bool use_strict_separator)
+{
+    size_t len = 0;
+
+    if (iso8601 == 0)
+    {
+        return tinyutc_parse_iso8601_datetime(utc_tm, iso8601, use_strict_separator);
+    }
+
+    while (iso8601[len] != '\0')
+    {
+        len++;
+    }
+
+    return tinyutc_simd_parse_iso8601_datetimen(utc_tm, iso8601, len, 0, use_strict_separator);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file iso8601_simd.h
+ * @brief SIMD kernels for ISO 8601 datetime parsing.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Kernels are written with SSE4.1 and AVX2 intrinsics on x86 (selected at runtime
+ * depending on the CPU), and NEON intrinsics on AArch64, for any `tinyutc_time_t`.
+ * Anything else, or a build with `TINYUTC_NO_SIMD`, uses `iso8601_parser.c`, which
+ * must be linked too. Kernels are selected with `enum TinyUTCSimdKernel`, from
+ * `tinyutc_simd.h`, but `tinyutc_simd.c` does not need to be linked. The kernel
+ * is detected on first use, and kept in an atomic, so any thread can parse (or
+ * change the kernel) at any time.
+ */
+
+#ifndef ISO8601_SIMD_H
+#define ISO8601_SIMD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "tinyutc.h"
+#include "tinyutc_simd.h"
+#include "iso8601_parser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @brief Parses an ISO 8601 datetime out of a string of known length, using the best
+     *        kernel available on the running CPU.
+     *
+     * The canonical layouts ("YYYY-MM-DDTHH:MM:SS", with an optional ".ffffff" fraction,
+     * then 'Z' or a "+hh:mm" offset) are parsed in a vector register. Results and error
+     * codes are the same as `tinyutc_parse_iso8601_datetimen`, which is used for anything else.
+     *
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed values.
+     * @param[in] iso8601 String containing the ISO 8601 datetime to parse.
+     * @param[in] len Number of characters available in `iso8601`.
+     * @param[out] consumed Pointer to the number of characters parsed, or NULL.
+     * @param[in] use_strict_separator If true, requires strict use of 'T' as the date-time separator.
+     * @return err_t Error code indicating success or the type of parsing failure.
+     */
+    err_t tinyutc_simd_parse_iso8601_datetimen(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed,
+                                               bool use_strict_separator);
+
+    /**
+     * @brief Null-terminated version of `tinyutc_simd_parse_iso8601_datetimen`.
+     *
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure to be filled with parsed values.
+     * @param[in] iso8601 Null-terminated string containing the ISO 8601 datetime to parse.
+     * @param[in] use_strict_separator If true, requires strict use of 'T' as the date-time separator.
+     * @return err_t Error code indicating success or the type of parsing failure.
+     */
+    err_t tinyutc_simd_parse_iso8601_datetime(struct TinyUTCTime *utc_tm, const char *iso8601, bool use_strict_separator);
+
+    /**
+     * @brief Returns the kernel used by `tinyutc_simd_parse_iso8601_datetimen`.
+     *
+     * The first call detects the best kernel supported by the running CPU.
+     *
+     * @return enum TinyUTCSimdKernel The kernel in use.
+     */
+    enum TinyUTCSimdKernel tinyutc_simd_get_iso8601_kernel(void);
+
+    /**
+     * @brief Forces the kernel used by `tinyutc_simd_parse_iso8601_datetimen`.
+     *
+     * Available kernels are TINYUTC_SIMD_SCALAR, TINYUTC_SIMD_SSE41, TINYUTC_SIMD_AVX2 and
+     * TINYUTC_SIMD_NEON, depending on the build and the CPU.
+     *
+     * @param[in] kernel The kernel to use.
+     * @return err_t 0 on success, -1 if the kernel is not available on this build or CPU
+     *         (the kernel in use is then left unchanged).
+     */
+    err_t tinyutc_simd_set_iso8601_kernel(enum TinyUTCSimdKernel kernel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ISO8601_SIMD_H
@@ -0,0 +1,104 @@
+/**
+ * @file bench_batch.c
+ * @brief Throughput benchmark of the Unix timestamp to UTC time batch conversions.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Compares the scalar conversion, the auto-vectorized batch conversions and the
+ * SIMD kernels available on the running CPU. Build with optimizations, e.g.
+ * `gcc -O3 bench_batch.c ../tinyutc_simd.c -o bench_batch`.
+ * Throughput is given in input bytes (timestamps) per second.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../tinyutc.h"
+#include "../tinyutc_simd.h"
+
+#define BENCH_BATCH_SIZE 4096
+#define BENCH_ROUNDS 5000
+
+static tinyutc_time_t timestamps[BENCH_BATCH_SIZE];
+static struct TinyUTCTime times[BENCH_BATCH_SIZE];
+
+static uint16_t years[BENCH_BATCH_SIZE];
+static uint8_t months[BENCH_BATCH_SIZE], days[BENCH_BATCH_SIZE], hours[BENCH_BATCH_SIZE], minutes[BENCH_BATCH_SIZE], seconds[BENCH_BATCH_SIZE];
+
+static void print_result(const char *name, clock_t begin, clock_t end)
+{
+    double seconds = (double)(end - begin) / CLOCKS_PER_SEC;
+    double count = (double)BENCH_BATCH_SIZE * BENCH_ROUNDS;
+
+    printf("%-28s : %7.2f ms per million timestamps, %6.2f GB/s\n", name,
+           seconds * 1e3 * 1e6 / count, count * sizeof(tinyutc_time_t) / seconds / 1e9);
+}
+
+int main()
+{
+    struct TinyUTCColumns columns = {years, months, days, hours, minutes, seconds};
+    clock_t begin, end;
+
+    for (int i = 0; i < BENCH_BATCH_SIZE; i++)
+    {
+        timestamps[i] = ((tinyutc_time_t)rand() << 16) ^ (tinyutc_time_t)rand();
+    }
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_BATCH_SIZE; i++)
+        {
+            tinyutc_unix_to_utc(&times[i], timestamps[i]);
+        }
+    }
+    end = clock();
+    print_result("Scalar tinyutc_unix_to_utc", begin, end);
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        tinyutc_unix_to_utc_batch(times, timestamps, BENCH_BATCH_SIZE);
+    }
+    end = clock();
+    print_result("Batch, structures", begin, end);
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        tinyutc_unix_to_utc_batch_columns(&columns, timestamps, BENCH_BATCH_SIZE);
+    }
+    end = clock();
+    print_result("Batch, columns", begin, end);
+
+    const enum TinyUTCSimdKernel kernels[] = {TINYUTC_SIMD_SCALAR, TINYUTC_SIMD_SSE2, TINYUTC_SIMD_AVX2, TINYUTC_SIMD_AVX512, TINYUTC_SIMD_NEON};
+    const char *kernel_names[] = {"SIMD, scalar kernel", "SIMD, SSE2 kernel", "SIMD, AVX2 kernel", "SIMD, AVX-512 kernel", "SIMD, NEON kernel"};
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+        if (tinyutc_simd_set_kernel(kernels[k]) != 0)
+        {
+            continue;
+        }
+
+        begin = clock();
+        for (int round = 0; round < BENCH_ROUNDS; round++)
+        {
+            tinyutc_simd_unix_to_utc_columns(&columns, timestamps, BENCH_BATCH_SIZE);
+        }
+        end = clock();
+        print_result(kernel_names[k], begin, end);
+    }
+
+    return 0;
+}
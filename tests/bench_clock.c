@@ -0,0 +1,163 @@
+/**
+ * @file bench_clock.c
+ * @brief Contention benchmark of the cached clock, against converting in each thread and a mutex.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * An updater thread publishes the current time every millisecond, while 1 to 8
+ * reader threads get the current time as a structure and an ISO 8601 datetime:
+ * by converting and formatting it themselves, by copying a slot protected by a
+ * mutex, or by reading the cached clock. Build with optimizations, e.g.
+ * `gcc -O2 -pthread bench_clock.c ../tinyutc_clock.c ../iso8601_formatter.c ../http_date.c -o bench_clock`.
+ */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../iso8601_formatter.h"
+#include "../tinyutc.h"
+#include "../tinyutc_clock.h"
+
+#define BENCH_READS 2000000
+#define MAX_READERS 8
+#define FLAGS (TINYUTC_FORMAT_MILLISECONDS | TINYUTC_FORMAT_ZULU)
+
+enum Method
+{
+    CONVERT,
+    MUTEX,
+    CACHED_CLOCK,
+};
+
+static struct TinyUTCClock cached_clock;
+static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct TinyUTCClockTime mutex_slot;
+static _Atomic(tinyutc_time_t) current_ts;
+static _Atomic(uint32_t) current_micros;
+static atomic_bool is_running;
+static atomic_uint sink;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void publish(tinyutc_time_t unix_ts, uint32_t micros)
+{
+    struct TinyUTCClockTime time;
+
+    atomic_store(&current_ts, unix_ts);
+    atomic_store(&current_micros, micros);
+    tinyutc_clock_update(&cached_clock, unix_ts, micros);
+
+    tinyutc_clock_read(&cached_clock, &time);
+    pthread_mutex_lock(&mutex);
+    mutex_slot = time;
+    pthread_mutex_unlock(&mutex);
+}
+
+static void *updater(void *arg)
+{
+    const struct timespec period = {0, 1000000};
+    tinyutc_time_t unix_ts = 1700000000;
+    uint32_t micros = 0;
+
+    (void)arg;
+    while (atomic_load(&is_running))
+    {
+        nanosleep(&period, 0);
+        micros += 1000;
+        if (micros == 1000000)
+        {
+            micros = 0;
+            unix_ts++;
+        }
+        publish(unix_ts, micros);
+    }
+    return 0;
+}
+
+static void *reader(void *arg)
+{
+    enum Method method = *(enum Method *)arg;
+    struct TinyUTCClockTime time;
+    unsigned local_sink = 0;
+
+    for (int i = 0; i < BENCH_READS; i++)
+    {
+        switch (method)
+        {
+        case CONVERT:
+            time.unix_ts = atomic_load_explicit(&current_ts, memory_order_relaxed);
+            tinyutc_unix_to_utc(&time.utc, time.unix_ts);
+            time.utc.microseconds = atomic_load_explicit(&current_micros, memory_order_relaxed);
+            time.iso_len = (uint8_t)tinyutc_format_iso8601(&time.utc, time.iso, sizeof(time.iso), FLAGS);
+            break;
+        case MUTEX:
+            pthread_mutex_lock(&mutex);
+            time = mutex_slot;
+            pthread_mutex_unlock(&mutex);
+            break;
+        case CACHED_CLOCK:
+            tinyutc_clock_read(&cached_clock, &time);
+            break;
+        }
+        local_sink += time.iso[time.iso_len - 2] + time.utc.second;
+    }
+
+    atomic_fetch_add(&sink, local_sink);
+    return 0;
+}
+
+static double run(enum Method method, int readers_count)
+{
+    pthread_t readers[MAX_READERS];
+    double begin = now_ns();
+
+    for (int i = 0; i < readers_count; i++)
+    {
+        pthread_create(&readers[i], 0, reader, &method);
+    }
+    for (int i = 0; i < readers_count; i++)
+    {
+        pthread_join(readers[i], 0);
+    }
+
+    return (now_ns() - begin) / ((double)BENCH_READS * readers_count);
+}
+
+int main()
+{
+    const char *names[] = {"Convert in each thread", "Mutex", "Cached clock"};
+    pthread_t updater_thread;
+
+    tinyutc_clock_init(&cached_clock, 0, FLAGS);
+    publish(1700000000, 0);
+    atomic_store(&is_running, true);
+    pthread_create(&updater_thread, 0, updater, 0);
+
+    for (int readers_count = 1; readers_count <= MAX_READERS; readers_count *= 2)
+    {
+        for (int method = CONVERT; method <= CACHED_CLOCK; method++)
+        {
+            printf("%-24s %d readers : %6.2f ns per read\n", names[method], readers_count,
+                   run((enum Method)method, readers_count));
+        }
+    }
+
+    atomic_store(&is_running, false);
+    pthread_join(updater_thread, 0);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file bench_http_date.c
+ * @brief Latency benchmark of the HTTP-date parser and formatter, against glibc.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Random IMF-fixdates are parsed to timestamps with `strptime` and `timegm`, then
+ * with `tinyutc_parse_http_date_to_unix`, and timestamps are formatted with `gmtime_r`
+ * and `strftime`, then with `tinyutc_format_unix_http_date`. Build with optimizations,
+ * e.g. `gcc -O2 bench_http_date.c ../http_date.c -o bench_http_date`.
+ */
+
+#define _GNU_SOURCE // strptime, timegm
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../http_date.h"
+#include "../tinyutc.h"
+
+#define BENCH_DATES 4096
+#define BENCH_ROUNDS 200
+#define IMF_FIXDATE "%a, %d %b %Y %H:%M:%S GMT"
+
+static tinyutc_time_t timestamps[BENCH_DATES];
+static char dates[BENCH_DATES][TINYUTC_HTTP_DATE_SIZE];
+
+static double per_date(clock_t begin, clock_t end)
+{
+    return (double)(end - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_DATES * BENCH_ROUNDS);
+}
+
+int main()
+{
+    volatile uint64_t sink = 0;
+    clock_t begin, end;
+    struct tm tm;
+
+    srand(1994);
+    for (int i = 0; i < BENCH_DATES; i++)
+    {
+        timestamps[i] = (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()) & 0x7FFFFFFF;
+        tinyutc_format_unix_http_date(timestamps[i], dates[i], sizeof(dates[i]));
+    }
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            strptime(dates[i], IMF_FIXDATE, &tm);
+            sink += (uint64_t)timegm(&tm);
+        }
+    }
+    end = clock();
+    printf("%-32s : %6.2f ns per date\n", "Parse, strptime + timegm", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            tinyutc_time_t unix_ts;
+            tinyutc_parse_http_date_to_unix(dates[i], TINYUTC_HTTP_DATE_SIZE - 1, &unix_ts);
+            sink += (uint64_t)unix_ts;
+        }
+    }
+    end = clock();
+    printf("%-32s : %6.2f ns per date\n", "Parse, TinyUTC", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            time_t t = (time_t)timestamps[i];
+            gmtime_r(&t, &tm);
+            sink += strftime(dates[i], sizeof(dates[i]), IMF_FIXDATE, &tm);
+        }
+    }
+    end = clock();
+    printf("%-32s : %6.2f ns per date\n", "Format, gmtime_r + strftime", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            sink += tinyutc_format_unix_http_date(timestamps[i], dates[i], sizeof(dates[i]));
+        }
+    }
+    end = clock();
+    printf("%-32s : %6.2f ns per date\n", "Format, TinyUTC", per_date(begin, end));
+
+    return 0;
+}
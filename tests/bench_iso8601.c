@@ -0,0 +1,284 @@
+/**
+ * @file bench_iso8601.c
+ * @brief Latency benchmark of the ISO8601 datetime parser, canonical and generic layouts.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * The canonical "YYYY-MM-DDTHH:MM:SS[.ffffff]Z" layouts take the fast path, the other
+ * ones the generic parser, or the layout learned by a context. The SIMD kernels available on the running CPU are then
+ * compared on the canonical layouts. Build with optimizations, e.g.
+ * `gcc -O2 bench_iso8601.c ../iso8601_parser.c ../iso8601_simd.c -o bench_iso8601`.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../iso8601_parser.h"
+#include "../iso8601_simd.h"
+#include "../tinyutc.h"
+
+#define BENCH_STRINGS 1024
+#define BENCH_ROUNDS 2000
+
+static char strings[BENCH_STRINGS][40];
+static size_t lengths[BENCH_STRINGS];
+
+// Formats random datetimes in the given layout, with the fields in this order
+static void generate(const char *format)
+{
+    for (int i = 0; i < BENCH_STRINGS; i++)
+    {
+        lengths[i] = sprintf(strings[i], format, 1970 + rand() % 130, 1 + rand() % 12, 1 + rand() % 28,
+                             rand() % 24, rand() % 60, rand() % 60, rand() % 1000000);
+    }
+}
+
+typedef err_t (*parse_function_t)(struct TinyUTCTime *utc_tm, const char *iso8601, size_t len, size_t *consumed, bool use_strict_separator);
+
+static void bench(const char *name, const char *format, parse_function_t parse)
+{
+    struct TinyUTCTime utc_tm = {0};
+    volatile uint32_t sink = 0;
+    int errors = 0;
+    clock_t begin, end;
+
+    generate(format);
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            errors += parse(&utc_tm, strings[i], lengths[i], NULL, true) != TINYUTC_ISO8601_OK;
+            sink += utc_tm.second;
+        }
+    }
+    end = clock();
+
+    printf("%-36s '%s' : %6.2f ns per parse (%d errors)\n", name, strings[0],
+           (double)(end - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS), errors);
+}
+
+// Same datetimes, parsed to a timestamp, through the structure and straight
+static void bench_to_unix(const char *name, const char *format)
+{
+    struct TinyUTCTime utc_tm = {0};
+    tinyutc_time_t unix_ts = 0;
+    uint32_t micros = 0;
+    volatile tinyutc_time_t sink = 0;
+    clock_t begin, middle, end;
+
+    generate(format);
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            tinyutc_parse_iso8601_datetime(&utc_tm, strings[i], true);
+            tinyutc_utc_to_unix(&utc_tm, &unix_ts);
+            sink += unix_ts;
+        }
+    }
+    middle = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            tinyutc_parse_iso8601_to_unix(strings[i], &unix_ts, &micros);
+            sink += unix_ts;
+        }
+    }
+    end = clock();
+
+    printf("%-36s '%s' : %6.2f ns through the structure, %6.2f ns straight\n", name, strings[0],
+           (double)(middle - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS),
+           (double)(end - middle) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS));
+}
+
+// Same datetimes, parsed with a context learning their layout
+static void bench_context(const char *name, const char *format)
+{
+    struct TinyUTCIsoContext context;
+    struct TinyUTCTime utc_tm = {0};
+    volatile uint32_t sink = 0;
+    clock_t begin, end;
+
+    generate(format);
+    tinyutc_iso_context_init(&context, true);
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            tinyutc_iso_context_parse(&context, &utc_tm, strings[i], lengths[i]);
+            sink += utc_tm.second;
+        }
+    }
+    end = clock();
+
+    printf("%-36s '%s' : %6.2f ns per parse (%u misses)\n", name, strings[0],
+           (double)(end - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS), context.misses);
+}
+
+// Increasing datetimes of a same day, parsed to timestamps with a context reusing the date
+static void bench_same_day(const char *name, const char *format)
+{
+    struct TinyUTCIsoContext context;
+    tinyutc_time_t unix_ts = 0;
+    volatile tinyutc_time_t sink = 0;
+    clock_t begin, middle, end;
+
+    for (int i = 0; i < BENCH_STRINGS; i++)
+    {
+        lengths[i] = sprintf(strings[i], format, 2025, 5, 20, i * 84 / 3600, i * 84 / 60 % 60, i * 84 % 60, rand() % 1000000);
+    }
+    tinyutc_iso_context_init(&context, true);
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            tinyutc_parse_iso8601_to_unix(strings[i], &unix_ts, NULL);
+            sink += unix_ts;
+        }
+    }
+    middle = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            tinyutc_iso_context_parse_to_unix(&context, strings[i], lengths[i], &unix_ts, NULL);
+            sink += unix_ts;
+        }
+    }
+    end = clock();
+
+    printf("%-36s '%s' : %6.2f ns generic, %6.2f ns with the context\n", name, strings[0],
+           (double)(middle - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS),
+           (double)(end - middle) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS));
+}
+
+// Same datetimes, one per line, parsed in bulk
+static void bench_bulk(const char *name, const char *format)
+{
+    static char buffer[BENCH_STRINGS * 41];
+    static tinyutc_time_t timestamps[BENCH_STRINGS];
+    static err_t errors[BENCH_STRINGS];
+    volatile size_t sink = 0;
+    size_t len = 0;
+    clock_t begin, end;
+
+    generate(format);
+    for (int i = 0; i < BENCH_STRINGS; i++)
+    {
+        len += sprintf(buffer + len, "%s\n", strings[i]);
+    }
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        sink += tinyutc_parse_iso8601_bulk(timestamps, 0, errors, BENCH_STRINGS, 0, buffer, len, '\n', true);
+    }
+    end = clock();
+
+    printf("%-36s '%s' : %6.2f ns per record\n", name, strings[0],
+           (double)(end - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS));
+}
+
+// Same datetimes, checked without any output, then parsed
+static void bench_validate(const char *name, const char *format)
+{
+    struct TinyUTCTime utc_tm = {0};
+    volatile uint32_t sink = 0;
+    int errors = 0;
+    clock_t begin, middle, end;
+
+    generate(format);
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            errors += tinyutc_validate_iso8601_datetime(strings[i], lengths[i], TINYUTC_ISO8601_STRICT_SEPARATOR) != TINYUTC_ISO8601_OK;
+        }
+    }
+    middle = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_STRINGS; i++)
+        {
+            tinyutc_parse_iso8601_datetimen(&utc_tm, strings[i], lengths[i], NULL, true);
+            sink += utc_tm.second;
+        }
+    }
+    end = clock();
+
+    printf("%-36s '%s' : %6.2f ns per check, %6.2f ns per parse (%d errors)\n", name, strings[0],
+           (double)(middle - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS),
+           (double)(end - middle) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_STRINGS * BENCH_ROUNDS), errors);
+}
+
+int main()
+{
+    srand(1970);
+
+    bench("Canonical, fast path", "%04d-%02d-%02dT%02d:%02d:%02dZ", tinyutc_parse_iso8601_datetimen);
+    bench("Canonical with fraction, fast path", "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ", tinyutc_parse_iso8601_datetimen);
+    bench("Offset, generic", "%04d-%02d-%02dT%02d:%02d:%02d+00:00", tinyutc_parse_iso8601_datetimen);
+    bench("Fraction with offset, generic", "%04d-%02d-%02dT%02d:%02d:%02d.%06d+00:00", tinyutc_parse_iso8601_datetimen);
+    bench("Basic format, generic", "%04d%02d%02dT%02d%02d%02dZ", tinyutc_parse_iso8601_datetimen);
+
+    bench_to_unix("Canonical to timestamp", "%04d-%02d-%02dT%02d:%02d:%02dZ");
+    bench_to_unix("Offset to timestamp", "%04d-%02d-%02dT%02d:%02d:%02d+01:00");
+    bench_to_unix("Fraction with offset to timestamp", "%04d-%02d-%02dT%02d:%02d:%02d.%06d-05:30");
+
+    bench_context("Offset, context", "%04d-%02d-%02dT%02d:%02d:%02d+00:00");
+    bench_context("Fraction with offset, context", "%04d-%02d-%02dT%02d:%02d:%02d.%06d+00:00");
+    bench_context("Basic format, context", "%04d%02d%02dT%02d%02d%02dZ");
+
+    bench_same_day("Same day to timestamp", "%04d-%02d-%02dT%02d:%02d:%02d.%06d+01:00");
+    bench_same_day("Same day basic format to timestamp", "%04d%02d%02dT%02d%02d%02dZ");
+
+    bench_bulk("Canonical lines, bulk", "%04d-%02d-%02dT%02d:%02d:%02dZ");
+    bench_bulk("Canonical lines with fraction, bulk", "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ");
+
+    bench_validate("Canonical, validation", "%04d-%02d-%02dT%02d:%02d:%02dZ");
+    bench_validate("Fraction with offset, validation", "%04d-%02d-%02dT%02d:%02d:%02d.%06d+01:00");
+    bench_validate("Basic format, validation", "%04d%02d%02dT%02d%02d%02dZ");
+
+    const enum TinyUTCSimdKernel kernels[] = {TINYUTC_SIMD_SSE41, TINYUTC_SIMD_AVX2, TINYUTC_SIMD_NEON};
+    const char *kernel_names[] = {"SSE4.1", "AVX2", "NEON"};
+    char name[64];
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+        if (tinyutc_simd_set_iso8601_kernel(kernels[k]) != 0)
+        {
+            continue;
+        }
+
+        sprintf(name, "Canonical, %s", kernel_names[k]);
+        bench(name, "%04d-%02d-%02dT%02d:%02d:%02dZ", tinyutc_simd_parse_iso8601_datetimen);
+        sprintf(name, "Canonical with fraction, %s", kernel_names[k]);
+        bench(name, "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ", tinyutc_simd_parse_iso8601_datetimen);
+        sprintf(name, "Fraction with offset, %s", kernel_names[k]);
+        bench(name, "%04d-%02d-%02dT%02d:%02d:%02d.%06d+00:00", tinyutc_simd_parse_iso8601_datetimen);
+    }
+
+    return 0;
+}
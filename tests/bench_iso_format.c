@@ -0,0 +1,116 @@
+/**
+ * @file bench_iso_format.c
+ * @brief Latency benchmark of the ISO8601 formatter, against snprintf.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Increasing timestamps, a few hundred milliseconds apart as in a log, are formatted
+ * with `snprintf` after a conversion, one by one, in batch, and through a format cache. Build with
+ * optimizations, e.g. `gcc -O2 bench_iso_format.c ../iso8601_formatter.c -o bench_iso_format`.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../iso8601_formatter.h"
+#include "../tinyutc.h"
+
+#define BENCH_RECORDS 4096
+#define BENCH_ROUNDS 500
+
+static tinyutc_time_t timestamps[BENCH_RECORDS];
+static uint32_t micros[BENCH_RECORDS];
+static char records[BENCH_RECORDS][TINYUTC_FORMAT_MAX_SIZE];
+
+static double per_record(clock_t begin, clock_t end)
+{
+    return (double)(end - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_RECORDS * BENCH_ROUNDS);
+}
+
+int main()
+{
+    const uint32_t flags = TINYUTC_FORMAT_MICROSECONDS | TINYUTC_FORMAT_ZULU;
+    struct TinyUTCTime utc_tm;
+    volatile uint32_t sink = 0;
+    clock_t begin, end;
+
+    srand(1970);
+    timestamps[0] = 1700000000;
+    for (int i = 1; i < BENCH_RECORDS; i++)
+    {
+        timestamps[i] = timestamps[i - 1] + rand() % 2;
+        micros[i] = rand() % 1000000;
+    }
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_RECORDS; i++)
+        {
+            tinyutc_unix_to_utc(&utc_tm, timestamps[i]);
+            snprintf(records[i], sizeof(records[i]), "%04u-%02u-%02uT%02u:%02u:%02u.%06uZ", utc_tm.year, utc_tm.month, utc_tm.day,
+                     utc_tm.hour, utc_tm.minute, utc_tm.second, micros[i]);
+            sink += records[i][18];
+        }
+    }
+    end = clock();
+    printf("%-24s '%s' : %6.2f ns per record\n", "snprintf", records[0], per_record(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_RECORDS; i++)
+        {
+            sink += tinyutc_format_unix_iso8601(timestamps[i], micros[i], 0, records[i], sizeof(records[i]), flags);
+        }
+    }
+    end = clock();
+    printf("%-24s '%s' : %6.2f ns per record\n", "Timestamp", records[0], per_record(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        sink += tinyutc_format_unix_iso8601_batch(records[0], sizeof(records[0]), timestamps, micros, BENCH_RECORDS, 0, flags);
+    }
+    end = clock();
+    printf("%-24s '%s' : %6.2f ns per record\n", "Timestamps, batch", records[0], per_record(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        struct TinyUTCFormatCache cache;
+
+        tinyutc_format_cache_init(&cache, 0, flags);
+        for (int i = 0; i < BENCH_RECORDS; i++)
+        {
+            sink += tinyutc_format_cache_unix_iso8601(&cache, timestamps[i], micros[i], records[i], sizeof(records[i]));
+        }
+    }
+    end = clock();
+    printf("%-24s '%s' : %6.2f ns per record\n", "Timestamps, cache", records[0], per_record(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_RECORDS; i++)
+        {
+            tinyutc_unix_to_utc(&utc_tm, timestamps[i]);
+            utc_tm.microseconds = micros[i];
+            sink += tinyutc_format_iso8601(&utc_tm, records[i], sizeof(records[i]), flags);
+        }
+    }
+    end = clock();
+    printf("%-24s '%s' : %6.2f ns per record\n", "Structure", records[0], per_record(begin, end));
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ * @file bench_pattern.c
+ * @brief Latency benchmark of the precompiled patterns, against glibc and hand-written code.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Random "DD/MM/YYYY hh:mm:ss" dates are parsed with `strptime`, a compiled pattern, and
+ * a parser written for this layout only, then formatted the same three ways. Build with
+ * optimizations, e.g. `gcc -O2 bench_pattern.c ../tinyutc_pattern.c -o bench_pattern`.
+ */
+
+#define _GNU_SOURCE // strptime
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+#include "../tinyutc_pattern.h"
+
+#define BENCH_DATES 4096
+#define BENCH_ROUNDS 200
+#define LAYOUT "%d/%m/%Y %H:%M:%S"
+#define LAYOUT_WIDTH 19
+
+static struct TinyUTCTime datetimes[BENCH_DATES];
+static char dates[BENCH_DATES][LAYOUT_WIDTH + 1];
+
+static double per_date(clock_t begin, clock_t end)
+{
+    return (double)(end - begin) / CLOCKS_PER_SEC * 1e9 / ((double)BENCH_DATES * BENCH_ROUNDS);
+}
+
+// Hand-written parser of the layout, with the same checks as the pattern
+static err_t parse_by_hand(struct TinyUTCTime *utc_tm, const char *str)
+{
+    static const uint8_t digit_positions[] = {0, 1, 3, 4, 6, 7, 8, 9, 11, 12, 14, 15, 17, 18};
+
+    for (size_t i = 0; i < sizeof(digit_positions); i++)
+    {
+        if ((uint8_t)(str[digit_positions[i]] - '0') > 9)
+        {
+            return TINYUTC_ISO8601_INVALID_FORMAT;
+        }
+    }
+    if (str[2] != '/' || str[5] != '/' || str[10] != ' ' || str[13] != ':' || str[16] != ':')
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+
+    utc_tm->day = (uint8_t)((str[0] - '0') * 10 + str[1] - '0');
+    utc_tm->month = (uint8_t)((str[3] - '0') * 10 + str[4] - '0');
+    utc_tm->year = (uint16_t)((str[6] - '0') * 1000 + (str[7] - '0') * 100 + (str[8] - '0') * 10 + str[9] - '0');
+    utc_tm->hour = (uint8_t)((str[11] - '0') * 10 + str[12] - '0');
+    utc_tm->minute = (uint8_t)((str[14] - '0') * 10 + str[15] - '0');
+    utc_tm->second = (uint8_t)((str[17] - '0') * 10 + str[18] - '0');
+
+    if (utc_tm->hour > 23 || utc_tm->minute > 59 || utc_tm->second > 60)
+    {
+        return TINYUTC_ISO8601_INVALID_TIME;
+    }
+    if (utc_tm->year < 1970 || utc_tm->month < 1 || utc_tm->month > 12 || utc_tm->day < 1 ||
+        utc_tm->day > _TINYUTC_GET_DAYS_IN_MONTH(utc_tm->month - 1, utc_tm->year))
+    {
+        return TINYUTC_ISO8601_INVALID_DATE;
+    }
+    return TINYUTC_ISO8601_OK;
+}
+
+static void pair_by_hand(char *buf, uint32_t value)
+{
+    buf[0] = (char)('0' + value / 10);
+    buf[1] = (char)('0' + value % 10);
+}
+
+// Hand-written formatter of the layout
+static void format_by_hand(const struct TinyUTCTime *utc_tm, char *buf)
+{
+    pair_by_hand(buf, utc_tm->day);
+    buf[2] = '/';
+    pair_by_hand(buf + 3, utc_tm->month);
+    buf[5] = '/';
+    pair_by_hand(buf + 6, utc_tm->year / 100);
+    pair_by_hand(buf + 8, utc_tm->year % 100);
+    buf[10] = ' ';
+    pair_by_hand(buf + 11, utc_tm->hour);
+    buf[13] = ':';
+    pair_by_hand(buf + 14, utc_tm->minute);
+    buf[16] = ':';
+    pair_by_hand(buf + 17, utc_tm->second);
+    buf[19] = '\0';
+}
+
+int main()
+{
+    struct TinyUTCPattern pattern;
+    struct TinyUTCTime utc_tm = {0};
+    volatile uint32_t sink = 0;
+    clock_t begin, end;
+    struct tm tm;
+
+    tinyutc_pattern_compile(&pattern, LAYOUT);
+    srand(1970);
+    for (int i = 0; i < BENCH_DATES; i++)
+    {
+        tinyutc_unix_to_utc(&datetimes[i], (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()));
+        datetimes[i].microseconds = 0;
+        tinyutc_pattern_format(&pattern, &datetimes[i], dates[i], sizeof(dates[i]));
+    }
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            strptime(dates[i], LAYOUT, &tm);
+            sink += tm.tm_sec;
+        }
+    }
+    end = clock();
+    printf("%-24s : %6.2f ns per date\n", "Parse, strptime", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            sink += tinyutc_pattern_parse(&pattern, &utc_tm, dates[i], LAYOUT_WIDTH) + utc_tm.second;
+        }
+    }
+    end = clock();
+    printf("%-24s : %6.2f ns per date\n", "Parse, pattern", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            sink += parse_by_hand(&utc_tm, dates[i]) + utc_tm.second;
+        }
+    }
+    end = clock();
+    printf("%-24s : %6.2f ns per date\n", "Parse, by hand", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            struct tm tm_out = {.tm_year = datetimes[i].year - 1900, .tm_mon = datetimes[i].month - 1, .tm_mday = datetimes[i].day,
+                                .tm_hour = datetimes[i].hour, .tm_min = datetimes[i].minute, .tm_sec = datetimes[i].second};
+            sink += strftime(dates[i], sizeof(dates[i]), LAYOUT, &tm_out);
+        }
+    }
+    end = clock();
+    printf("%-24s : %6.2f ns per date\n", "Format, strftime", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            sink += tinyutc_pattern_format(&pattern, &datetimes[i], dates[i], sizeof(dates[i]));
+        }
+    }
+    end = clock();
+    printf("%-24s : %6.2f ns per date\n", "Format, pattern", per_date(begin, end));
+
+    begin = clock();
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (int i = 0; i < BENCH_DATES; i++)
+        {
+            format_by_hand(&datetimes[i], dates[i]);
+            sink += dates[i][18];
+        }
+    }
+    end = clock();
+    printf("%-24s : %6.2f ns per date\n", "Format, by hand", per_date(begin, end));
+
+    return 0;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file bench_unix_utc.c
+ * @brief Latency benchmark of the Unix timestamp <-> UTC time conversions, per year.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Both conversions must have a flat latency over the whole 1970-2105 range (2106, the
+ * last year of unsigned 32 bits timestamps, ends in February).
+ * Build with optimizations, e.g. `gcc -O2 bench_unix_utc.c -o bench_unix_utc`.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "../tinyutc.h"
+
+#define BENCH_ITERATIONS 2000000UL
+#define BENCH_FIRST_YEAR 1970
+#define BENCH_LAST_YEAR 2105
+#define BENCH_YEAR_STEP 8
+
+int main()
+{
+    struct TinyUTCTime utc_tm = {0};
+    struct TinyUTCTime year_start = {BENCH_FIRST_YEAR, 1, 1, 0, 0, 0, 0};
+    tinyutc_time_t start_ts, unix_ts;
+    volatile uint32_t sink = 0;
+
+    for (int year = BENCH_FIRST_YEAR; year <= BENCH_LAST_YEAR; year += BENCH_YEAR_STEP)
+    {
+        year_start.year = year;
+        if (tinyutc_utc_to_unix(&year_start, &start_ts) != 0)
+        {
+            printf("Year %04d : out of range\n", year);
+            return 1;
+        }
+
+        clock_t begin = clock();
+        for (unsigned long i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            // Walk through the year with a stride that is prime with the seconds per day,
+            // staying in the 2^32 range for the last year.
+            tinyutc_unix_to_utc(&utc_tm, start_ts + (tinyutc_time_t)((i * 7919UL) % (30UL * _TINYUTC_SECS_PER_DAY)));
+            sink += utc_tm.day;
+        }
+        clock_t end = clock();
+
+        double ns_to_utc = (double)(end - begin) * 1e9 / CLOCKS_PER_SEC / BENCH_ITERATIONS;
+
+        begin = clock();
+        for (unsigned long i = 0; i < BENCH_ITERATIONS; i++)
+        {
+            utc_tm.month = 1 + i % 12;
+            utc_tm.day = 1 + i % 28;
+            if (tinyutc_utc_to_unix(&utc_tm, &unix_ts) != 0)
+            {
+                printf("Year %04d : %02u/%02u out of range\n", year, utc_tm.month, utc_tm.day);
+                return 1;
+            }
+            sink += unix_ts;
+        }
+        end = clock();
+
+        double ns_to_unix = (double)(end - begin) * 1e9 / CLOCKS_PER_SEC / BENCH_ITERATIONS;
+        printf("Year %04d : %6.2f ns unix->utc, %6.2f ns utc->unix\n", year, ns_to_utc, ns_to_unix);
+    }
+
+    return 0;
+}
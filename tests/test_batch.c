@@ -0,0 +1,129 @@
+/**
+ * @file test_batch.c
+ * @brief Test cases for batch conversions, against the single element conversions.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "../tinyutc.h"
+
+#define BATCH_SIZE 100003
+
+static tinyutc_time_t timestamps[BATCH_SIZE];
+static tinyutc_time_t timestamps_back[BATCH_SIZE];
+static struct TinyUTCTime times[BATCH_SIZE];
+
+static uint16_t years[BATCH_SIZE];
+static uint8_t months[BATCH_SIZE], days[BATCH_SIZE], hours[BATCH_SIZE], minutes[BATCH_SIZE], seconds[BATCH_SIZE];
+
+int main()
+{
+    struct TinyUTCColumns columns = {years, months, days, hours, minutes, seconds};
+    struct TinyUTCTime expected = {0};
+    int failures = 0;
+
+    // Batch boundaries of the 32 bits range, then random timestamps
+    timestamps[0] = 0;
+    timestamps[1] = 0xFFFFFFFF;
+    timestamps[2] = 951782400; // 2000-02-29
+    for (int i = 3; i < BATCH_SIZE; i++)
+    {
+        timestamps[i] = (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+    }
+
+    tinyutc_unix_to_utc_batch(times, timestamps, BATCH_SIZE);
+    tinyutc_unix_to_utc_batch_columns(&columns, timestamps, BATCH_SIZE);
+
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        tinyutc_unix_to_utc(&expected, timestamps[i]);
+
+        bool is_same_struct = times[i].year == expected.year && times[i].month == expected.month && times[i].day == expected.day &&
+                              times[i].hour == expected.hour && times[i].minute == expected.minute && times[i].second == expected.second &&
+                              times[i].microseconds == 0;
+        bool is_same_columns = years[i] == expected.year && months[i] == expected.month && days[i] == expected.day &&
+                               hours[i] == expected.hour && minutes[i] == expected.minute && seconds[i] == expected.second;
+
+        if (!is_same_struct || !is_same_columns)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch unix to utc, index %d : %013lld\n", i, (long long)timestamps[i]);
+            failures++;
+        }
+    }
+
+    if (tinyutc_utc_to_unix_batch(timestamps_back, times, BATCH_SIZE) != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch utc to unix returned an error\n");
+        failures++;
+    }
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        if (timestamps_back[i] != timestamps[i])
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch utc to unix, index %d : %013lld =/= %013lld\n", i, (long long)timestamps_back[i], (long long)timestamps[i]);
+            failures++;
+        }
+    }
+
+    if (tinyutc_utc_to_unix_batch_columns(timestamps_back, &columns, BATCH_SIZE) != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch columns utc to unix returned an error\n");
+        failures++;
+    }
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        if (timestamps_back[i] != timestamps[i])
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch columns utc to unix, index %d : %013lld =/= %013lld\n", i, (long long)timestamps_back[i], (long long)timestamps[i]);
+            failures++;
+        }
+    }
+
+    // An invalid element is reported, and does not prevent the others from being converted
+    months[7] = 13;
+    years[8] = _TINYUTC_MIN_YEAR - 1;
+    if (tinyutc_utc_to_unix_batch_columns(timestamps_back, &columns, BATCH_SIZE) != -1 ||
+        timestamps_back[7] != 0 || timestamps_back[8] != 0 || timestamps_back[9] != timestamps[9])
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch columns utc to unix with invalid elements\n");
+        failures++;
+    }
+
+    // Past 2106-02-07 06:28:15, dates do not fit in 32 bits unsigned timestamps
+    if (!_TINYUTC_TIME_IS_SIGNED && sizeof(tinyutc_time_t) == sizeof(uint32_t))
+    {
+        times[10] = (struct TinyUTCTime){2106, 2, 7, 6, 28, 16, 0};
+        times[11] = (struct TinyUTCTime){2200, 1, 1, 0, 0, 0, 0};
+        years[10] = 2106, months[10] = 2, days[10] = 7, hours[10] = 6, minutes[10] = 28, seconds[10] = 16;
+        years[11] = 2200, months[11] = 1, days[11] = 1, hours[11] = 0, minutes[11] = 0, seconds[11] = 0;
+        if (tinyutc_utc_to_unix_batch(timestamps_back, times, BATCH_SIZE) != -1 ||
+            timestamps_back[10] != 0 || timestamps_back[11] != 0 || timestamps_back[12] != timestamps[12])
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch utc to unix past 2106\n");
+            failures++;
+        }
+        if (tinyutc_utc_to_unix_batch_columns(timestamps_back, &columns, BATCH_SIZE) != -1 ||
+            timestamps_back[10] != 0 || timestamps_back[11] != 0 || timestamps_back[12] != timestamps[12])
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch columns utc to unix past 2106\n");
+            failures++;
+        }
+    }
+
+    printf("Batch conversions of %d timestamps: %d failures.\n", BATCH_SIZE, failures);
+    return failures != 0;
+}
@@ -0,0 +1,265 @@
+/**
+ * @file test_calendar_arithmetic.c
+ * @brief Test cases for adding seconds, days and months to UTC time structures.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Some hand written cases, then random dates and deltas compared to a round trip
+ * through the day count.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../tinyutc.h"
+
+#define RANDOM_ROUNDS 2000000
+
+enum Operation
+{
+    ADD_SECONDS,
+    ADD_DAYS,
+    ADD_MONTHS_CLAMP,
+    ADD_MONTHS_OVERFLOW,
+};
+
+struct Test
+{
+    struct TinyUTCTime utc_tm;
+    enum Operation operation;
+    int32_t delta;
+    err_t expected_error;
+    struct TinyUTCTime expected;
+};
+
+struct Test test_cases[] = {
+    {{2024, 12, 31, 23, 59, 59, 0}, ADD_SECONDS, 1, 0, {2025, 1, 1, 0, 0, 0, 0}},
+    {{2025, 1, 1, 0, 0, 0, 0}, ADD_SECONDS, -1, 0, {2024, 12, 31, 23, 59, 59, 0}},
+    {{2024, 2, 29, 17, 5, 3, 0}, ADD_SECONDS, 10 * 86400 + 7, 0, {2024, 3, 10, 17, 5, 10, 0}},
+    {{2024, 2, 28, 12, 0, 0, 0}, ADD_SECONDS, 3 * 60 * 60, 0, {2024, 2, 28, 15, 0, 0, 0}},
+    {{1970, 1, 1, 0, 0, 0, 0}, ADD_SECONDS, INT32_MAX, 0, {2038, 1, 19, 3, 14, 7, 0}},
+    {{2038, 1, 19, 3, 14, 8, 0}, ADD_SECONDS, INT32_MIN, 0, {1970, 1, 1, 0, 0, 0, 0}},
+    {{2023, 2, 28, 0, 0, 0, 0}, ADD_DAYS, 1, 0, {2023, 3, 1, 0, 0, 0, 0}},
+    {{2024, 2, 28, 0, 0, 0, 0}, ADD_DAYS, 1, 0, {2024, 2, 29, 0, 0, 0, 0}},
+    {{2024, 3, 1, 0, 0, 0, 0}, ADD_DAYS, -1, 0, {2024, 2, 29, 0, 0, 0, 0}},
+    {{2024, 1, 15, 0, 0, 0, 0}, ADD_DAYS, 366, 0, {2025, 1, 15, 0, 0, 0, 0}},
+    {{65535, 12, 31, 0, 0, 0, 0}, ADD_DAYS, 1, -1, {65535, 12, 31, 0, 0, 0, 0}},
+    {{65535, 12, 1, 0, 0, 0, 0}, ADD_DAYS, 30, 0, {65535, 12, 31, 0, 0, 0, 0}},
+    {{65535, 1, 1, 0, 0, 0, 0}, ADD_DAYS, 365, -1, {65535, 1, 1, 0, 0, 0, 0}},
+    {{2024, 1, 31, 8, 0, 0, 0}, ADD_MONTHS_CLAMP, 1, 0, {2024, 2, 29, 8, 0, 0, 0}},
+    {{2024, 1, 31, 8, 0, 0, 0}, ADD_MONTHS_OVERFLOW, 1, 0, {2024, 3, 2, 8, 0, 0, 0}},
+    {{2023, 1, 31, 8, 0, 0, 0}, ADD_MONTHS_OVERFLOW, 1, 0, {2023, 3, 3, 8, 0, 0, 0}},
+    {{2024, 3, 31, 8, 0, 0, 0}, ADD_MONTHS_CLAMP, -1, 0, {2024, 2, 29, 8, 0, 0, 0}},
+    {{2024, 11, 15, 8, 0, 0, 0}, ADD_MONTHS_CLAMP, 2, 0, {2025, 1, 15, 8, 0, 0, 0}},
+    {{2024, 2, 29, 8, 0, 0, 0}, ADD_MONTHS_CLAMP, 12, 0, {2025, 2, 28, 8, 0, 0, 0}},
+    {{2024, 2, 29, 8, 0, 0, 0}, ADD_MONTHS_OVERFLOW, -12, 0, {2023, 3, 1, 8, 0, 0, 0}},
+    {{65535, 12, 1, 0, 0, 0, 0}, ADD_MONTHS_CLAMP, 1, -1, {65535, 12, 1, 0, 0, 0, 0}},
+    {{2024, 5, 5, 0, 0, 0, 0}, ADD_MONTHS_CLAMP, INT32_MAX, -1, {2024, 5, 5, 0, 0, 0, 0}},
+    {{2024, 5, 5, 0, 0, 0, 0}, ADD_MONTHS_CLAMP, INT32_MIN, -1, {2024, 5, 5, 0, 0, 0, 0}},
+#ifndef TINYUTC_USE_INT64
+    {{1970, 1, 1, 0, 0, 0, 0}, ADD_SECONDS, -1, -1, {1970, 1, 1, 0, 0, 0, 0}},
+    {{2038, 1, 19, 3, 14, 7, 0}, ADD_SECONDS, INT32_MIN, -1, {2038, 1, 19, 3, 14, 7, 0}},
+    {{1970, 1, 27, 0, 0, 0, 0}, ADD_DAYS, -27, -1, {1970, 1, 27, 0, 0, 0, 0}},
+    {{1970, 1, 1, 0, 0, 0, 0}, ADD_MONTHS_CLAMP, -1, -1, {1970, 1, 1, 0, 0, 0, 0}},
+#else
+    {{1970, 1, 1, 0, 0, 0, 0}, ADD_SECONDS, -1, 0, {1969, 12, 31, 23, 59, 59, 0}},
+    {{2038, 1, 19, 3, 14, 7, 0}, ADD_SECONDS, INT32_MIN, 0, {1969, 12, 31, 23, 59, 59, 0}},
+    {{1, 1, 1, 0, 0, 0, 0}, ADD_SECONDS, -1, -1, {1, 1, 1, 0, 0, 0, 0}},
+    {{1, 1, 27, 0, 0, 0, 0}, ADD_DAYS, -27, -1, {1, 1, 27, 0, 0, 0, 0}},
+    {{1, 1, 1, 0, 0, 0, 0}, ADD_MONTHS_CLAMP, -1, -1, {1, 1, 1, 0, 0, 0, 0}},
+#endif
+};
+
+static err_t apply(struct TinyUTCTime *utc_tm, enum Operation operation, int32_t delta)
+{
+    switch (operation)
+    {
+    case ADD_SECONDS:
+        return tinyutc_add_seconds(utc_tm, delta);
+    case ADD_DAYS:
+        return tinyutc_add_days(utc_tm, delta);
+    case ADD_MONTHS_CLAMP:
+        return tinyutc_add_months(utc_tm, delta, TINYUTC_MONTH_CLAMP);
+    default:
+        return tinyutc_add_months(utc_tm, delta, TINYUTC_MONTH_OVERFLOW);
+    }
+}
+
+static bool compare_utc_structs(const struct TinyUTCTime *a, const struct TinyUTCTime *b)
+{
+    return a->year == b->year && a->month == b->month && a->day == b->day &&
+           a->hour == b->hour && a->minute == b->minute && a->second == b->second;
+}
+
+// Expected result of adding seconds, through the day count (negative before 1970 with signed timestamps)
+static err_t add_seconds_reference(struct TinyUTCTime *utc_tm, int64_t seconds)
+{
+    int64_t total = (int64_t)(int32_t)_tinyutc_days_from_civil(utc_tm->year, utc_tm->month, utc_tm->day) * 86400 +
+                    utc_tm->hour * 3600 + utc_tm->minute * 60 + utc_tm->second + seconds;
+    int64_t days = total / 86400, secs = total % 86400;
+
+    if (secs < 0)
+    {
+        secs += 86400;
+        days--;
+    }
+    if (days < _TINYUTC_MIN_DAYS || days > (int64_t)_TINYUTC_MAX_DAYS)
+    {
+        return -1;
+    }
+    _tinyutc_civil_from_days((uint32_t)days, &utc_tm->year, &utc_tm->month, &utc_tm->day);
+    utc_tm->hour = secs / 3600;
+    utc_tm->minute = secs % 3600 / 60;
+    utc_tm->second = secs % 60;
+    return 0;
+}
+
+// Expected result of adding months, month by month
+static err_t add_months_reference(struct TinyUTCTime *utc_tm, int32_t months, bool overflow)
+{
+    struct TinyUTCTime result = *utc_tm;
+    int32_t year = utc_tm->year, month = utc_tm->month;
+    uint8_t days_in_month;
+
+    for (; months > 0; months--)
+    {
+        if (++month > 12)
+        {
+            month = 1;
+            year++;
+        }
+    }
+    for (; months < 0; months++)
+    {
+        if (--month < 1)
+        {
+            month = 12;
+            year--;
+        }
+    }
+    if (year < (int32_t)_TINYUTC_MIN_YEAR || year > 65535)
+    {
+        return -1;
+    }
+    result.year = year;
+    result.month = month;
+
+    days_in_month = _TINYUTC_GET_DAYS_IN_MONTH(result.month - 1, result.year);
+    if (result.day > days_in_month)
+    {
+        int extra_days = result.day - days_in_month;
+        result.day = days_in_month;
+        if (overflow)
+        {
+            add_seconds_reference(&result, (int64_t)extra_days * 86400);
+        }
+    }
+    *utc_tm = result;
+    return 0;
+}
+
+int test_cases_table()
+{
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++)
+    {
+        struct TinyUTCTime result = test_cases[i].utc_tm;
+        err_t error = apply(&result, test_cases[i].operation, test_cases[i].delta);
+
+        if (error != test_cases[i].expected_error || !compare_utc_structs(&result, &test_cases[i].expected))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Test '%03d' : %04d/%02d/%02d %02d:%02d:%02d (error %d)\n", (int)i + 1,
+                   result.year, result.month, result.day, result.hour, result.minute, result.second, error);
+            failures++;
+        }
+        else
+        {
+            printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Test '%03d' : %04d/%02d/%02d %02d:%02d:%02d\n", (int)i + 1,
+                   result.year, result.month, result.day, result.hour, result.minute, result.second);
+        }
+    }
+
+    return failures;
+}
+
+int test_random()
+{
+    int failures = 0;
+
+    srand(1970);
+    for (int round = 0; round < RANDOM_ROUNDS; round++)
+    {
+        struct TinyUTCTime start = {0};
+        tinyutc_unix_to_utc(&start, (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()));
+
+        enum Operation operation = (enum Operation)(round % 4);
+        int32_t delta;
+        switch (rand() % 3)
+        {
+        case 0: // Small deltas, mostly carries
+            delta = rand() % 121 - 60;
+            break;
+        case 1:
+            delta = rand() % 200001 - 100000;
+            break;
+        default:
+            delta = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+            break;
+        }
+
+        struct TinyUTCTime result = start;
+        struct TinyUTCTime expected = start;
+        err_t error = apply(&result, operation, delta);
+        err_t expected_error;
+
+        switch (operation)
+        {
+        case ADD_SECONDS:
+            expected_error = add_seconds_reference(&expected, delta);
+            break;
+        case ADD_DAYS:
+            expected_error = add_seconds_reference(&expected, (int64_t)delta * 86400);
+            break;
+        default:
+            // Keep the month by month reference reasonably fast
+            delta %= 100000;
+            result = start;
+            error = apply(&result, operation, delta);
+            expected_error = add_months_reference(&expected, delta, operation == ADD_MONTHS_OVERFLOW);
+            break;
+        }
+
+        if (error != expected_error || !compare_utc_structs(&result, &expected))
+        {
+            if (failures < 10)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Operation %d of %d on %04d/%02d/%02d %02d:%02d:%02d\n", operation, delta,
+                       start.year, start.month, start.day, start.hour, start.minute, start.second);
+            }
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+int main()
+{
+    int failures = test_cases_table();
+    failures += test_random();
+
+    printf("Calendar arithmetic: %d failures.\n", failures);
+    return failures != 0;
+}
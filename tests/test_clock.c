@@ -0,0 +1,173 @@
+/**
+ * @file test_clock.c
+ * @brief Test cases for the cached clock.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * One thread updates the clock as fast as it can while reader threads check that
+ * every time they read is consistent (structure and datetimes of the same timestamp)
+ * and never goes back. Build with `-pthread`, and preferably `-fsanitize=thread`.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../http_date.h"
+#include "../iso8601_formatter.h"
+#include "../tinyutc.h"
+#include "../tinyutc_clock.h"
+
+#include "tests_common.h"
+
+#define UPDATES 200000
+#define READERS 3
+#define CLOCK_OFFSET 3600
+#define CLOCK_FLAGS (TINYUTC_FORMAT_MICROSECONDS | TINYUTC_FORMAT_OFFSET)
+
+static struct TinyUTCClock shared_clock;
+static atomic_bool is_updating;
+
+// Checks a time read from the clock, returns true if consistent
+static bool is_consistent(struct TinyUTCClockTime *time)
+{
+    struct TinyUTCTime utc_tm;
+    char expected[TINYUTC_FORMAT_MAX_SIZE], expected_http[TINYUTC_HTTP_DATE_SIZE];
+    size_t len = tinyutc_format_unix_iso8601(time->unix_ts, time->utc.microseconds, CLOCK_OFFSET, expected, sizeof(expected),
+                                             CLOCK_FLAGS);
+
+    tinyutc_unix_to_utc(&utc_tm, time->unix_ts);
+    utc_tm.microseconds = time->utc.microseconds;
+    tinyutc_format_unix_http_date(time->unix_ts, expected_http, sizeof(expected_http));
+    return compare_utc_structs_datetimes(&utc_tm, &time->utc) && utc_tm.microseconds == time->utc.microseconds &&
+           len == time->iso_len && strcmp(time->iso, expected) == 0 && strcmp(time->http, expected_http) == 0;
+}
+
+static void *reader(void *arg)
+{
+    struct TinyUTCClockTime time;
+    uint64_t previous = 0;
+    long failures = 0, reads = 0;
+
+    (void)arg;
+    while (atomic_load(&is_updating) && failures < 10)
+    {
+        if (tinyutc_clock_read(&shared_clock, &time) != 0)
+        {
+            continue;
+        }
+
+        // Timestamps and microseconds of the writer only increase
+        uint64_t current = (uint64_t)time.unix_ts * 1000000 + time.utc.microseconds;
+        if (!is_consistent(&time) || current < previous)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Read %lld '%s' after %llu\n", (long long)time.unix_ts, time.iso,
+                   (unsigned long long)previous);
+            failures++;
+        }
+        previous = current;
+        reads++;
+    }
+
+    return (void *)failures;
+}
+
+int test_concurrent()
+{
+    pthread_t readers[READERS];
+    tinyutc_time_t unix_ts = 1700000000;
+    uint32_t micros = 0;
+    int failures = 0;
+
+    tinyutc_clock_init(&shared_clock, CLOCK_OFFSET, CLOCK_FLAGS);
+    atomic_store(&is_updating, true);
+    for (int i = 0; i < READERS; i++)
+    {
+        pthread_create(&readers[i], 0, reader, 0);
+    }
+
+    srand(1970);
+    for (int i = 0; i < UPDATES; i++)
+    {
+        micros += rand() % 100000;
+        if (micros > 999999)
+        {
+            micros -= 1000000;
+            unix_ts++;
+        }
+        if (rand() % 1000 == 0)
+        {
+            unix_ts += rand() % 200000; // Next days
+        }
+        failures += tinyutc_clock_update(&shared_clock, unix_ts, micros) != 0;
+    }
+
+    atomic_store(&is_updating, false);
+    for (int i = 0; i < READERS; i++)
+    {
+        void *reader_failures;
+        pthread_join(readers[i], &reader_failures);
+        failures += (int)(long)reader_failures;
+    }
+
+    if (tinyutc_clock_now(&shared_clock) != unix_ts)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Last timestamp %lld, expected %lld\n", (long long)tinyutc_clock_now(&shared_clock),
+               (long long)unix_ts);
+        failures++;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d updates read by %d threads\n", UPDATES, READERS);
+    }
+    return failures;
+}
+
+int test_unpublished()
+{
+    struct TinyUTCClock clock;
+    struct TinyUTCClockTime time;
+    int failures = 0;
+
+    tinyutc_clock_init(&clock, 0, TINYUTC_FORMAT_ZULU);
+    if (tinyutc_clock_read(&clock, &time) != -1 || tinyutc_clock_now(&clock) != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t No time should be published before the first update\n");
+        failures++;
+    }
+
+    // A failed update keeps the last time published
+    if (tinyutc_clock_update(&clock, 86400, 5) != 0 || tinyutc_clock_update(&clock, 86401, 1000000) != -1 ||
+        tinyutc_clock_read(&clock, &time) != 0 || time.unix_ts != 86400 || time.utc.microseconds != 5 ||
+        strcmp(time.iso, "1970-01-02T00:00:00Z") != 0 || strcmp(time.http, "Fri, 02 Jan 1970 00:00:00 GMT") != 0 ||
+        tinyutc_clock_now(&clock) != 86400)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Failed updates should not be published\n");
+        failures++;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Only successful updates are published\n");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_unpublished();
+    failures += test_concurrent();
+
+    printf("Cached clock: %d failures.\n", failures);
+    return failures != 0;
+}
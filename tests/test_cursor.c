@@ -0,0 +1,113 @@
+/**
+ * @file test_cursor.c
+ * @brief Test cases for the incremental cursor converter.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * The cursor is walked over the whole 32 bits range with increasing steps, then
+ * with backward jumps and gaps, and compared to `tinyutc_unix_to_utc`.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "../tinyutc.h"
+
+static int check_conversion(struct TinyUTCCursor *cursor, tinyutc_time_t ts)
+{
+    struct TinyUTCTime current = {0};
+    struct TinyUTCTime expected = {0};
+
+    tinyutc_cursor_unix_to_utc(cursor, &current, ts);
+    tinyutc_unix_to_utc(&expected, ts);
+
+    if (current.year != expected.year || current.month != expected.month || current.day != expected.day ||
+        current.hour != expected.hour || current.minute != expected.minute || current.second != expected.second)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %013u =/= %04d/%02d/%02d %02d:%02d:%02d\n", (unsigned)ts,
+               expected.year, expected.month, expected.day, expected.hour, expected.minute, expected.second);
+        return 1;
+    }
+    return 0;
+}
+
+static int check_counters(const char *name, const struct TinyUTCCursor *cursor, uint32_t hits, uint32_t misses)
+{
+    if (cursor->hits != hits || cursor->misses != misses)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %s : %u hits, %u misses, expected %u hits, %u misses\n", name,
+               cursor->hits, cursor->misses, hits, misses);
+        return 1;
+    }
+    printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %s : %u hits, %u misses\n", name, cursor->hits, cursor->misses);
+    return 0;
+}
+
+int test_increasing()
+{
+    struct TinyUTCCursor cursor;
+    int failures = 0;
+    uint32_t count = 0;
+
+    tinyutc_cursor_init(&cursor);
+
+    // Steps up to a day, so that every conversion after the first one is a hit
+    for (uint64_t ts = 0; ts <= 0xFFFFFFFF; ts += 1 + rand() % _TINYUTC_SECS_PER_DAY)
+    {
+        failures += check_conversion(&cursor, (tinyutc_time_t)ts);
+        count++;
+    }
+    failures += check_counters("Increasing timestamps", &cursor, count - 1, 1);
+
+    return failures;
+}
+
+int test_jumps()
+{
+    struct TinyUTCCursor cursor;
+    int failures = 0;
+
+    tinyutc_cursor_init(&cursor);
+
+    failures += check_conversion(&cursor, 951782399); // 2000-02-28 23:59:59, miss
+    failures += check_conversion(&cursor, 951782400); // 2000-02-29 00:00:00, next day
+    failures += check_conversion(&cursor, 951868799); // 2000-02-29 23:59:59, same day
+    failures += check_conversion(&cursor, 951868800); // 2000-03-01 00:00:00, next day
+    failures += check_conversion(&cursor, 951782400); // Backward jump, miss
+    failures += check_conversion(&cursor, 951955200); // 2000-03-02, gap of two days, miss
+    failures += check_conversion(&cursor, 978307199); // 2000-12-31 23:59:59, miss
+    failures += check_conversion(&cursor, 978307200); // 2001-01-01 00:00:00, next year
+    failures += check_conversion(&cursor, 978307200); // Same timestamp
+    failures += check_counters("Jumps and carries", &cursor, 5, 4);
+
+    cursor.hits = 0;
+    cursor.misses = 0;
+    failures += check_conversion(&cursor, 978307201);
+    failures += check_counters("Counters reset", &cursor, 1, 0);
+
+    tinyutc_cursor_init(&cursor);
+    failures += check_conversion(&cursor, 0);
+    failures += check_conversion(&cursor, 0xFFFFFFFF);
+    failures += check_conversion(&cursor, 0xFFFFFFFF - _TINYUTC_SECS_PER_DAY);
+    failures += check_counters("Range bounds", &cursor, 0, 3);
+
+    return failures;
+}
+
+int main()
+{
+    int failures = test_increasing();
+    failures += test_jumps();
+
+    printf("Cursor conversions: %d failures.\n", failures);
+}
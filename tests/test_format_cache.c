@@ -0,0 +1,170 @@
+/**
+ * @file test_format_cache.c
+ * @brief Test cases for the ISO8601 format cache.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Sequences of timestamps within a second, a few seconds apart, crossing days, and
+ * jumping back and forth, are formatted through a cache and compared to single calls
+ * to `tinyutc_format_unix_iso8601`, for several offsets and flags. Counters must match
+ * the number of seconds changes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_formatter.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define TIMESTAMPS 200000
+
+static const int32_t offsets[] = {0, 3600, -(5 * 3600 + 30 * 60), 23 * 3600 + 59 * 60, -(23 * 3600 + 59 * 60)};
+static const uint32_t flags_list[] = {0,
+                                      TINYUTC_FORMAT_MICROSECONDS | TINYUTC_FORMAT_ZULU,
+                                      TINYUTC_FORMAT_BASIC | TINYUTC_FORMAT_MILLISECONDS | TINYUTC_FORMAT_OFFSET,
+                                      TINYUTC_FORMAT_SPACE | TINYUTC_FORMAT_MILLISECONDS | TINYUTC_FORMAT_ZULU,
+                                      TINYUTC_FORMAT_BASIC | TINYUTC_FORMAT_ZULU};
+
+// Next timestamp of a sequence, mostly in the same second or a few seconds later
+static tinyutc_time_t next_timestamp(tinyutc_time_t unix_ts)
+{
+    int choice = rand() % 100;
+
+    if (choice < 60)
+    {
+        return unix_ts;
+    }
+    if (choice < 90)
+    {
+        return unix_ts + rand() % 3;
+    }
+    if (choice < 96)
+    {
+        return unix_ts + rand() % 7200; // Crosses hours, and days now and then
+    }
+    if (choice < 98)
+    {
+        return unix_ts - rand() % 100000; // Back in time, maybe another day
+    }
+    return (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()); // Anywhere, maybe out of range
+}
+
+int test_sequences()
+{
+    char result[TINYUTC_FORMAT_MAX_SIZE], expected[TINYUTC_FORMAT_MAX_SIZE];
+    int failures = 0;
+
+    srand(1970);
+    for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++)
+    {
+        for (size_t f = 0; f < sizeof(flags_list) / sizeof(flags_list[0]); f++)
+        {
+            struct TinyUTCFormatCache cache;
+            tinyutc_time_t unix_ts = 1700000000, previous = 0;
+            uint32_t misses = 0, hits = 0;
+            bool has_previous = false;
+
+            tinyutc_format_cache_init(&cache, offsets[o], flags_list[f]);
+            for (int i = 0; i < TIMESTAMPS && failures < 10; i++)
+            {
+                uint32_t micros = rand() % 1000000;
+                size_t len = tinyutc_format_cache_unix_iso8601(&cache, unix_ts, micros, result, sizeof(result));
+                size_t expected_len =
+                    tinyutc_format_unix_iso8601(unix_ts, micros, offsets[o], expected, sizeof(expected), flags_list[f]);
+
+                if (len != expected_len || (len != 0 && strcmp(result, expected) != 0))
+                {
+                    printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %lld%+d: '%s' (%zu), expected '%s' (%zu)\n", (long long)unix_ts,
+                           offsets[o], len != 0 ? result : "", len, expected_len != 0 ? expected : "", expected_len);
+                    failures++;
+                }
+
+                if (len != 0)
+                {
+                    hits += has_previous && unix_ts == previous;
+                    misses += !has_previous || unix_ts != previous;
+                    previous = unix_ts;
+                    has_previous = true;
+                }
+                unix_ts = next_timestamp(unix_ts);
+            }
+
+            if (cache.hits != hits || cache.misses != misses)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Offset %d, flags %#x: %u hits and %u misses, expected %u and %u\n",
+                       offsets[o], flags_list[f], cache.hits, cache.misses, hits, misses);
+                failures++;
+            }
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Cached sequences match single calls\n");
+    }
+    return failures;
+}
+
+int test_rejected()
+{
+    struct TinyUTCFormatCache cache;
+    char result[TINYUTC_FORMAT_MAX_SIZE];
+    int failures = 0;
+
+    tinyutc_format_cache_init(&cache, 30, 0);
+    if (tinyutc_format_cache_unix_iso8601(&cache, 0, 0, result, sizeof(result)) != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Offsets out of range should be rejected\n");
+        failures++;
+    }
+
+    // Too small or fraction out of range, then still usable
+    tinyutc_format_cache_init(&cache, 0, TINYUTC_FORMAT_ZULU);
+    if (tinyutc_format_cache_unix_iso8601(&cache, 86400, 0, result, 20) != 0 ||
+        tinyutc_format_cache_unix_iso8601(&cache, 86400, 1000000, result, sizeof(result)) != 0 ||
+        tinyutc_format_cache_unix_iso8601(&cache, 86400, 0, result, 21) != 20 || strcmp(result, "1970-01-02T00:00:00Z") != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Buffers too small should be rejected\n");
+        failures++;
+    }
+
+    // Local time before 1970 fails, without losing the cached second
+    if (!_TINYUTC_TIME_IS_SIGNED)
+    {
+        tinyutc_format_cache_init(&cache, -3600, TINYUTC_FORMAT_OFFSET);
+        if (tinyutc_format_cache_unix_iso8601(&cache, 7200, 0, result, sizeof(result)) != 25 ||
+            tinyutc_format_cache_unix_iso8601(&cache, 1800, 0, result, sizeof(result)) != 0 ||
+            tinyutc_format_cache_unix_iso8601(&cache, 7200, 0, result, sizeof(result)) != 25 ||
+            strcmp(result, "1970-01-01T01:00:00-01:00") != 0 || cache.hits != 1 || cache.misses != 1)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Local times out of range should be rejected\n");
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Values out of range are rejected\n");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_sequences();
+    failures += test_rejected();
+
+    printf("ISO8601 format cache: %d failures.\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file test_http_date.c
+ * @brief Test cases for the HTTP-date parser and formatter.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Random timestamps are formatted and compared to `strftime`, then written in the
+ * three forms of RFC 7231 with `strftime` and parsed back. Malformed dates, wrong
+ * names or week days, and values out of range must be rejected.
+ */
+
+#define _GNU_SOURCE // timegm
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../http_date.h"
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define TIMESTAMPS 200000
+
+int test_random()
+{
+    struct TinyUTCTime utc_tm, parsed;
+    struct tm tm;
+    char result[TINYUTC_HTTP_DATE_SIZE], expected[64];
+    const char *forms[] = {"%a, %d %b %Y %H:%M:%S GMT", "%A, %d-%b-%y %H:%M:%S GMT", "%a %b %e %H:%M:%S %Y"};
+    int failures = 0;
+
+    srand(1994);
+    for (int i = 0; i < TIMESTAMPS && failures < 10; i++)
+    {
+        tinyutc_time_t unix_ts = (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()), parsed_ts;
+        time_t t = (time_t)unix_ts;
+
+        gmtime_r(&t, &tm);
+        tinyutc_unix_to_utc(&utc_tm, unix_ts);
+
+        strftime(expected, sizeof(expected), forms[0], &tm);
+        if (tinyutc_format_unix_http_date(unix_ts, result, sizeof(result)) != 29 || strcmp(result, expected) != 0 ||
+            tinyutc_format_http_date(&utc_tm, result, sizeof(result)) != 29 || strcmp(result, expected) != 0)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %lld formatted '%s', expected '%s'\n", (long long)unix_ts, result, expected);
+            failures++;
+        }
+
+        for (int form = 0; form < 3; form++)
+        {
+            size_t len = strftime(expected, sizeof(expected), forms[form], &tm);
+            err_t error = tinyutc_parse_http_date(&parsed, expected, len);
+
+            // Two digits years only cover a century
+            if (form == 1 && (utc_tm.year < 1969 || utc_tm.year > 2068))
+            {
+                continue;
+            }
+            if (error != TINYUTC_ISO8601_OK || !compare_utc_structs_datetimes(&parsed, &utc_tm) ||
+                tinyutc_parse_http_date_to_unix(expected, len, &parsed_ts) != TINYUTC_ISO8601_OK || parsed_ts != unix_ts)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s': %s\n", expected, get_err_string(error));
+                failures++;
+            }
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random timestamps, formatted and parsed in the three forms\n", TIMESTAMPS);
+    }
+    return failures;
+}
+
+int test_examples()
+{
+    struct
+    {
+        const char *http_date;
+        err_t expected;
+    } cases[] = {
+        {"Sun, 06 Nov 1994 08:49:37 GMT", TINYUTC_ISO8601_OK},
+        {"Sunday, 06-Nov-94 08:49:37 GMT", TINYUTC_ISO8601_OK},
+        {"Sun Nov  6 08:49:37 1994", TINYUTC_ISO8601_OK},
+        {"Sun Nov 06 08:49:37 1994", TINYUTC_ISO8601_OK},
+        {"Wednesday, 09-Nov-94 08:49:37 GMT", TINYUTC_ISO8601_OK},
+        {"Tue, 30 Jun 2015 23:59:60 GMT", TINYUTC_ISO8601_OK},
+        {"Sat, 29 Feb 2020 00:00:00 GMT", TINYUTC_ISO8601_OK},
+        {"Thu, 01 Jan 1970 00:00:00 GMT", TINYUTC_ISO8601_OK},
+        {"", TINYUTC_ISO8601_EMPTY_STRING},
+        {"Mon, 06 Nov 1994 08:49:37 GMT", TINYUTC_ISO8601_INVALID_DATE},
+        {"Sun, 29 Feb 2019 00:00:00 GMT", TINYUTC_ISO8601_INVALID_DATE},
+        {"Sun, 00 Nov 1994 08:49:37 GMT", TINYUTC_ISO8601_INVALID_DATE},
+        {"Sun, 06 Nov 1994 24:00:00 GMT", TINYUTC_ISO8601_INVALID_TIME},
+        {"Sun, 06 Nov 1994 08:60:37 GMT", TINYUTC_ISO8601_INVALID_TIME},
+        {"Sun, 06 Nov 1994 08:49:61 GMT", TINYUTC_ISO8601_INVALID_TIME},
+        {"sun, 06 Nov 1994 08:49:37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun, 06 NOV 1994 08:49:37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun, 06 Nov 1994 08:49:37 UTC", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun, 06 Nov 1994 08.49.37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun, 6 Nov 1994 08:49:37 GMT ", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun, 06 Nov 1994 08:49:37 GMT ", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun, 06 Nov 94 08:49:37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sunday, 06 Nov 1994 08:49:37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sunnday, 06-Nov-94 08:49:37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun,day 06-Nov-94 08:49:37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun Nov  6 08:49:37  994", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Sun Nov 6  08:49:37 1994", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"Xyz, 06 Nov 1994 08:49:37 GMT", TINYUTC_ISO8601_INVALID_FORMAT},
+    };
+    struct TinyUTCTime utc_tm, expected = {1994, 11, 6, 8, 49, 37, 0};
+    tinyutc_time_t unix_ts;
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        err_t error = tinyutc_parse_http_date(&utc_tm, cases[i].http_date, strlen(cases[i].http_date));
+
+        if (error != cases[i].expected || (i < 4 && !compare_utc_structs_datetimes(&utc_tm, &expected)))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s': %s, expected %s\n", cases[i].http_date, get_err_string(error),
+                   get_err_string(cases[i].expected));
+            failures++;
+        }
+    }
+
+    // Not null-terminated, and out of the timestamp range
+    if (tinyutc_parse_http_date_to_unix("Sun, 06 Nov 1994 08:49:37 GMT, garbage", 29, &unix_ts) != TINYUTC_ISO8601_OK ||
+        unix_ts != 784111777 ||
+        (!_TINYUTC_TIME_IS_SIGNED &&
+         tinyutc_parse_http_date_to_unix("Wed, 31 Dec 1969 23:59:59 GMT", 29, &unix_ts) != TINYUTC_ISO8601_INVALID_DATE))
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Conversion to timestamps\n");
+        failures++;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Examples and malformed dates\n");
+    }
+    return failures;
+}
+
+int test_format_rejected()
+{
+    struct TinyUTCTime bad_year = {10000, 1, 1, 0, 0, 0, 0};
+    struct TinyUTCTime bad_month = {2024, 0, 1, 0, 0, 0, 0};
+    struct TinyUTCTime good = {9999, 12, 31, 23, 59, 59, 0};
+    char result[TINYUTC_HTTP_DATE_SIZE];
+    int failures = 0;
+
+    if (tinyutc_format_http_date(&bad_year, result, sizeof(result)) != 0 ||
+        tinyutc_format_http_date(&bad_month, result, sizeof(result)) != 0 ||
+        tinyutc_format_http_date(&good, result, sizeof(result) - 1) != 0 ||
+        tinyutc_format_http_date(&good, result, sizeof(result)) != 29 || strcmp(result, "Fri, 31 Dec 9999 23:59:59 GMT") != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Values out of range should be rejected\n");
+        failures++;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Values out of range are rejected\n");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_random();
+    failures += test_examples();
+    failures += test_format_rejected();
+
+    printf("HTTP-date: %d failures.\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,285 @@
+/**
+ * @file test_int64.c
+ * @brief Test cases for signed 64 bits timestamps, against gmtime_r and timegm.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Needs a libc with 64 bits `time_t`, `gmtime_r` and `timegm` (e.g. glibc).
+ * Boundaries of the range, then random timestamps and dates over the whole
+ * 0001-01-01 to 65535-12-31 range, and mostly around the epoch.
+ */
+
+#define _DEFAULT_SOURCE
+#define TINYUTC_USE_INT64
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../tinyutc.h"
+
+#define RANDOM_ROUNDS 2000000
+#define BATCH_SIZE 4096
+
+static tinyutc_time_t timestamps[BATCH_SIZE];
+static tinyutc_time_t timestamps_back[BATCH_SIZE];
+static struct TinyUTCTime times[BATCH_SIZE];
+static uint8_t week_days[BATCH_SIZE];
+
+static uint16_t years[BATCH_SIZE];
+static uint8_t months[BATCH_SIZE], days[BATCH_SIZE], hours[BATCH_SIZE], minutes[BATCH_SIZE], seconds[BATCH_SIZE];
+
+struct Test
+{
+    int64_t ts;
+    err_t expected_error;
+};
+
+struct Test test_cases[] = {
+    {0, 0},
+    {-1, 0},
+    {-86400, 0},
+    {-86401, 0},
+    {INT64_C(-2208988800), 0},  // 1900-01-01, not a leap year
+    {INT64_C(-11670912000), 0}, // 1600-02-29
+    {INT64_C(-62135596800), 0}, // 0001-01-01 00:00:00
+    {INT64_C(-62135596801), -1},
+    {INT64_C(4294967296), 0},    // 2106-02-07 06:28:16, past 32 bits
+    {INT64_C(253402300799), 0},  // 9999-12-31 23:59:59
+    {INT64_C(2005949145599), 0}, // 65535-12-31 23:59:59
+    {INT64_C(2005949145600), -1},
+    {INT64_MAX, -1},
+    {INT64_MIN, -1},
+};
+
+static uint64_t random_u64(void)
+{
+    return ((uint64_t)rand() << 42) ^ ((uint64_t)rand() << 21) ^ (uint64_t)rand();
+}
+
+static int64_t random_timestamp(void)
+{
+    // Half over the whole range, half within 200 years of the epoch
+    if (rand() & 1)
+    {
+        return _TINYUTC_MIN_TIMESTAMP + (int64_t)(random_u64() % (uint64_t)(_TINYUTC_MAX_TIMESTAMP - _TINYUTC_MIN_TIMESTAMP + 1));
+    }
+    return (int64_t)(random_u64() % (uint64_t)(INT64_C(400) * 366 * 86400)) - INT64_C(200) * 366 * 86400;
+}
+
+static bool compare_with_tm(const struct TinyUTCTime *utc_tm, const struct tm *tm)
+{
+    return utc_tm->year == tm->tm_year + 1900 && utc_tm->month == tm->tm_mon + 1 && utc_tm->day == tm->tm_mday &&
+           utc_tm->hour == tm->tm_hour && utc_tm->minute == tm->tm_min && utc_tm->second == tm->tm_sec;
+}
+
+// Converts and checks one timestamp both ways, against the libc
+static int check_timestamp(int64_t ts, err_t expected_error)
+{
+    struct TinyUTCTime utc_tm = {0};
+    tinyutc_time_t back_ts = 0;
+    time_t libc_ts = (time_t)ts;
+    struct tm tm;
+    err_t error = tinyutc_unix_to_utc(&utc_tm, ts);
+
+    if (error != expected_error)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %lld : error %d, expected %d\n", (long long)ts, error, expected_error);
+        return 1;
+    }
+    if (error != 0)
+    {
+        return 0;
+    }
+
+    gmtime_r(&libc_ts, &tm);
+    tinyutc_utc_to_unix(&utc_tm, &back_ts);
+
+    if (!compare_with_tm(&utc_tm, &tm) || back_ts != ts || timegm(&tm) != libc_ts ||
+        tinyutc_unix_get_week_day(ts, true) != tm.tm_wday || tinyutc_get_week_day(&utc_tm, true) != tm.tm_wday)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %lld =/= %04d/%02d/%02d %02d:%02d:%02d\n", (long long)ts,
+               tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+        return 1;
+    }
+    return 0;
+}
+
+int test_cases_table()
+{
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++)
+    {
+        int failure = check_timestamp(test_cases[i].ts, test_cases[i].expected_error);
+
+        if (!failure)
+        {
+            printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Test '%03d' : %lld\n", (int)i + 1, (long long)test_cases[i].ts);
+        }
+        failures += failure;
+    }
+
+    // Dates out of the range
+    struct TinyUTCTime year_zero = {0, 12, 31, 23, 59, 59, 0};
+    tinyutc_time_t ts;
+    if (tinyutc_utc_to_unix(&year_zero, &ts) != -1)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Year 0 converted\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+int test_random()
+{
+    int failures = 0;
+
+    srand(1970);
+    for (int round = 0; round < RANDOM_ROUNDS && failures < 10; round++)
+    {
+        failures += check_timestamp(random_timestamp(), 0);
+
+        // Random dates, compared to timegm
+        struct tm tm = {0};
+        tm.tm_year = 1 + rand() % 65535 - 1900;
+        tm.tm_mon = rand() % 12;
+        tm.tm_mday = 1 + rand() % 28;
+        tm.tm_hour = rand() % 24;
+        tm.tm_min = rand() % 60;
+        tm.tm_sec = rand() % 60;
+
+        struct TinyUTCTime utc_tm = {tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec, 0};
+        tinyutc_time_t ts = 0;
+
+        if (tinyutc_utc_to_unix(&utc_tm, &ts) != 0 || ts != timegm(&tm))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %04d/%02d/%02d %02d:%02d:%02d =/= %lld\n", utc_tm.year, utc_tm.month, utc_tm.day,
+                   utc_tm.hour, utc_tm.minute, utc_tm.second, (long long)ts);
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random timestamps and dates\n", RANDOM_ROUNDS);
+    }
+
+    return failures;
+}
+
+int test_batch_and_cursor()
+{
+    struct TinyUTCColumns columns = {years, months, days, hours, minutes, seconds};
+    struct TinyUTCCursor cursor;
+    struct TinyUTCTime expected = {0};
+    struct TinyUTCTime current = {0};
+    int failures = 0;
+
+    // Consecutive timestamps across the epoch, then random ones
+    for (int i = 0; i < BATCH_SIZE / 2; i++)
+    {
+        timestamps[i] = (i - BATCH_SIZE / 4) * INT64_C(1000) + 7;
+    }
+    for (int i = BATCH_SIZE / 2; i < BATCH_SIZE; i++)
+    {
+        timestamps[i] = random_timestamp();
+    }
+
+    tinyutc_cursor_init(&cursor);
+    tinyutc_unix_to_utc_batch(times, timestamps, BATCH_SIZE);
+    tinyutc_unix_to_utc_batch_columns(&columns, timestamps, BATCH_SIZE);
+    tinyutc_unix_get_week_day_batch(week_days, timestamps, BATCH_SIZE, false);
+
+    if (tinyutc_utc_to_unix_batch(timestamps_back, times, BATCH_SIZE) != 0)
+    {
+        failures++;
+    }
+
+    for (int i = 0; i < BATCH_SIZE; i++)
+    {
+        tinyutc_unix_to_utc(&expected, timestamps[i]);
+        tinyutc_cursor_unix_to_utc(&cursor, &current, timestamps[i]);
+
+        if (times[i].year != expected.year || times[i].month != expected.month || times[i].day != expected.day ||
+            times[i].hour != expected.hour || times[i].minute != expected.minute || times[i].second != expected.second ||
+            years[i] != expected.year || months[i] != expected.month || days[i] != expected.day ||
+            hours[i] != expected.hour || minutes[i] != expected.minute || seconds[i] != expected.second ||
+            current.year != expected.year || current.month != expected.month || current.day != expected.day ||
+            current.hour != expected.hour || current.minute != expected.minute || current.second != expected.second ||
+            timestamps_back[i] != timestamps[i] || week_days[i] != tinyutc_get_week_day(&expected, false))
+        {
+            if (failures < 10)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch or cursor, index %d : %lld\n", i, (long long)timestamps[i]);
+            }
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Batches and cursor : %u hits, %u misses\n", cursor.hits, cursor.misses);
+    }
+
+    // Out of range timestamps are reported, and converted as the epoch
+    timestamps[0] = _TINYUTC_MAX_TIMESTAMP + 1;
+    timestamps[1] = INT64_MIN;
+    if (tinyutc_unix_to_utc_batch(times, timestamps, BATCH_SIZE) != -1 ||
+        tinyutc_unix_to_utc_batch_columns(&columns, timestamps, BATCH_SIZE) != -1 ||
+        times[0].year != 1970 || times[1].year != 1970 || years[0] != 1970 || years[1] != 1970 ||
+        times[2].year != years[2] || times[2].second != seconds[2])
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch unix to utc out of range\n");
+        failures++;
+    }
+
+    // The cursor can not carry past 65535-12-31, and is left on that day
+    tinyutc_cursor_init(&cursor);
+    if (tinyutc_cursor_unix_to_utc(&cursor, &current, _TINYUTC_MAX_TIMESTAMP) != 0 ||
+        tinyutc_cursor_unix_to_utc(&cursor, &current, _TINYUTC_MAX_TIMESTAMP + 1) != -1 ||
+        tinyutc_cursor_unix_to_utc(&cursor, &current, _TINYUTC_MAX_TIMESTAMP) != 0 || current.year != 65535 ||
+        current.month != 12 || current.day != 31 || current.second != 59)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Cursor past 65535-12-31\n");
+        failures++;
+    }
+
+    // Calendar arithmetic across the epoch, and down to year 1
+    struct TinyUTCTime utc_tm = {1970, 1, 1, 0, 0, 0, 0};
+    if (tinyutc_add_seconds(&utc_tm, -1) != 0 || utc_tm.year != 1969 || utc_tm.month != 12 || utc_tm.day != 31 || utc_tm.second != 59)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Adding -1 second to 1970-01-01\n");
+        failures++;
+    }
+    utc_tm = (struct TinyUTCTime){1, 1, 31, 0, 0, 0, 0};
+    if (tinyutc_add_days(&utc_tm, -30) != 0 || tinyutc_add_days(&utc_tm, -1) != -1 || tinyutc_add_months(&utc_tm, -1, TINYUTC_MONTH_CLAMP) != -1 ||
+        tinyutc_add_days(&utc_tm, 719162) != 0 || utc_tm.year != 1970 || utc_tm.month != 1 || utc_tm.day != 1)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Calendar arithmetic down to year 1\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+int main()
+{
+    int failures = test_cases_table();
+    failures += test_random();
+    failures += test_batch_and_cursor();
+
+    printf("Signed 64 bits timestamps: %d failures.\n", failures);
+    return failures != 0;
+}
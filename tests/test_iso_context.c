@@ -0,0 +1,226 @@
+/**
+ * @file test_iso_context.c
+ * @brief Test cases for the layout-learning ISO8601 parser context.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Blocks of random datetimes sharing a layout, some of them altered or with unusual
+ * values, are parsed with a context and compared to `tinyutc_parse_iso8601_datetimen`
+ * and `tinyutc_parse_iso8601_to_unix`, then days of increasing times check the reuse of
+ * the date, and the counters are checked on unaltered blocks.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define BLOCK_SIZE 2000
+
+// Layouts, with the fields in this order: year, month, day, hour, minute, second, fraction digit, offset hours, offset minutes.
+// Layouts without fraction take the offset hours from the fraction digit.
+static const char *layouts[] = {
+    "%04d-%02d-%02dT%02d:%02d:%02dZ",
+    "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ",
+    "%04d-%02d-%02d %02d:%02d:%02d.%03d+%02d:%02d",
+    "%04d-%02d-%02dT%02d:%02d:%02d,%01d-%02d%02d",
+    "%04d%02d%02dT%02d%02d%02d+%02d",
+    "%04d%02d%02dT%02d%02d%02d.%02d",
+    "%04d-%02d-%02d",
+    "%04d%02d%02d",
+    "%04d-W%02d-%dT%02d:%02d:%02dZ",
+    "%04d-%02d-%02dT%02d:%02d+%02d",
+    "%04d%02d%02dT%02d%02d+%02d",
+};
+
+static const char characters[] = "0123456789-:T .,Zz+";
+
+// Formats a random datetime, with the values in range most of the time
+static void random_datetime(char *str, const char *layout, bool is_altered)
+{
+    bool is_unusual = is_altered && rand() % 2;
+
+    sprintf(str, layout, 1970 + rand() % 130, 1 + rand() % (is_unusual ? 13 : 12), 1 + rand() % (is_unusual ? 31 : 28),
+            rand() % (is_unusual ? 25 : 24), rand() % 60, rand() % (is_unusual ? 61 : 60), rand() % 10, rand() % 24, rand() % 60);
+
+    if (is_altered && !is_unusual)
+    {
+        str[rand() % strlen(str)] = characters[rand() % (sizeof(characters) - 1)];
+    }
+}
+
+// Week dates, and times without seconds, are never learnt
+static bool is_learnable(const char *layout)
+{
+    const char *time = strpbrk(layout, "T ");
+
+    if (strchr(layout, 'W'))
+    {
+        return false;
+    }
+    return time == NULL || strncmp(time + 1, "%02d:%02d:%02d", 14) == 0 || strncmp(time + 1, "%02d%02d%02d", 12) == 0;
+}
+
+// Compares a datetime parsed with the contexts, to a structure and to a timestamp, with the generic parsers
+static int check_datetime(struct TinyUTCIsoContext *context, struct TinyUTCIsoContext *unix_context, const char *str)
+{
+    struct TinyUTCTime expected = {0};
+    struct TinyUTCTime parsed = {0};
+    tinyutc_time_t expected_ts = 0, ts = 0;
+    uint32_t expected_micros = 0, micros = 0;
+
+    int expected_result = tinyutc_parse_iso8601_datetimen(&expected, str, strlen(str), NULL, true);
+    int result = tinyutc_iso_context_parse(context, &parsed, str, strlen(str));
+
+    if (result != expected_result || (result == TINYUTC_ISO8601_OK && !compare_utc_structs_datetimes(&parsed, &expected)))
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : %s, expected %s\n", str, get_err_string(result),
+               get_err_string(expected_result));
+        return 1;
+    }
+
+    expected_result = tinyutc_parse_iso8601_to_unix(str, &expected_ts, &expected_micros);
+    result = tinyutc_iso_context_parse_to_unix(unix_context, str, strlen(str), &ts, &micros);
+
+    if (result != expected_result || (result == TINYUTC_ISO8601_OK && (ts != expected_ts || micros != expected_micros)))
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : %s %lld, expected %s %lld\n", str, get_err_string(result), (long long)ts,
+               get_err_string(expected_result), (long long)expected_ts);
+        return 1;
+    }
+    return 0;
+}
+
+int test_against_generic()
+{
+    struct TinyUTCIsoContext context, unix_context;
+    char str[64];
+    int failures = 0;
+
+    srand(1970);
+    tinyutc_iso_context_init(&context, true);
+    tinyutc_iso_context_init(&unix_context, true);
+
+    for (int round = 0; round < 50; round++)
+    {
+        const char *layout = layouts[rand() % (sizeof(layouts) / sizeof(layouts[0]))];
+
+        for (int i = 0; i < BLOCK_SIZE && failures < 10; i++)
+        {
+            random_datetime(str, layout, rand() % 10 == 0);
+            failures += check_datetime(&context, &unix_context, str);
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Same results as the generic parser, %u hits, %u misses\n", context.hits,
+               context.misses);
+    }
+    return failures;
+}
+
+int test_counters()
+{
+    struct TinyUTCIsoContext context;
+    struct TinyUTCTime parsed = {0};
+    char str[64];
+    int failures = 0;
+
+    // Not strict, for the space separator
+    tinyutc_iso_context_init(&context, false);
+
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++)
+    {
+        // Only the first datetime of a learnable layout misses
+        uint32_t expected_misses = is_learnable(layouts[l]) ? 1 : BLOCK_SIZE;
+
+        context.hits = 0;
+        context.misses = 0;
+        for (int i = 0; i < BLOCK_SIZE; i++)
+        {
+            random_datetime(str, layouts[l], false);
+            tinyutc_iso_context_parse(&context, &parsed, str, strlen(str));
+        }
+
+        if (context.misses != expected_misses || context.hits + context.misses != BLOCK_SIZE)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : %u hits, %u misses, expected %u misses\n", str, context.hits,
+                   context.misses, expected_misses);
+            failures++;
+        }
+        else
+        {
+            printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t '%s' : %u hits, %u misses\n", str, context.hits, context.misses);
+        }
+    }
+    return failures;
+}
+
+// Increasing times, a few days in a row, around the end of a year and of the range of the timestamps
+int test_same_day()
+{
+    static const char *layouts[] = {"%04d-%02d-%02dT%02d:%02d:%02d.%06d-05:30", "%04d%02d%02dT%02d%02d%02d,%06dZ"};
+    static const struct TinyUTCTime starts[] = {{1999, 12, 30, 0, 0, 0, 0}, {1970, 1, 1, 0, 0, 0, 0}, {2106, 2, 6, 0, 0, 0, 0}};
+    struct TinyUTCIsoContext context, unix_context;
+    char str[64];
+    int failures = 0;
+
+    for (size_t l = 0; l < sizeof(layouts) / sizeof(layouts[0]); l++)
+    {
+        for (size_t d = 0; d < sizeof(starts) / sizeof(starts[0]); d++)
+        {
+            struct TinyUTCTime day = starts[d];
+            uint32_t lines = 0;
+
+            tinyutc_iso_context_init(&context, true);
+            tinyutc_iso_context_init(&unix_context, true);
+
+            for (int i = 0; i < 3 && failures < 10; i++)
+            {
+                for (int32_t secs = 0; secs < 86400; secs += 1 + rand() % 120, lines++)
+                {
+                    sprintf(str, layouts[l], day.year, day.month, day.day, secs / 3600, secs / 60 % 60, secs % 60, rand() % 1000000);
+                    failures += check_datetime(&context, &unix_context, str);
+                }
+                tinyutc_add_days(&day, 1);
+            }
+
+            // Only the first line of each day parses the date, the very first one going through the generic parser,
+            // as well as the times past the range of the timestamps
+            if (context.prefix_hits + 3 != lines || (context.misses != 1 && starts[d].year < 2106))
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : %u lines, %u days reused, %u misses\n", str, lines,
+                       context.prefix_hits, context.misses);
+                failures++;
+            }
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Same day datetimes reuse the date\n");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_against_generic();
+    failures += test_same_day();
+    failures += test_counters();
+
+    printf("Parsing with a context: %d failures.\n", failures);
+}
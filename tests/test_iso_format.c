@@ -0,0 +1,277 @@
+/**
+ * @file test_iso_format.c
+ * @brief Test cases for the ISO8601 formatter.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Random structures and timestamps are formatted with every combination of flags,
+ * and compared to `snprintf`. Datetimes with an offset are parsed back to their
+ * timestamp, batches are compared to single calls, and buffers too small or
+ * values out of range must be rejected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_formatter.h"
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define DATETIMES 100000
+#define BATCH_SIZE 1000
+#define ALL_FLAGS 0x40
+
+// Formats with snprintf, the same way the flags do
+static void reference(char *buf, const struct TinyUTCTime *local, int32_t utc_offset, uint32_t flags)
+{
+    bool basic = flags & TINYUTC_FORMAT_BASIC;
+    char separator = flags & TINYUTC_FORMAT_SPACE ? ' ' : 'T';
+    int len = sprintf(buf, basic ? "%04u%02u%02u%c%02u%02u%02u" : "%04u-%02u-%02u%c%02u:%02u:%02u", local->year, local->month,
+                      local->day, separator, local->hour, local->minute, local->second);
+
+    if (flags & TINYUTC_FORMAT_MICROSECONDS)
+    {
+        len += sprintf(buf + len, ".%06u", local->microseconds);
+    }
+    else if (flags & TINYUTC_FORMAT_MILLISECONDS)
+    {
+        len += sprintf(buf + len, ".%03u", local->microseconds / 1000);
+    }
+
+    if ((flags & TINYUTC_FORMAT_OFFSET) || ((flags & TINYUTC_FORMAT_ZULU) && utc_offset != 0))
+    {
+        int32_t minutes = abs(utc_offset) / 60;
+        sprintf(buf + len, basic ? "%c%02d%02d" : "%c%02d:%02d", utc_offset < 0 ? '-' : '+', minutes / 60, minutes % 60);
+    }
+    else if (flags & TINYUTC_FORMAT_ZULU)
+    {
+        sprintf(buf + len, "Z");
+    }
+}
+
+static int check(const char *what, const char *result, size_t len, const char *expected)
+{
+    if (len != strlen(expected) || strcmp(result, expected) != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %s: '%s' (%zu), expected '%s'\n", what, result, len, expected);
+        return 1;
+    }
+    return 0;
+}
+
+int test_structures()
+{
+    struct TinyUTCTime utc_tm;
+    char result[TINYUTC_FORMAT_MAX_SIZE], expected[64];
+    int failures = 0;
+
+    srand(1970);
+    for (int i = 0; i < DATETIMES && failures < 10; i++)
+    {
+        utc_tm.year = rand() % 10000;
+        utc_tm.month = 1 + rand() % 12;
+        utc_tm.day = 1 + rand() % 31;
+        utc_tm.hour = rand() % 24;
+        utc_tm.minute = rand() % 60;
+        utc_tm.second = rand() % 61;
+        utc_tm.microseconds = rand() % 1000000;
+
+        for (uint32_t flags = 0; flags < ALL_FLAGS; flags++)
+        {
+            size_t len = tinyutc_format_iso8601(&utc_tm, result, sizeof(result), flags);
+
+            reference(expected, &utc_tm, 0, flags);
+            failures += check("Structure", result, len, expected);
+
+            // Exactly the size needed, then one byte less
+            if (tinyutc_format_iso8601(&utc_tm, result, strlen(expected) + 1, flags) != strlen(expected) ||
+                tinyutc_format_iso8601(&utc_tm, result, strlen(expected), flags) != 0)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Buffer size check for '%s'\n", expected);
+                failures++;
+            }
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random structures, with every flag\n", DATETIMES);
+    }
+    return failures;
+}
+
+int test_timestamps()
+{
+    struct TinyUTCTime local;
+    char result[TINYUTC_FORMAT_MAX_SIZE], expected[64];
+    tinyutc_time_t unix_ts, parsed;
+    uint32_t micros, parsed_micros;
+    int failures = 0;
+
+    srand(2038);
+    for (int i = 0; i < DATETIMES && failures < 10; i++)
+    {
+        // Offsets of whole minutes, within a day
+        int32_t utc_offset = (rand() % (2 * 24 * 60 - 1) - (24 * 60 - 1)) * 60;
+
+        unix_ts = (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+        micros = rand() % 1000000;
+        if (rand() % 4 == 0)
+        {
+            utc_offset = 0;
+        }
+
+        if (tinyutc_unix_to_utc(&local, unix_ts) != 0 || tinyutc_add_seconds(&local, utc_offset) != 0)
+        {
+            // Local time before 1970
+            if (tinyutc_format_unix_iso8601(unix_ts, micros, utc_offset, result, sizeof(result), 0) != 0)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %lld%+d should be out of range\n", (long long)unix_ts, utc_offset);
+                failures++;
+            }
+            continue;
+        }
+        local.microseconds = micros;
+
+        for (uint32_t flags = 0; flags < ALL_FLAGS; flags++)
+        {
+            size_t len = tinyutc_format_unix_iso8601(unix_ts, micros, utc_offset, result, sizeof(result), flags);
+
+            reference(expected, &local, utc_offset, flags);
+            failures += check("Timestamp", result, len, expected);
+        }
+
+        // With an offset, the datetime is back to the same timestamp
+        tinyutc_format_unix_iso8601(unix_ts, micros, utc_offset, result, sizeof(result), TINYUTC_FORMAT_ZULU | TINYUTC_FORMAT_MICROSECONDS);
+        if (tinyutc_parse_iso8601_to_unix(result, &parsed, &parsed_micros) != TINYUTC_ISO8601_OK || parsed != unix_ts ||
+            parsed_micros != micros)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' parsed to %lld.%06u, expected %lld.%06u\n", result, (long long)parsed,
+                   parsed_micros, (long long)unix_ts, micros);
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random timestamps and offsets, with every flag\n", DATETIMES);
+    }
+    return failures;
+}
+
+int test_batch()
+{
+    static tinyutc_time_t unix_ts[BATCH_SIZE];
+    static uint32_t micros[BATCH_SIZE];
+    static char records[BATCH_SIZE][TINYUTC_FORMAT_MAX_SIZE];
+    char expected[TINYUTC_FORMAT_MAX_SIZE];
+    const int32_t offsets[] = {0, 3600, -(5 * 3600 + 30 * 60)};
+    int failures = 0;
+
+    // Increasing timestamps, crossing days, with a jump back and one out of range
+    unix_ts[0] = 1700000000;
+    for (int i = 1; i < BATCH_SIZE; i++)
+    {
+        unix_ts[i] = unix_ts[i - 1] + rand() % 600;
+        micros[i] = rand() % 1000000;
+    }
+    unix_ts[BATCH_SIZE / 2] = 86400 * 365;
+    unix_ts[BATCH_SIZE / 3] = 0;
+
+    for (size_t o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++)
+    {
+        uint32_t flags = TINYUTC_FORMAT_MILLISECONDS | TINYUTC_FORMAT_ZULU;
+        size_t formatted = tinyutc_format_unix_iso8601_batch(records[0], sizeof(records[0]), unix_ts, micros, BATCH_SIZE, offsets[o], flags);
+        size_t expected_count = 0;
+
+        for (int i = 0; i < BATCH_SIZE; i++)
+        {
+            size_t len = tinyutc_format_unix_iso8601(unix_ts[i], micros[i], offsets[o], expected, sizeof(expected), flags);
+
+            expected_count += len != 0;
+            if (strcmp(records[i], len != 0 ? expected : "") != 0)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch record %d: '%s', expected '%s'\n", i, records[i], expected);
+                failures++;
+            }
+        }
+
+        if (formatted != expected_count || (!_TINYUTC_TIME_IS_SIGNED && offsets[o] < 0 && formatted != BATCH_SIZE - 1))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Batch with offset %d: %zu formatted, expected %zu\n", offsets[o], formatted,
+                   expected_count);
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Batches match single calls\n");
+    }
+    return failures;
+}
+
+int test_rejected()
+{
+    struct TinyUTCTime bad_year = {10000, 1, 1, 0, 0, 0, 0};
+    struct TinyUTCTime bad_month = {2024, 13, 1, 0, 0, 0, 0};
+    struct TinyUTCTime bad_hour = {2024, 1, 1, 24, 0, 0, 0};
+    struct TinyUTCTime bad_micros = {2024, 1, 1, 0, 0, 0, 1000000};
+    char result[TINYUTC_FORMAT_MAX_SIZE];
+    int failures = 0;
+
+    if (tinyutc_format_iso8601(&bad_year, result, sizeof(result), 0) != 0 ||
+        tinyutc_format_iso8601(&bad_month, result, sizeof(result), 0) != 0 ||
+        tinyutc_format_iso8601(&bad_hour, result, sizeof(result), 0) != 0 ||
+        tinyutc_format_iso8601(&bad_micros, result, sizeof(result), TINYUTC_FORMAT_MICROSECONDS) != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Structures out of range should be rejected\n");
+        failures++;
+    }
+
+    if (tinyutc_format_unix_iso8601(0, 0, 30, result, sizeof(result), 0) != 0 ||
+        tinyutc_format_unix_iso8601(0, 0, 24 * 3600, result, sizeof(result), 0) != 0 ||
+        tinyutc_format_unix_iso8601(0, 0, 23 * 3600 + 59 * 60, result, sizeof(result), TINYUTC_FORMAT_OFFSET) != 25 ||
+        tinyutc_format_unix_iso8601_batch(result, 20, 0, 0, 0, 0, TINYUTC_FORMAT_ZULU) != 0)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Offsets out of range should be rejected\n");
+        failures++;
+    }
+
+    // The offset is not added to the ends of 64 bits timestamps, which would overflow
+    if (_TINYUTC_TIME_IS_SIGNED && sizeof(tinyutc_time_t) == sizeof(int64_t) &&
+        (tinyutc_format_unix_iso8601((tinyutc_time_t)INT64_MAX, 0, 3600, result, sizeof(result), 0) != 0 ||
+         tinyutc_format_unix_iso8601((tinyutc_time_t)INT64_MIN, 0, -3600, result, sizeof(result), 0) != 0))
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Timestamps out of range should be rejected\n");
+        failures++;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Values out of range are rejected\n");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_structures();
+    failures += test_timestamps();
+    failures += test_batch();
+    failures += test_rejected();
+
+    printf("ISO8601 formatting: %d failures.\n", failures);
+    return failures != 0;
+}
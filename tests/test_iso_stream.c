@@ -0,0 +1,178 @@
+/**
+ * @file test_iso_stream.c
+ * @brief Test cases for the resumable streaming ISO8601 parser.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Random datetimes in every layout, then altered, truncated or extended one character
+ * at a time, are fed to the stream and compared to `tinyutc_parse_iso8601_datetime`,
+ * error codes included.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define DATETIMES 200000
+
+static const char characters[] = "0123456789-:T .,Zz+W\r";
+
+// Alters a datetime: a character replaced, inserted, removed, or the string truncated
+static void alter(char *str)
+{
+    size_t len = strlen(str);
+    size_t pos = len ? (size_t)rand() % len : 0;
+
+    switch (rand() % 5)
+    {
+    case 0:
+        str[pos] = characters[rand() % (sizeof(characters) - 1)];
+        break;
+    case 1:
+        memmove(str + pos + 1, str + pos, len - pos + 1);
+        str[pos] = characters[rand() % (sizeof(characters) - 1)];
+        break;
+    case 2:
+        memmove(str + pos, str + pos + 1, len - pos);
+        break;
+    case 3:
+        str[pos] = '\0';
+        break;
+    default:
+        break; // Left untouched
+    }
+}
+
+static int check_stream(struct TinyUTCIsoStream *stream, const char *str, bool use_strict_separator)
+{
+    struct TinyUTCTime expected = {0};
+    struct TinyUTCTime streamed = {0};
+    int expected_result, result = TINYUTC_ISO8601_IN_PROGRESS;
+
+    // The terminator must not appear in the datetime
+    expected_result = tinyutc_parse_iso8601_datetime(&expected, str, use_strict_separator);
+
+    for (const char *c = str; *c != '\0'; c++)
+    {
+        if (tinyutc_iso_feed(stream, *c, &streamed) != TINYUTC_ISO8601_IN_PROGRESS)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : finished before the terminator\n", str);
+            return 1;
+        }
+    }
+    result = tinyutc_iso_feed(stream, '\n', &streamed);
+
+    if (result != expected_result || (result == TINYUTC_ISO8601_OK && !compare_utc_structs_datetimes(&streamed, &expected)))
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s'%s : %s, expected %s\n", str, use_strict_separator ? "" : " (not strict)",
+               get_err_string(result), get_err_string(expected_result));
+        return 1;
+    }
+    return 0;
+}
+
+int test_random(bool use_strict_separator)
+{
+    struct TinyUTCIsoStream stream;
+    char str[64];
+    int failures = 0;
+
+    srand(1970);
+    tinyutc_iso_stream_init(&stream, '\n', use_strict_separator);
+
+    for (int i = 0; i < DATETIMES && failures < 10; i++)
+    {
+        random_iso8601_datetime(str, 1970, 130);
+        for (int alterations = rand() % 3; alterations > 0; alterations--)
+        {
+            alter(str);
+        }
+        // A '\r' right before the terminator is dropped by the stream
+        size_t len = strlen(str);
+        if (len > 0 && str[len - 1] == '\r')
+        {
+            str[len - 1] = 'x';
+        }
+        failures += check_stream(&stream, str, use_strict_separator);
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random datetimes%s\n", DATETIMES, use_strict_separator ? "" : " (not strict)");
+    }
+    return failures;
+}
+
+// Several lines in chunks, with CRLF endings and an invalid line in between
+int test_chunks()
+{
+    const char input[] = "2024-02-29T17:05:03Z\r\n2024-13-30T17:05:03Z\r\n2000W037T01:23:45,5-0130\n\r\n1989365";
+    const struct TinyUTCTime expected[] = {{2024, 2, 29, 17, 5, 3, 0}, {0}, {2000, 1, 23, 2, 53, 45, 500000}, {0}, {1989, 12, 31, 0, 0, 0, 0}};
+    const int expected_results[] = {TINYUTC_ISO8601_OK, TINYUTC_ISO8601_INVALID_DATE, TINYUTC_ISO8601_OK, TINYUTC_ISO8601_EMPTY_STRING,
+                                    TINYUTC_ISO8601_IN_PROGRESS};
+    struct TinyUTCIsoStream stream;
+    int failures = 0;
+
+    for (size_t chunk_len = 1; chunk_len <= sizeof(input); chunk_len++)
+    {
+        struct TinyUTCTime utc_tm = {0};
+        size_t pos = 0, count = 0, len = sizeof(input) - 1;
+        err_t result = TINYUTC_ISO8601_IN_PROGRESS;
+
+        tinyutc_iso_stream_init(&stream, '\n', true);
+        while (pos < len)
+        {
+            size_t available = len - pos < chunk_len ? len - pos : chunk_len;
+            size_t consumed = tinyutc_iso_feedn(&stream, input + pos, available, &utc_tm, &result);
+
+            pos += consumed;
+            if (result != TINYUTC_ISO8601_IN_PROGRESS)
+            {
+                if (result != expected_results[count] ||
+                    (result == TINYUTC_ISO8601_OK && !compare_utc_structs_datetimes(&utc_tm, &expected[count])))
+                {
+                    printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Chunks of %zu, line %zu : %s, expected %s\n", chunk_len, count,
+                           get_err_string(result), get_err_string(expected_results[count]));
+                    failures++;
+                }
+                count++;
+            }
+        }
+
+        // The last line waits for its terminator
+        if (count != 4 || result != TINYUTC_ISO8601_IN_PROGRESS ||
+            tinyutc_iso_feed(&stream, '\n', &utc_tm) != TINYUTC_ISO8601_OK || !compare_utc_structs_datetimes(&utc_tm, &expected[4]))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Chunks of %zu : %zu lines\n", chunk_len, count);
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Lines fed in chunks of every size\n");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_random(true);
+    failures += test_random(false);
+    failures += test_chunks();
+
+    printf("Streaming parsing: %d failures.\n", failures);
+}
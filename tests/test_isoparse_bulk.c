@@ -0,0 +1,125 @@
+/**
+ * @file test_isoparse_bulk.c
+ * @brief Test cases for bulk ISO8601 parsing of delimiter-separated buffers.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * A buffer of random records, valid or not, is parsed in random sized chunks, each
+ * one starting where the previous call stopped: every record must give the same
+ * result as `tinyutc_parse_iso8601_to_unix`. Chunks are copied to buffers of their
+ * exact length: build with -fsanitize=address to catch any read past the end.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define RECORDS 100000
+#define RECORD_SIZE 48
+
+static char records[RECORDS][RECORD_SIZE];
+static char buffer[RECORDS * RECORD_SIZE];
+static tinyutc_time_t timestamps[RECORDS];
+static uint32_t micros[RECORDS];
+static err_t errors[RECORDS];
+
+// Formats a random record, canonical most of the time
+static void random_record(char *str)
+{
+    static const char *offsets[] = {"Z", "Z", "Z", "+00:00", "-0130", ""};
+
+    switch (rand() % 8)
+    {
+    case 0: // Empty record
+        str[0] = '\0';
+        break;
+    case 1: // Invalid record
+        sprintf(str, "%04d-%02d-%02dT%02d:%02d:%02dZ", rand() % 10000, rand() % 100, rand() % 100, rand() % 100, rand() % 100, rand() % 100);
+        break;
+    case 2: // Date only, or another layout
+        sprintf(str, rand() % 2 ? "%04d-%02d-%02d" : "%04d%02d%02dT000000Z", 1970 + rand() % 130, 1 + rand() % 12, 1 + rand() % 28);
+        break;
+    default:
+        sprintf(str, "%04d-%02d-%02dT%02d:%02d:%02d%s%s", 1970 + rand() % 130, 1 + rand() % 12, 1 + rand() % 28, rand() % 24,
+                rand() % 60, rand() % 60, rand() % 2 ? ".123456" : "", offsets[rand() % 6]);
+        break;
+    }
+}
+
+int test_delimiter(char delimiter, bool use_crlf)
+{
+    size_t len = 0, pos = 0, count = 0;
+    int failures = 0;
+
+    srand(1970);
+    for (int i = 0; i < RECORDS - 1; i++)
+    {
+        random_record(records[i]);
+        len += snprintf(buffer + len, sizeof(buffer) - len, "%s%s%c", records[i], use_crlf ? "\r" : "", delimiter);
+    }
+    // The last record ends the input, without delimiter, so it cannot be empty
+    strcpy(records[RECORDS - 1], "2024-02-29T17:05:03Z");
+    len += snprintf(buffer + len, sizeof(buffer) - len, "%s", records[RECORDS - 1]);
+
+    while (pos < len)
+    {
+        size_t chunk_len = (size_t)(rand() % 4096);
+        size_t parsed = 0;
+
+        if (chunk_len > len - pos)
+        {
+            chunk_len = len - pos;
+        }
+
+        char *chunk = malloc(chunk_len ? chunk_len : 1);
+        memcpy(chunk, buffer + pos, chunk_len);
+        pos += tinyutc_parse_iso8601_bulk(timestamps + count, micros + count, errors + count, RECORDS - count, &parsed, chunk,
+                                          chunk_len, delimiter, pos + chunk_len == len);
+        count += parsed;
+        free(chunk);
+    }
+
+    for (int i = 0; i < RECORDS && failures < 10; i++)
+    {
+        tinyutc_time_t expected_ts = 0;
+        uint32_t expected_micros = 0;
+
+        int expected_result = tinyutc_parse_iso8601_to_unix(records[i], &expected_ts, &expected_micros);
+        if (errors[i] != expected_result ||
+            (expected_result == TINYUTC_ISO8601_OK && (timestamps[i] != expected_ts || micros[i] != expected_micros)))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Record %d '%s' : %s %lld, expected %s %lld\n", i, records[i],
+                   get_err_string(errors[i]), (long long)timestamps[i], get_err_string(expected_result), (long long)expected_ts);
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Delimiter '%s'%s : %d records\n", delimiter == '\n' ? "\\n" : ",",
+               use_crlf ? ", CRLF" : "", RECORDS);
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_delimiter('\n', false);
+    failures += test_delimiter('\n', true);
+    failures += test_delimiter(',', false);
+
+    printf("Bulk parsing: %d failures.\n", failures);
+}
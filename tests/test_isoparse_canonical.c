@@ -0,0 +1,124 @@
+/**
+ * @file test_isoparse_canonical.c
+ * @brief Test cases for the fast path of the canonical "YYYY-MM-DDTHH:MM:SS[.ffffff]Z" layout.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * The same datetimes ending with "+00:00" instead of 'Z' are not canonical, and go
+ * through the generic parser: both must give the same results, for random fields
+ * (out of range ones included) and for random characters replacing one of them.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define RANDOM_ROUNDS 1000000
+
+// Formats random fields, with 'Z' and with "+00:00", returns the length of the canonical one
+static size_t random_datetime(char *canonical, char *generic)
+{
+    static const char *fractions[] = {"", ".000000", ".123456", ".999999"};
+    int year = rand() % 4 ? 1970 + rand() % 140 : rand() % 10000;
+    int month = rand() % 4 ? 1 + rand() % 12 : rand() % 100;
+    int day = rand() % 4 ? 1 + rand() % 28 : rand() % 100;
+    int hour = rand() % 4 ? rand() % 24 : rand() % 100;
+    int minute = rand() % 4 ? rand() % 60 : rand() % 100;
+    int second = rand() % 4 ? rand() % 60 : rand() % 100;
+    const char *fraction = fractions[rand() % 4];
+
+    sprintf(generic, "%04d-%02d-%02dT%02d:%02d:%02d%s+00:00", year, month, day, hour, minute, second, fraction);
+    return sprintf(canonical, "%04d-%02d-%02dT%02d:%02d:%02d%sZ", year, month, day, hour, minute, second, fraction);
+}
+
+static int compare(const char *canonical, size_t canonical_len, const char *generic, size_t generic_len)
+{
+    struct TinyUTCTime fast = {0};
+    struct TinyUTCTime reference = {0};
+    size_t consumed = 0;
+
+    int fast_result = tinyutc_parse_iso8601_datetimen(&fast, canonical, canonical_len, NULL, true);
+    int reference_result = tinyutc_parse_iso8601_datetimen(&reference, generic, generic_len, NULL, true);
+
+    // The canonical layout ends with 'Z', the generic one with an offset that may be truncated
+    if (fast_result == TINYUTC_ISO8601_INVALID_OFFSET || reference_result == TINYUTC_ISO8601_INVALID_OFFSET ||
+        fast_result == TINYUTC_ISO8601_INVALID_FORMAT || reference_result == TINYUTC_ISO8601_INVALID_FORMAT)
+    {
+        return 0;
+    }
+
+    if (fast_result != reference_result ||
+        (fast_result == TINYUTC_ISO8601_OK && !compare_utc_structs_datetimes(&fast, &reference)) ||
+        (fast_result == TINYUTC_ISO8601_OK &&
+         (tinyutc_parse_iso8601_datetimen(&reference, canonical, canonical_len, &consumed, true) != TINYUTC_ISO8601_OK || consumed != canonical_len)))
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%.*s' : %s, '%.*s' : %s\n", (int)canonical_len, canonical, get_err_string(fast_result),
+               (int)generic_len, generic, get_err_string(reference_result));
+        return 1;
+    }
+    return 0;
+}
+
+int test_random_fields()
+{
+    char canonical[64], generic[64];
+    int failures = 0;
+
+    for (int round = 0; round < RANDOM_ROUNDS && failures < 10; round++)
+    {
+        size_t len = random_datetime(canonical, generic);
+        failures += compare(canonical, len, generic, strlen(generic));
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random datetimes\n", RANDOM_ROUNDS);
+    }
+    return failures;
+}
+
+int test_random_characters()
+{
+    char canonical[64], generic[64];
+    int failures = 0;
+
+    for (int round = 0; round < RANDOM_ROUNDS && failures < 10; round++)
+    {
+        size_t len = random_datetime(canonical, generic);
+        size_t position = rand() % (len - 1); // Not the 'Z'
+        char c = (char)(rand() % 256);
+
+        canonical[position] = c;
+        generic[position] = c;
+        failures += compare(canonical, len, generic, strlen(generic + len - 1) + len - 1);
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random characters\n", RANDOM_ROUNDS);
+    }
+    return failures;
+}
+
+int main()
+{
+    srand(1970);
+
+    int failures = test_random_fields();
+    failures += test_random_characters();
+
+    printf("Canonical datetimes: %d failures.\n", failures);
+}
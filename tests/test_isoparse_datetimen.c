@@ -0,0 +1,145 @@
+/**
+ * @file test_isoparse_datetimen.c
+ * @brief Test cases for ISO8601 datetime parsing out of strings of known length
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Strings are copied to buffers of their exact length, without a null terminator:
+ * build with -fsanitize=address to catch any read past the end.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+struct DatetimenTestCase
+{
+    const char *description;
+    const char *buffer;
+    size_t expected_consumed;
+    struct TinyUTCTime expected;
+    int expected_code;
+};
+
+struct DatetimenTestCase test_cases[] = {
+    {"Zulu time, end of buffer", "2024-02-29T17:05:03Z", 20, {2024, 02, 29, 17, 05, 03, 0}, TINYUTC_ISO8601_OK},
+    {"Log line", "2024-02-29T17:05:03Z INFO started", 20, {2024, 02, 29, 17, 05, 03, 0}, TINYUTC_ISO8601_OK},
+    {"Log line, microseconds & offset", "2000-023T01:23:45.111111+11:00|next", 30, {2000, 01, 22, 14, 23, 45, 111111}, TINYUTC_ISO8601_OK},
+    {"Log line, no time separator", "20250102T175503 x", 15, {2025, 01, 02, 17, 55, 03, 0}, TINYUTC_ISO8601_OK},
+    {"Log line, partial time", "1972-12-31T17:05 x", 16, {1972, 12, 31, 17, 05, 00, 0}, TINYUTC_ISO8601_OK},
+    {"Log line, offset +hh", "1972-12-31T17:05:03+01 x", 22, {1972, 12, 31, 16, 05, 03, 0}, TINYUTC_ISO8601_OK},
+    {"Date only, then text", "2024-02-29 T", 10, {2024, 02, 29, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Date only, then a T without time", "2024-02-29Tx", 10, {2024, 02, 29, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Week date, then newline", "2000-W03-7T01:23:45\n", 19, {2000, 01, 23, 01, 23, 45, 0}, TINYUTC_ISO8601_OK},
+    {"Truncated offset", "1972-12-31T17:05:03+00:1", 0, {0}, TINYUTC_ISO8601_INVALID_OFFSET},
+    {"Truncated date", "2024-02-2", 0, {0}, TINYUTC_ISO8601_INVALID_DATE},
+    {"Truncated time", "2024-02-29T1", 0, {0}, TINYUTC_ISO8601_INVALID_TIME},
+    {"Fraction too long", "2000-100T01:23:45.7777777 x", 0, {0}, TINYUTC_ISO8601_TIME_FRACTION_TOO_LONG},
+    {"Fraction without digits", "2000-100T01:23:45. x", 0, {0}, TINYUTC_ISO8601_INVALID_TIME},
+    {"Inconsistent time separator", "2026-07-08T1705:03Z", 0, {0}, TINYUTC_ISO8601_INCONSISTENT_TIME_SEPARATOR},
+};
+
+// Copies a string to a buffer of its exact length, without null terminator
+static char *exact_copy(const char *str, size_t len)
+{
+    char *buffer = malloc(len ? len : 1);
+    memcpy(buffer, str, len);
+    return buffer;
+}
+
+int test_cases_table()
+{
+    struct TinyUTCTime utc_tm = {0};
+    int failures = 0;
+
+    for (int i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++)
+    {
+        size_t len = strlen(test_cases[i].buffer);
+        char *buffer = exact_copy(test_cases[i].buffer, len);
+        size_t consumed = 0;
+
+        int parse_result = tinyutc_parse_iso8601_datetimen(&utc_tm, buffer, len, &consumed, true);
+        if (parse_result != test_cases[i].expected_code ||
+            (parse_result == TINYUTC_ISO8601_OK &&
+             (consumed != test_cases[i].expected_consumed || !compare_utc_structs_datetimes(&utc_tm, &test_cases[i].expected))))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Test '%s': %s : code %s, %zu characters consumed\n", test_cases[i].description,
+                   test_cases[i].buffer, get_err_string(parse_result), consumed);
+            failures++;
+        }
+        else
+        {
+            printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Test '%s' => %s\n", test_cases[i].description, get_err_string(parse_result));
+        }
+        free(buffer);
+    }
+
+    return failures;
+}
+
+// Every prefix of a datetime, parsed as a whole, gives the same result as the null-terminated version
+int test_prefixes()
+{
+    const char *datetimes[] = {
+        "2000-023T01:23:45.111111+11:00",
+        "2000W037T01:23:45,5-0130",
+        "1989365T012345Z",
+        "2025-01-02T24:00:00Z",
+    };
+    struct TinyUTCTime bounded = {0};
+    struct TinyUTCTime terminated = {0};
+    char prefix[64];
+    int failures = 0;
+
+    for (int i = 0; i < sizeof(datetimes) / sizeof(datetimes[0]); i++)
+    {
+        size_t len = strlen(datetimes[i]);
+
+        for (size_t prefix_len = 0; prefix_len <= len; prefix_len++)
+        {
+            char *buffer = exact_copy(datetimes[i], prefix_len);
+            memcpy(prefix, datetimes[i], prefix_len);
+            prefix[prefix_len] = '\0';
+
+            int bounded_result = tinyutc_parse_iso8601_datetimen(&bounded, buffer, prefix_len, NULL, true);
+            int terminated_result = tinyutc_parse_iso8601_datetime(&terminated, prefix, true);
+
+            if (bounded_result != terminated_result ||
+                (bounded_result == TINYUTC_ISO8601_OK && !compare_utc_structs_datetimes(&bounded, &terminated)))
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Prefix '%s' : %s, null-terminated %s\n", prefix,
+                       get_err_string(bounded_result), get_err_string(terminated_result));
+                failures++;
+            }
+            free(buffer);
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Every prefix matches the null-terminated parser\n");
+    }
+
+    return failures;
+}
+
+int main()
+{
+    int failures = test_cases_table();
+    failures += test_prefixes();
+
+    printf("Bounded datetime parsing: %d failures.\n", failures);
+}
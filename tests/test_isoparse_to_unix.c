@@ -0,0 +1,148 @@
+/**
+ * @file test_isoparse_to_unix.c
+ * @brief Test cases for ISO8601 datetime parsing straight to Unix timestamps.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Timestamps must be the ones of `tinyutc_parse_iso8601_datetime` followed by
+ * `tinyutc_utc_to_unix`, for a table of datetimes and for random ones.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define RANDOM_ROUNDS 1000000
+
+struct ToUnixTestCase
+{
+    const char *description;
+    const char *iso8601;
+    tinyutc_time_t expected_ts;
+    uint32_t expected_micros;
+    int expected_code;
+};
+
+struct ToUnixTestCase test_cases[] = {
+    {"Epoch", "1970-01-01T00:00:00Z", 0, 0, TINYUTC_ISO8601_OK},
+    {"Canonical with fraction", "2024-02-29T17:05:03.123456Z", 1709226303, 123456, TINYUTC_ISO8601_OK},
+    {"Date only", "2024-02-29", 1709164800, 0, TINYUTC_ISO8601_OK},
+    {"Offset -01:00 changing a year", "1972-12-31T23:59:59-0100", 94697999, 0, TINYUTC_ISO8601_OK},
+    {"Offset +23:59 changing a day", "1972-12-31T17:05:03+2359", 94583163, 0, TINYUTC_ISO8601_OK},
+    {"Leap second", "1972-12-31T23:59:60Z", 94694400, 0, TINYUTC_ISO8601_OK},
+    {"24:00:00", "2025-01-02T24:00:00Z", 1735862400, 0, TINYUTC_ISO8601_OK},
+    {"Week date with offset", "2000-W03-7T01:23:45+09:00", 948558225, 0, TINYUTC_ISO8601_OK},
+    {"Ordinal date with fraction", "2000-023T01:23:45,999999+11:00", 948551025, 999999, TINYUTC_ISO8601_OK},
+    {"Last second of 2105", "2105-12-31T23:59:59Z", 4291747199UL, 0, TINYUTC_ISO8601_OK},
+    {"Empty string", "", 0, 0, TINYUTC_ISO8601_EMPTY_STRING},
+    {"Non strict separator", "2024-02-29 17:05:03Z", 0, 0, TINYUTC_ISO8601_INVALID_MAIN_SEPARATOR},
+    {"Trailing characters", "2024-02-29T17:05:03Z x", 0, 0, TINYUTC_ISO8601_INVALID_FORMAT},
+    {"Invalid offset", "1972-12-31T17:05:03+2435", 0, 0, TINYUTC_ISO8601_INVALID_OFFSET},
+#ifndef TINYUTC_USE_INT64
+    {"Before the epoch", "1969-12-31T23:59:59Z", 0, 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"Offset before the epoch", "1970-01-01T00:30:00+01:00", 0, 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"After 2106-02-07T06:28:15", "2106-02-07T06:28:16Z", 0, 0, TINYUTC_ISO8601_INVALID_DATE},
+#else
+    {"Before the epoch", "1969-12-31T23:59:59Z", -1, 0, TINYUTC_ISO8601_OK},
+    {"Year 1 with offset", "0001-01-01T01:30:00+01:00", -62135595000LL, 0, TINYUTC_ISO8601_OK},
+    {"Before year 1 with offset", "0001-01-01T00:30:00+01:00", 0, 0, TINYUTC_ISO8601_INVALID_DATE},
+#endif
+};
+
+int test_cases_table()
+{
+    int failures = 0;
+
+    for (int i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++)
+    {
+        tinyutc_time_t unix_ts = 0;
+        uint32_t micros = 0;
+
+        int parse_result = tinyutc_parse_iso8601_to_unix(test_cases[i].iso8601, &unix_ts, &micros);
+        if (parse_result != test_cases[i].expected_code ||
+            (parse_result == TINYUTC_ISO8601_OK && (unix_ts != test_cases[i].expected_ts || micros != test_cases[i].expected_micros)))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Test '%s': %s : code %s, %lld.%06u\n", test_cases[i].description,
+                   test_cases[i].iso8601, get_err_string(parse_result), (long long)unix_ts, micros);
+            failures++;
+        }
+        else
+        {
+            printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Test '%s' => %s\n", test_cases[i].description, get_err_string(parse_result));
+        }
+    }
+
+    return failures;
+}
+
+// Formats a random datetime, in any layout with a strict separator, away from the edges of the range
+static void random_datetime(char *str)
+{
+    static const char *layouts[] = {
+        "%04d-%02d-%02dT%02d:%02d:%02d%s%s",
+        "%04d%02d%02dT%02d%02d%02d%s%s",
+    };
+    static const char *fractions[] = {"", ".5", ",000001", ".999999"};
+    static const char *offsets[] = {"", "Z", "+00:00", "-01:30", "+14:45", "-2359", "+05"};
+
+    sprintf(str, layouts[rand() % 2], 1971 + rand() % 134, 1 + rand() % 12, 1 + rand() % 28, rand() % 24, rand() % 60,
+            rand() % 61, fractions[rand() % 4], offsets[rand() % (sizeof(offsets) / sizeof(offsets[0]))]);
+}
+
+int test_random_datetimes()
+{
+    char str[64];
+    int failures = 0;
+
+    srand(1970);
+    for (int round = 0; round < RANDOM_ROUNDS && failures < 10; round++)
+    {
+        struct TinyUTCTime utc_tm = {0};
+        tinyutc_time_t unix_ts = 0, expected_ts = 0;
+        uint32_t micros = 0;
+
+        random_datetime(str);
+
+        int parse_result = tinyutc_parse_iso8601_to_unix(str, &unix_ts, &micros);
+        int expected_result = tinyutc_parse_iso8601_datetime(&utc_tm, str, true);
+        if (expected_result == TINYUTC_ISO8601_OK && tinyutc_utc_to_unix(&utc_tm, &expected_ts) < 0)
+        {
+            expected_result = TINYUTC_ISO8601_INVALID_DATE;
+        }
+
+        if (parse_result != expected_result ||
+            (parse_result == TINYUTC_ISO8601_OK && (unix_ts != expected_ts || micros != utc_tm.microseconds)))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : %s %lld, expected %s %lld\n", str, get_err_string(parse_result),
+                   (long long)unix_ts, get_err_string(expected_result), (long long)expected_ts);
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random datetimes\n", RANDOM_ROUNDS);
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_cases_table();
+    failures += test_random_datetimes();
+
+    printf("Parsing to Unix timestamps: %d failures.\n", failures);
+}
@@ -0,0 +1,258 @@
+/**
+ * @file test_isoparse_validate.c
+ * @brief Test cases for the validation of ISO8601 datetimes without parsing.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Some hand written cases, then every calendar, week and ordinal date of the
+ * 20th and 21st centuries against a reference calendar, then random altered
+ * datetimes compared to `tinyutc_parse_iso8601_datetimen`: a valid string must
+ * be parsed, and an invalid one must give the error code of the parser.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define DATETIMES 200000
+
+struct ValidationTest
+{
+    const char *iso8601;
+    uint32_t flags;
+    err_t expected;
+};
+
+struct ValidationTest test_cases[] = {
+    {"2024-02-29T17:05:03Z", 0, TINYUTC_ISO8601_OK},
+    {"2024-02-29T17:05:03.123456Z", TINYUTC_ISO8601_REQUIRE_OFFSET, TINYUTC_ISO8601_OK},
+    {"2023-02-29T17:05:03Z", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2024-02-30", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2024-04-31T00:00:00+02:00", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"20240431", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2024-04-30", 0, TINYUTC_ISO8601_OK},
+    {"2024-04-30", TINYUTC_ISO8601_REQUIRE_TIME, TINYUTC_ISO8601_INVALID_TIME},
+    {"2024-04-30T12", TINYUTC_ISO8601_REQUIRE_TIME, TINYUTC_ISO8601_OK},
+    {"2024-04-30T12", TINYUTC_ISO8601_REQUIRE_OFFSET, TINYUTC_ISO8601_INVALID_OFFSET},
+    {"2024-04-30T12z", TINYUTC_ISO8601_REQUIRE_OFFSET, TINYUTC_ISO8601_OK},
+    {"2024-04-30T12:00-00:00", TINYUTC_ISO8601_REQUIRE_OFFSET, TINYUTC_ISO8601_OK},
+    {"2024-04-30-12:00", TINYUTC_ISO8601_REQUIRE_OFFSET, TINYUTC_ISO8601_INVALID_OFFSET},
+    {"2024-04-30 12:00", 0, TINYUTC_ISO8601_OK},
+    {"2024-04-30 12:00", TINYUTC_ISO8601_STRICT_SEPARATOR, TINYUTC_ISO8601_INVALID_MAIN_SEPARATOR},
+    {"2024-04-30T24:00:00", 0, TINYUTC_ISO8601_OK},
+    {"2024-04-30T24:00:01", 0, TINYUTC_ISO8601_INVALID_TIME},
+    {"2016-12-31T23:59:60Z", 0, TINYUTC_ISO8601_OK},
+    {"2024-04-30T24:00:00Z", 0, TINYUTC_ISO8601_OK},
+    {"2024-04-30T24:00:00.000001Z", 0, TINYUTC_ISO8601_INVALID_TIME},
+    {"2024-04-30T23:60:00Z", 0, TINYUTC_ISO8601_INVALID_TIME},
+    {"2024-04-30T23:59:61Z", 0, TINYUTC_ISO8601_INVALID_TIME},
+    {"2024-00-30T23:59:59Z", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2024-04-30T12:00:00.1234567Z", 0, TINYUTC_ISO8601_TIME_FRACTION_TOO_LONG},
+    {"2020-W53-7", 0, TINYUTC_ISO8601_OK},
+    {"2021-W53-1", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2021W537", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2021-W52-7T10:00", 0, TINYUTC_ISO8601_OK},
+    {"2024-W00-1", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2024-366", 0, TINYUTC_ISO8601_OK},
+    {"2023-366", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2023365T10", 0, TINYUTC_ISO8601_OK},
+    {"2024-02-29T17:05:03Zx", 0, TINYUTC_ISO8601_INVALID_FORMAT},
+    {"", 0, TINYUTC_ISO8601_EMPTY_STRING},
+#ifndef TINYUTC_USE_INT64
+    {"1969-12-31", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"1970-01-01T00:30+01:00", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"1970-W01-1", 0, TINYUTC_ISO8601_INVALID_DATE},
+    {"2106-02-07T06:28:15Z", 0, TINYUTC_ISO8601_OK},
+    {"2106-02-07T06:28:16Z", 0, TINYUTC_ISO8601_INVALID_DATE},
+#else
+    {"1969-12-31", 0, TINYUTC_ISO8601_OK},
+    {"1970-W01-1", 0, TINYUTC_ISO8601_OK},
+    {"2106-02-07T06:28:16Z", 0, TINYUTC_ISO8601_OK},
+    {"0001-01-01T00:20+00:20", 0, TINYUTC_ISO8601_OK},
+    {"0001-01-01T00+00:20", 0, TINYUTC_ISO8601_INVALID_DATE},
+#endif
+};
+
+int test_fixed_cases()
+{
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++)
+    {
+        err_t result = tinyutc_validate_iso8601_datetime(test_cases[i].iso8601, strlen(test_cases[i].iso8601), test_cases[i].flags);
+
+        if (result != test_cases[i].expected)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' (flags %u) : %s, expected %s\n", test_cases[i].iso8601,
+                   test_cases[i].flags, get_err_string(result), get_err_string(test_cases[i].expected));
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %zu hand written cases\n", sizeof(test_cases) / sizeof(test_cases[0]));
+    }
+    return failures;
+}
+
+static int check(const char *str, err_t expected)
+{
+    err_t result = tinyutc_validate_iso8601_datetime(str, strlen(str), 0);
+
+    if (result != expected)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : %s, expected %s\n", str, get_err_string(result), get_err_string(expected));
+        return 1;
+    }
+    return 0;
+}
+
+// Every date of 1971-2099, with the week day of January 1st counted from 1970 (a thursday, 4)
+int test_dates()
+{
+    static const int month_days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    int jan_1st = 4;
+    int failures = 0;
+    char str[32];
+
+    for (int year = 1970; year < 2100 && failures < 10; year++)
+    {
+        int is_leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+        int weeks = (jan_1st == 4 || (is_leap && jan_1st == 3)) ? 53 : 52;
+
+        if (year > 1970)
+        {
+            for (int month = 1; month <= 12; month++)
+            {
+                for (int day = 0; day <= 32; day++)
+                {
+                    bool exists = day >= 1 && day <= month_days[month - 1] + (month == 2 && is_leap);
+
+                    sprintf(str, day & 1 ? "%04d-%02d-%02d" : "%04d%02d%02d", year, month, day);
+                    failures += check(str, exists ? TINYUTC_ISO8601_OK : TINYUTC_ISO8601_INVALID_DATE);
+                }
+            }
+
+            for (int week = 0; week <= 54; week++)
+            {
+                for (int day = 1; day <= 7; day++)
+                {
+                    sprintf(str, week & 1 ? "%04d-W%02d-%d" : "%04dW%02d%dT12", year, week, day);
+                    failures += check(str, week >= 1 && week <= weeks ? TINYUTC_ISO8601_OK : TINYUTC_ISO8601_INVALID_DATE);
+                }
+            }
+
+            for (int ordinal = 0; ordinal <= 367; ordinal++)
+            {
+                sprintf(str, ordinal & 1 ? "%04d-%03d" : "%04d%03d", year, ordinal);
+                failures += check(str, ordinal >= 1 && ordinal <= 365 + is_leap ? TINYUTC_ISO8601_OK : TINYUTC_ISO8601_INVALID_DATE);
+            }
+        }
+
+        jan_1st = (jan_1st + 365 + is_leap) % 7;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Calendar, week and ordinal dates of 1971-2099\n");
+    }
+    return failures;
+}
+
+static const char characters[] = "0123456789-:T .,Zz+W";
+
+// Formats a random datetime, in any of the layouts of the parser, then alters it
+static void random_datetime(char *str)
+{
+    size_t len = random_iso8601_datetime(str, 1969, 140);
+
+    for (int alterations = rand() % 3; alterations > 0; alterations--)
+    {
+        size_t pos = (size_t)rand() % len;
+
+        switch (rand() % 3)
+        {
+        case 0:
+            str[pos] = characters[rand() % (sizeof(characters) - 1)];
+            break;
+        case 1:
+            memmove(str + pos + 1, str + pos, len - pos + 1);
+            str[pos] = characters[rand() % (sizeof(characters) - 1)];
+            len++;
+            break;
+        default:
+            memmove(str + pos, str + pos + 1, len - pos);
+            len--;
+            break;
+        }
+    }
+}
+
+int test_random(uint32_t flags)
+{
+    struct TinyUTCTime utc_tm;
+    tinyutc_time_t unix_ts;
+    char str[64];
+    int failures = 0;
+    int valid = 0;
+
+    srand(2106);
+
+    for (int i = 0; i < DATETIMES && failures < 10; i++)
+    {
+        random_datetime(str);
+
+        size_t len = strlen(str);
+        err_t result = tinyutc_validate_iso8601_datetime(str, len, flags);
+        err_t parsed = tinyutc_parse_iso8601_datetimen(&utc_tm, str, len, 0, flags & TINYUTC_ISO8601_STRICT_SEPARATOR);
+
+        // The parser fails to apply the offset of datetimes out of range
+        if (parsed == TINYUTC_INTERNAL_ERROR)
+        {
+            parsed = TINYUTC_ISO8601_INVALID_DATE;
+        }
+
+        // Syntax errors are the same, and valid strings are always parsed, to a timestamp too
+        if (parsed != TINYUTC_ISO8601_OK ? result != parsed
+                                         : result == TINYUTC_ISO8601_OK &&
+                                               (flags & TINYUTC_ISO8601_STRICT_SEPARATOR) &&
+                                               tinyutc_parse_iso8601_to_unix(str, &unix_ts, 0) != TINYUTC_ISO8601_OK)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' : %s, parsed with %s\n", str, get_err_string(result), get_err_string(parsed));
+            failures++;
+        }
+        valid += result == TINYUTC_ISO8601_OK;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random datetimes, %d valid%s\n", DATETIMES, valid,
+               flags & TINYUTC_ISO8601_STRICT_SEPARATOR ? "" : " (not strict)");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_fixed_cases();
+    failures += test_dates();
+    failures += test_random(TINYUTC_ISO8601_STRICT_SEPARATOR);
+    failures += test_random(0);
+
+    printf("Validation: %d failures.\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file test_no_hw_divide.c
+ * @brief Test cases for the conversions built with TINYUTC_NO_HW_DIVIDE.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Each reciprocal is checked against the hardware division on its whole domain,
+ * then every second of the 32 bits range is converted both ways and compared to
+ * a calendar counted one second at a time. Build with optimizations, the
+ * exhaustive walk converts more than four billion timestamps.
+ */
+
+#define TINYUTC_NO_HW_DIVIDE
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "../tinyutc.h"
+
+#define CHECK_DIVISION(NAME, MACRO, DIVISOR, MAX)                                                                    \
+    do                                                                                                               \
+    {                                                                                                                \
+        int division_failures = 0;                                                                                   \
+        for (uint64_t x = 0; x <= (MAX); x++)                                                                        \
+        {                                                                                                            \
+            if (MACRO((uint32_t)x) != (uint32_t)x / (DIVISOR))                                                       \
+            {                                                                                                        \
+                division_failures++;                                                                                 \
+            }                                                                                                        \
+        }                                                                                                            \
+        print_result(NAME, division_failures);                                                                       \
+        failures += division_failures;                                                                               \
+    } while (0)
+
+static void print_result(const char *name, int failures)
+{
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %s\n", name);
+    }
+    else
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %s : %d failures\n", name, failures);
+    }
+}
+
+int test_reciprocals()
+{
+    int failures = 0;
+
+    CHECK_DIVISION("x / 86400", _TINYUTC_DIV_SECS_PER_DAY, 86400, 0xFFFFFFFFULL);
+    CHECK_DIVISION("x / 3600", _TINYUTC_DIV_SECS_PER_HOUR, 3600, 86399);
+    CHECK_DIVISION("x / 60", _TINYUTC_DIV_SECS_PER_MIN, 60, 3599);
+    CHECK_DIVISION("x / 146097", _TINYUTC_DIV_DAYS_PER_ERA, 146097, 24000000);
+    CHECK_DIVISION("x / 365", _TINYUTC_DIV_365, 365, 146096);
+    CHECK_DIVISION("x / 1460", _TINYUTC_DIV_1460, 1460, 146096);
+    CHECK_DIVISION("x / 36524", _TINYUTC_DIV_36524, 36524, 146096);
+    CHECK_DIVISION("x / 100", _TINYUTC_DIV_100, 100, 65535);
+    CHECK_DIVISION("x / 400", _TINYUTC_DIV_400, 400, 65535);
+    CHECK_DIVISION("x / 12", _TINYUTC_DIV_12, 12, 786431);
+    CHECK_DIVISION("x / 153", _TINYUTC_DIV_153, 153, 1827);
+    CHECK_DIVISION("x / 9", _TINYUTC_DIV_9, 9, 276);
+    CHECK_DIVISION("x / 5", _TINYUTC_DIV_5, 5, 1685);
+    CHECK_DIVISION("x / 7", _TINYUTC_DIV_7, 7, 43692);
+    CHECK_DIVISION("x / 10", _TINYUTC_DIV_10, 10, 1028);
+    CHECK_DIVISION("x / 10000", _TINYUTC_DIV_10000, 10000, 0xFFFFFFFFULL);
+
+    int modulo_failures = 0;
+    for (uint32_t x = 0; x <= 131071; x++)
+    {
+        if (_TINYUTC_MOD_7(x) != x % 7)
+        {
+            modulo_failures++;
+        }
+    }
+    print_result("x % 7", modulo_failures);
+    failures += modulo_failures;
+
+    int leap_failures = 0;
+    for (uint32_t year = 0; year <= 0xFFFF; year++)
+    {
+        bool expected = (year % 400 == 0) || ((year % 4 == 0) && (year % 100 != 0));
+        if ((bool)_TINYUTC_IS_LEAP_YEAR(year) != expected)
+        {
+            leap_failures++;
+        }
+    }
+    print_result("Leap years", leap_failures);
+    failures += leap_failures;
+
+    return failures;
+}
+
+int test_every_second()
+{
+    struct TinyUTCTime expected = {1970, 1, 1, 0, 0, 0, 0};
+    struct TinyUTCTime current = {0};
+    tinyutc_time_t back_ts = 0;
+    uint8_t expected_week_day = 4; // 1970-01-01 is a thursday
+    int failures = 0;
+
+    for (uint64_t ts = 0; ts <= 0xFFFFFFFF; ts++)
+    {
+        tinyutc_unix_to_utc(&current, (tinyutc_time_t)ts);
+        tinyutc_utc_to_unix(&current, &back_ts);
+
+        if (current.year != expected.year || current.month != expected.month || current.day != expected.day ||
+            current.hour != expected.hour || current.minute != expected.minute || current.second != expected.second ||
+            back_ts != ts)
+        {
+            if (failures < 10)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %013llu =/= %04d/%02d/%02d %02d:%02d:%02d\n", (unsigned long long)ts,
+                       expected.year, expected.month, expected.day, expected.hour, expected.minute, expected.second);
+            }
+            failures++;
+        }
+
+        // Days are checked once, at midnight
+        if (expected.hour == 0 && expected.minute == 0 && expected.second == 0)
+        {
+            if (tinyutc_get_week_day(&expected, true) != expected_week_day ||
+                tinyutc_get_week_day(&expected, false) != (expected_week_day + 6) % 7)
+            {
+                if (failures < 10)
+                {
+                    printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Week day of %04d/%02d/%02d\n", expected.year, expected.month, expected.day);
+                }
+                failures++;
+            }
+            expected_week_day = (expected_week_day + 1) % 7;
+        }
+
+        // Count one second
+        if (++expected.second < _TINYUTC_SECS_PER_MIN)
+        {
+            continue;
+        }
+        expected.second = 0;
+        if (++expected.minute < _TINYUTC_MIN_PER_HOUR)
+        {
+            continue;
+        }
+        expected.minute = 0;
+        if (++expected.hour < _TINYUTC_HOUR_PER_DAY)
+        {
+            continue;
+        }
+        expected.hour = 0;
+        if (++expected.day <= _TINYUTC_GET_DAYS_IN_MONTH(expected.month - 1, expected.year))
+        {
+            continue;
+        }
+        expected.day = 1;
+        if (++expected.month <= _TINYUTC_MONTH_PER_YEAR)
+        {
+            continue;
+        }
+        expected.month = 1;
+        expected.year++;
+    }
+
+    print_result("Every second of the 32 bits range", failures);
+
+    return failures;
+}
+
+int main()
+{
+    int failures = test_reciprocals();
+    failures += test_every_second();
+
+    printf("Division free conversions: %d failures.\n", failures);
+    return failures != 0;
+}
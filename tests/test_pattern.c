@@ -0,0 +1,244 @@
+/**
+ * @file test_pattern.c
+ * @brief Test cases for the precompiled patterns.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Random structures are formatted with several patterns and compared to `strftime`
+ * (and `snprintf` for fractions), then parsed back. Malformed strings, values out of
+ * range and invalid patterns must be rejected.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+#include "../tinyutc_pattern.h"
+
+#include "tests_common.h"
+
+#define DATETIMES 100000
+
+// Patterns without fraction, the same for strftime
+static const char *patterns[] = {
+    "%d/%m/%Y %H:%M:%S", "%Y%m%d%H%M%S", "%b %e %H:%M:%S", "%a, %d %b %Y %H:%M:%S GMT", "%y-%m-%d", "%H:%M", "100%% %Y",
+};
+
+int test_random()
+{
+    struct TinyUTCPattern pattern, fraction_pattern;
+    char result[TINYUTC_PATTERN_MAX_WIDTH + 1], expected[64];
+    int failures = 0;
+
+    srand(1970);
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++)
+    {
+        if (tinyutc_pattern_compile(&pattern, patterns[p]) != TINYUTC_ISO8601_OK)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' should compile\n", patterns[p]);
+            failures++;
+            continue;
+        }
+
+        for (int i = 0; i < DATETIMES && failures < 10; i++)
+        {
+            tinyutc_time_t unix_ts = (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+            struct TinyUTCTime utc_tm = {0}, parsed = {2000, 1, 1, 0, 0, 0, 0};
+            time_t t = (time_t)unix_ts;
+            struct tm tm;
+
+            tinyutc_unix_to_utc(&utc_tm, unix_ts);
+            gmtime_r(&t, &tm);
+            strftime(expected, sizeof(expected), patterns[p], &tm);
+
+            size_t len = tinyutc_pattern_format(&pattern, &utc_tm, result, sizeof(result));
+            if (len != strlen(expected) || len != tinyutc_pattern_width(&pattern) || strcmp(result, expected) != 0)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s': '%s', expected '%s'\n", patterns[p], result, expected);
+                failures++;
+                continue;
+            }
+
+            // Fields missing from the pattern come from the structure given
+            if (strstr(patterns[p], "%Y") == 0 && strstr(patterns[p], "%y") == 0)
+            {
+                parsed.year = utc_tm.year;
+            }
+            if (strstr(patterns[p], "%m") == 0 && strstr(patterns[p], "%b") == 0)
+            {
+                parsed.month = utc_tm.month;
+            }
+            if (strstr(patterns[p], "%d") == 0 && strstr(patterns[p], "%e") == 0)
+            {
+                parsed.day = utc_tm.day;
+            }
+            parsed.hour = strstr(patterns[p], "%H") == 0 ? utc_tm.hour : 0;
+            parsed.minute = strstr(patterns[p], "%M") == 0 ? utc_tm.minute : 0;
+            parsed.second = strstr(patterns[p], "%S") == 0 ? utc_tm.second : 0;
+
+            err_t error = tinyutc_pattern_parse(&pattern, &parsed, result, len);
+            bool is_century_ok = strstr(patterns[p], "%y") == 0 || (utc_tm.year >= 1969 && utc_tm.year <= 2068);
+            if (is_century_ok && (error != TINYUTC_ISO8601_OK || !compare_utc_structs_datetimes(&parsed, &utc_tm)))
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' parsing '%s': %s\n", patterns[p], result, get_err_string(error));
+                failures++;
+            }
+        }
+    }
+
+    // Fractions, compared to snprintf
+    tinyutc_pattern_compile(&pattern, "%Y-%m-%dT%H:%M:%S.%f");
+    tinyutc_pattern_compile(&fraction_pattern, "%H%M%S%L");
+    for (int i = 0; i < DATETIMES && failures < 10; i++)
+    {
+        struct TinyUTCTime utc_tm = {0}, parsed = {0};
+
+        tinyutc_unix_to_utc(&utc_tm, (tinyutc_time_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand()));
+        utc_tm.microseconds = rand() % 1000000;
+
+        snprintf(expected, sizeof(expected), "%04u-%02u-%02uT%02u:%02u:%02u.%06u", utc_tm.year, utc_tm.month, utc_tm.day, utc_tm.hour,
+                 utc_tm.minute, utc_tm.second, utc_tm.microseconds);
+        size_t len = tinyutc_pattern_format(&pattern, &utc_tm, result, sizeof(result));
+        if (strcmp(result, expected) != 0 || tinyutc_pattern_parse(&pattern, &parsed, result, len) != TINYUTC_ISO8601_OK ||
+            !compare_utc_structs_datetimes(&parsed, &utc_tm) || parsed.microseconds != utc_tm.microseconds)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Microseconds '%s', expected '%s'\n", result, expected);
+            failures++;
+        }
+
+        snprintf(expected, sizeof(expected), "%02u%02u%02u%03u", utc_tm.hour, utc_tm.minute, utc_tm.second, utc_tm.microseconds / 1000);
+        len = tinyutc_pattern_format(&fraction_pattern, &utc_tm, result, sizeof(result));
+        if (strcmp(result, expected) != 0 || tinyutc_pattern_parse(&fraction_pattern, &parsed, result, len) != TINYUTC_ISO8601_OK ||
+            parsed.microseconds != utc_tm.microseconds / 1000 * 1000)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Milliseconds '%s', expected '%s'\n", result, expected);
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %d random datetimes with %zu patterns, formatted and parsed\n", DATETIMES,
+               sizeof(patterns) / sizeof(patterns[0]) + 2);
+    }
+    return failures;
+}
+
+int test_parse_errors()
+{
+    struct
+    {
+        const char *pattern;
+        const char *str;
+        err_t expected;
+    } cases[] = {
+        {"%d/%m/%Y %H:%M:%S", "06/11/1994 08:49:37", TINYUTC_ISO8601_OK},
+        {"%d/%m/%Y %H:%M:%S", "06/11/1994 08:49:3", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%d/%m/%Y %H:%M:%S", "06/11/1994 08:49:377", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%d/%m/%Y %H:%M:%S", "06-11-1994 08:49:37", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%d/%m/%Y %H:%M:%S", "06/11/1994T08:49:37", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%d/%m/%Y %H:%M:%S", "06/1a/1994 08:49:37", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%d/%m/%Y %H:%M:%S", "06/11/1994 08:49:3\xff", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%d/%m/%Y %H:%M:%S", "31/11/1994 08:49:37", TINYUTC_ISO8601_INVALID_DATE},
+        {"%d/%m/%Y %H:%M:%S", "06/13/1994 08:49:37", TINYUTC_ISO8601_INVALID_DATE},
+        {"%d/%m/%Y %H:%M:%S", "06/11/1994 24:49:37", TINYUTC_ISO8601_INVALID_TIME},
+        {"%d/%m/%Y %H:%M:%S", "06/11/1994 08:49:61", TINYUTC_ISO8601_INVALID_TIME},
+        {"%Y%m%d%H%M%S", "19941106084937", TINYUTC_ISO8601_OK},
+        {"%Y%m%d%H%M%S", "19940229084937", TINYUTC_ISO8601_INVALID_DATE},
+        {"%Y%m%d%H%M%S", "1994110608493 ", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%b %e %H:%M:%S", "Nov  6 08:49:37", TINYUTC_ISO8601_OK},
+        {"%b %e %H:%M:%S", "Nov 06 08:49:37", TINYUTC_ISO8601_OK},
+        {"%b %e %H:%M:%S", "Nov 16 08:49:37", TINYUTC_ISO8601_OK},
+        {"%b %e %H:%M:%S", "Nov x6 08:49:37", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%b %e %H:%M:%S", "nov  6 08:49:37", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%b %e %H:%M:%S", "Nov  0 08:49:37", TINYUTC_ISO8601_INVALID_DATE},
+        {"%a %d %b %Y", "Sun 06 Nov 1994", TINYUTC_ISO8601_OK},
+        {"%a %d %b %Y", "Mon 06 Nov 1994", TINYUTC_ISO8601_INVALID_DATE},
+        {"%a %d %b %Y", "Dim 06 Nov 1994", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%H:%M", "08:49", TINYUTC_ISO8601_OK},
+        {"%H:%M", "08:60", TINYUTC_ISO8601_INVALID_TIME},
+        {"%%%H", "%08", TINYUTC_ISO8601_OK},
+        {"%%%H", "-08", TINYUTC_ISO8601_INVALID_FORMAT},
+        {"%%%Y", "%1994", TINYUTC_ISO8601_INVALID_DATE},
+    };
+    struct TinyUTCPattern pattern;
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++)
+    {
+        // Year of the syslog dates, and a date out of range, only checked by patterns with date fields
+        struct TinyUTCTime utc_tm = {1994, 2, 30, 0, 0, 0, 0}, before;
+        err_t error;
+
+        tinyutc_pattern_compile(&pattern, cases[i].pattern);
+        before = utc_tm;
+        error = tinyutc_pattern_parse(&pattern, &utc_tm, cases[i].str, strlen(cases[i].str));
+        if (error != cases[i].expected || (error != TINYUTC_ISO8601_OK && memcmp(&utc_tm, &before, sizeof(utc_tm)) != 0))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t '%s' with '%s': %s, expected %s\n", cases[i].str, cases[i].pattern,
+                   get_err_string(error), get_err_string(cases[i].expected));
+            failures++;
+        }
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Malformed strings and values out of range are rejected\n");
+    }
+    return failures;
+}
+
+int test_compile_errors()
+{
+    struct TinyUTCPattern pattern;
+    struct TinyUTCTime bad_year = {10000, 1, 1, 0, 0, 0, 0}, bad_hour = {2024, 1, 1, 24, 0, 0, 0};
+    char result[TINYUTC_PATTERN_MAX_WIDTH + 1];
+    int failures = 0;
+
+    if (tinyutc_pattern_compile(&pattern, "") != TINYUTC_ISO8601_EMPTY_STRING ||
+        tinyutc_pattern_compile(&pattern, "%Y-%q") != TINYUTC_ISO8601_INVALID_FORMAT ||
+        tinyutc_pattern_compile(&pattern, "%Y-%") != TINYUTC_ISO8601_INVALID_FORMAT ||
+        tinyutc_pattern_compile(&pattern, "%Y-%m-%dT%H:%M:%S.%f+00:00 ") != TINYUTC_ISO8601_INVALID_FORMAT ||
+        tinyutc_pattern_compile(&pattern, "%Y-%m-%dT%H:%M:%S.%f+00:00") != TINYUTC_ISO8601_OK || tinyutc_pattern_width(&pattern) != 32)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Invalid patterns should be rejected\n");
+        failures++;
+    }
+
+    tinyutc_pattern_compile(&pattern, "%Y %H");
+    if (tinyutc_pattern_format(&pattern, &bad_year, result, sizeof(result)) != 0 ||
+        tinyutc_pattern_format(&pattern, &bad_hour, result, sizeof(result)) != 0 ||
+        tinyutc_pattern_format(&pattern, &(struct TinyUTCTime){2024, 1, 1, 23, 0, 0, 0}, result, 7) != 0 ||
+        tinyutc_pattern_format(&pattern, &(struct TinyUTCTime){2024, 1, 1, 23, 0, 0, 0}, result, 8) != 7)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Values out of range should not be formatted\n");
+        failures++;
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Invalid patterns are rejected\n");
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = test_random();
+    failures += test_parse_errors();
+    failures += test_compile_errors();
+
+    printf("Patterns: %d failures.\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file test_simd.c
+ * @brief Test cases for SIMD kernels, against the scalar conversion.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Kernels split the time of the day and the date independently, so checking
+ * every second of a day, then three seconds of every day of the 32 bits range,
+ * covers every intermediate value the kernels can compute.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "../tinyutc.h"
+#include "../tinyutc_simd.h"
+
+#define DAYS_IN_RANGE (0xFFFFFFFFUL / _TINYUTC_SECS_PER_DAY + 1)
+// Odd size, so that the scalar tail of the kernels is exercised too
+#define TEST_SIZE (_TINYUTC_SECS_PER_DAY + 3 * DAYS_IN_RANGE - 1)
+
+static tinyutc_time_t timestamps[TEST_SIZE];
+
+static uint16_t years[TEST_SIZE];
+static uint8_t months[TEST_SIZE], days[TEST_SIZE], hours[TEST_SIZE], minutes[TEST_SIZE], seconds[TEST_SIZE];
+
+struct KernelName
+{
+    enum TinyUTCSimdKernel kernel;
+    const char *name;
+};
+
+struct KernelName kernels[] = {
+    {TINYUTC_SIMD_SCALAR, "scalar"},
+    {TINYUTC_SIMD_SSE2, "SSE2"},
+    {TINYUTC_SIMD_AVX2, "AVX2"},
+    {TINYUTC_SIMD_AVX512, "AVX-512"},
+    {TINYUTC_SIMD_NEON, "NEON"},
+};
+
+int main()
+{
+    struct TinyUTCColumns columns = {years, months, days, hours, minutes, seconds};
+    struct TinyUTCTime expected = {0};
+    size_t count = 0;
+
+    // Every second of a day
+    for (uint32_t second = 0; second < _TINYUTC_SECS_PER_DAY; second++)
+    {
+        timestamps[count++] = second;
+    }
+    // First, last and some second of every day
+    for (uint64_t day = 0; day < DAYS_IN_RANGE && count < TEST_SIZE; day++)
+    {
+        uint64_t day_start = day * _TINYUTC_SECS_PER_DAY;
+        uint64_t day_end = day_start + _TINYUTC_SECS_PER_DAY - 1 > 0xFFFFFFFF ? 0xFFFFFFFF : day_start + _TINYUTC_SECS_PER_DAY - 1;
+
+        timestamps[count++] = (tinyutc_time_t)day_start;
+        timestamps[count++] = (tinyutc_time_t)day_end;
+        if (count < TEST_SIZE)
+        {
+            timestamps[count++] = (tinyutc_time_t)(day_start + (day * 7919) % (day_end - day_start + 1));
+        }
+    }
+
+    printf("Best kernel available: %d\n", tinyutc_simd_get_kernel());
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+        if (tinyutc_simd_set_kernel(kernels[k].kernel) != 0)
+        {
+            printf("[SKIPPED]\t Kernel %s not available\n", kernels[k].name);
+            continue;
+        }
+
+        tinyutc_simd_unix_to_utc_columns(&columns, timestamps, count);
+
+        int failures = 0;
+        for (size_t i = 0; i < count; i++)
+        {
+            tinyutc_unix_to_utc(&expected, timestamps[i]);
+
+            if (years[i] != expected.year || months[i] != expected.month || days[i] != expected.day ||
+                hours[i] != expected.hour || minutes[i] != expected.minute || seconds[i] != expected.second)
+            {
+                if (failures < 10)
+                {
+                    printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Kernel %s : %013u =/= %04d/%02d/%02d %02d:%02d:%02d\n", kernels[k].name, timestamps[i],
+                           years[i], months[i], days[i], hours[i], minutes[i], seconds[i]);
+                }
+                failures++;
+            }
+        }
+
+        if (failures == 0)
+        {
+            printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Kernel %s : %llu timestamps\n", kernels[k].name, (unsigned long long)count);
+        }
+    }
+}
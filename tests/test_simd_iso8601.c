@@ -0,0 +1,141 @@
+/**
+ * @file test_simd_iso8601.c
+ * @brief Test cases for the SIMD ISO8601 datetime parsing kernels, against the scalar parser.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Random datetimes in every canonical layout, with out of range fields, random
+ * characters, truncations and trailing characters, must give the same results,
+ * error codes and consumed lengths as `tinyutc_parse_iso8601_datetimen`. Strings
+ * are copied to buffers of their exact length: build with -fsanitize=address to
+ * catch any read past the end, e.g.
+ * `gcc -fsanitize=address test_simd_iso8601.c ../iso8601_parser.c ../iso8601_simd.c`.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../iso8601_simd.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define RANDOM_ROUNDS 1000000
+
+struct KernelName
+{
+    enum TinyUTCSimdKernel kernel;
+    const char *name;
+};
+
+struct KernelName kernels[] = {
+    {TINYUTC_SIMD_SCALAR, "scalar"},
+    {TINYUTC_SIMD_SSE41, "SSE4.1"},
+    {TINYUTC_SIMD_AVX2, "AVX2"},
+    {TINYUTC_SIMD_NEON, "NEON"},
+};
+
+static int random_field(int usual_max, int usual_min)
+{
+    return rand() % 4 ? usual_min + rand() % (usual_max - usual_min + 1) : rand() % 100;
+}
+
+// Formats a random datetime in one of the canonical layouts, then alters it
+static size_t random_datetime(char *str)
+{
+    static const char *offsets[] = {"Z", "Z", "+00:00", "-01:30", "+14:45", "-23:59", "+24:00"};
+    int year = rand() % 4 ? 1960 + rand() % 160 : rand() % 10000;
+    size_t len;
+
+    len = sprintf(str, "%04d-%02d-%02dT%02d:%02d:%02d", year, random_field(12, 1), random_field(31, 1),
+                  random_field(23, 0), random_field(59, 0), random_field(60, 0));
+    if (rand() % 2)
+    {
+        len += sprintf(str + len, ".%06d", rand() % 1000000);
+    }
+    len += sprintf(str + len, "%s", offsets[rand() % (sizeof(offsets) / sizeof(offsets[0]))]);
+
+    switch (rand() % 4)
+    {
+    case 0: // Random character
+        str[rand() % len] = (char)(rand() % 256);
+        break;
+    case 1: // Truncation
+        len = rand() % (len + 1);
+        break;
+    case 2: // Trailing characters
+        len += sprintf(str + len, "%s", rand() % 2 ? " INFO" : "0123456789");
+        break;
+    default:
+        break;
+    }
+    return len;
+}
+
+int test_kernel(const struct KernelName *kernel)
+{
+    char str[64];
+    int failures = 0;
+
+    srand(1970);
+    for (int round = 0; round < RANDOM_ROUNDS && failures < 10; round++)
+    {
+        size_t len = random_datetime(str);
+        char *buffer = malloc(len ? len : 1);
+        memcpy(buffer, str, len);
+
+        for (int with_consumed = 0; with_consumed <= 1; with_consumed++)
+        {
+            struct TinyUTCTime simd = {0};
+            struct TinyUTCTime scalar = {0};
+            size_t simd_consumed = 0, scalar_consumed = 0;
+
+            int simd_result = tinyutc_simd_parse_iso8601_datetimen(&simd, buffer, len, with_consumed ? &simd_consumed : NULL, true);
+            int scalar_result = tinyutc_parse_iso8601_datetimen(&scalar, buffer, len, with_consumed ? &scalar_consumed : NULL, true);
+
+            if (simd_result != scalar_result || simd_consumed != scalar_consumed ||
+                (simd_result == TINYUTC_ISO8601_OK && !compare_utc_structs_datetimes(&simd, &scalar)))
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Kernel %s : '%.*s' : %s (%zu), expected %s (%zu)\n", kernel->name, (int)len, str,
+                       get_err_string(simd_result), simd_consumed, get_err_string(scalar_result), scalar_consumed);
+                failures++;
+            }
+        }
+        free(buffer);
+    }
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Kernel %s : %d random datetimes\n", kernel->name, RANDOM_ROUNDS);
+    }
+    return failures;
+}
+
+int main()
+{
+    int failures = 0;
+
+    printf("Best kernel available: %d\n", tinyutc_simd_get_iso8601_kernel());
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++)
+    {
+        if (tinyutc_simd_set_iso8601_kernel(kernels[k].kernel) != 0)
+        {
+            printf("[SKIPPED]\t Kernel %s not available\n", kernels[k].name);
+            continue;
+        }
+        failures += test_kernel(&kernels[k]);
+    }
+
+    printf("SIMD ISO8601 parsing: %d failures.\n", failures);
+}
@@ -19,7 +19,7 @@
 #include <stdbool.h>
 #include <string.h>
 
-#include "..\tinyutc.h"
+#include "../tinyutc.h"
 
 struct Test
 {
@@ -236,10 +236,52 @@ bool compare_utc_structs(const struct TinyUTCTime *a, const struct TinyUTCTime *
             a->hour == b->hour && a->minute == b->minute && a->second == b->second && a->microseconds == b->microseconds);
 }
 
+/**
+ * Walks every day of the 32 bits timestamp range, and checks that the date
+ * of each day is the successor of the date of the previous day, and that
+ * it converts back to the same timestamp.
+ */
+int test_days_continuity()
+{
+    struct TinyUTCTime previous = {1969, 12, 31, 0, 0, 0, 0};
+    struct TinyUTCTime current = {0};
+    tinyutc_time_t back_ts = 0;
+    int failures = 0;
+
+    for (uint64_t ts = 0; ts <= 0xFFFFFFFF; ts += _TINYUTC_SECS_PER_DAY)
+    {
+        tinyutc_unix_to_utc(&current, (tinyutc_time_t)ts);
+
+        struct TinyUTCTime expected = previous;
+        expected.day++;
+        if (expected.day > _TINYUTC_GET_DAYS_IN_MONTH(expected.month - 1, expected.year))
+        {
+            expected.day = 1;
+            expected.month++;
+        }
+        if (expected.month > _TINYUTC_MONTH_PER_YEAR)
+        {
+            expected.month = 1;
+            expected.year++;
+        }
+
+        tinyutc_utc_to_unix(&current, &back_ts);
+
+        if (!compare_utc_structs(&current, &expected) || back_ts != ts)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Day continuity : %013llu =/= %04d/%02d/%02d\n", (unsigned long long)ts, expected.year, expected.month, expected.day);
+            failures++;
+        }
+        previous = current;
+    }
+
+    return failures;
+}
+
 int main()
 {
     struct TinyUTCTime utc_tm = {0};
-    uint32_t timestamp_result = 0;
+    tinyutc_time_t timestamp_result = 0;
     int sucess_count = 0;
 
     char spacingdesc[51] = {' '};
@@ -269,4 +311,7 @@ int main()
         }
     }
     printf("%d/%llu tests passed.\n", sucess_count, sizeof(test_cases) / sizeof(test_cases[0]));
+
+    int continuity_failures = test_days_continuity();
+    printf("Day continuity over the whole range: %d failures.\n", continuity_failures);
 }
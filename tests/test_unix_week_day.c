@@ -0,0 +1,74 @@
+/**
+ * @file test_unix_week_day.c
+ * @brief Test cases for the day of the week computed from Unix timestamps.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * The first and last second of every day of the 32 bits range are compared to
+ * `tinyutc_get_week_day`, with both numberings, one by one and in batch.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "../tinyutc.h"
+
+#define DAYS_IN_RANGE (0xFFFFFFFFUL / _TINYUTC_SECS_PER_DAY + 1)
+#define TEST_SIZE (2 * DAYS_IN_RANGE)
+
+static tinyutc_time_t timestamps[TEST_SIZE];
+static uint8_t week_days[TEST_SIZE];
+
+int main()
+{
+    struct TinyUTCTime utc_tm = {0};
+    int failures = 0;
+
+    for (uint64_t day = 0; day < DAYS_IN_RANGE; day++)
+    {
+        uint64_t day_end = day * _TINYUTC_SECS_PER_DAY + _TINYUTC_SECS_PER_DAY - 1;
+
+        timestamps[2 * day] = (tinyutc_time_t)(day * _TINYUTC_SECS_PER_DAY);
+        timestamps[2 * day + 1] = day_end > 0xFFFFFFFF ? 0xFFFFFFFF : (tinyutc_time_t)day_end;
+    }
+
+    for (int monday_first = 0; monday_first <= 1; monday_first++)
+    {
+        int numbering_failures = 0;
+
+        tinyutc_unix_get_week_day_batch(week_days, timestamps, TEST_SIZE, monday_first);
+
+        for (size_t i = 0; i < TEST_SIZE; i++)
+        {
+            tinyutc_unix_to_utc(&utc_tm, timestamps[i]);
+            uint8_t expected = tinyutc_get_week_day(&utc_tm, monday_first);
+
+            if (tinyutc_unix_get_week_day(timestamps[i], monday_first) != expected || week_days[i] != expected)
+            {
+                if (numbering_failures < 10)
+                {
+                    printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %013u : expected %d, got %d (batch %d)\n", timestamps[i], expected,
+                           tinyutc_unix_get_week_day(timestamps[i], monday_first), week_days[i]);
+                }
+                numbering_failures++;
+            }
+        }
+
+        if (numbering_failures == 0)
+        {
+            printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Every day, monday_first = %d\n", monday_first);
+        }
+        failures += numbering_failures;
+    }
+
+    printf("Week days from timestamps: %d failures.\n", failures);
+}
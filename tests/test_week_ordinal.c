@@ -0,0 +1,241 @@
+/**
+ * @file test_week_ordinal.c
+ * @brief Test cases for ISO 8601 week dates and ordinal dates.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * A reference calendar is built day by day from 1970-01-01, a thursday. For every
+ * day, `tinyutc_get_ordinal_day` and `tinyutc_get_iso_week` are compared to it, and
+ * the week date and ordinal date strings of the day are parsed back. Some hand
+ * written cases cover the ends of the supported range.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "../iso8601_parser.h"
+#include "../tinyutc.h"
+
+#include "tests_common.h"
+
+#define LAST_YEAR 2500
+#define TEST_SIZE ((LAST_YEAR - 1970 + 1) * 366)
+
+struct Day
+{
+    struct TinyUTCTime utc_tm;
+    uint16_t ordinal;
+    uint8_t week_day; // 1 for a monday, as in week dates
+};
+
+static struct Day days[TEST_SIZE];
+
+struct Iso8601TestCase test_cases[] = {
+    {"Week 1 starting in december", "2009-W01-1", {2008, 12, 29, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Week 1 of a year starting on a thursday", "2015-W01-1", {2014, 12, 29, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Week 53 of a long year", "2009-W53-1", {2009, 12, 28, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Week 53 ending in january", "2020W537", {2021, 1, 3, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"First day of the first week of 1970", "1970-W01-4", {1970, 1, 1, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Week day 0", "2024-W10-0", {0, 0, 0, 0, 0, 0, 0}, TINYUTC_ISO8601_INVALID_DATE},
+    {"Week day 8", "2024-W10-8", {0, 0, 0, 0, 0, 0, 0}, TINYUTC_ISO8601_INVALID_DATE},
+    {"Week 0", "2024-W00-1", {0, 0, 0, 0, 0, 0, 0}, TINYUTC_ISO8601_INVALID_DATE},
+    {"Week 54", "2024-W54-1", {0, 0, 0, 0, 0, 0, 0}, TINYUTC_ISO8601_INVALID_DATE},
+    {"Leap day", "2024-060", {2024, 2, 29, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"March 1st", "2023-060", {2023, 3, 1, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Last day of a leap year", "2024366", {2024, 12, 31, 0, 0, 0, 0}, TINYUTC_ISO8601_OK},
+    {"Day 366 of a common year", "2023-366", {0, 0, 0, 0, 0, 0, 0}, TINYUTC_ISO8601_INVALID_DATE},
+    {"Day 0", "2024-000", {0, 0, 0, 0, 0, 0, 0}, TINYUTC_ISO8601_INVALID_DATE},
+};
+
+static int test_fixed_cases()
+{
+    struct TinyUTCTime utc_tm;
+    int failures = 0;
+
+    for (size_t i = 0; i < sizeof(test_cases) / sizeof(test_cases[0]); i++)
+    {
+        memset(&utc_tm, 0, sizeof(utc_tm));
+        int result = tinyutc_parse_iso8601_date(&utc_tm, test_cases[i].iso8601);
+
+        if (result != test_cases[i].expected_code ||
+            (result == TINYUTC_ISO8601_OK && !compare_utc_struct_dates(&utc_tm, &test_cases[i].expected)))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Test '%s': '%s' => %s, %04u-%02u-%02u\n", test_cases[i].description,
+                   test_cases[i].iso8601, get_err_string(result), utc_tm.year, utc_tm.month, utc_tm.day);
+            failures++;
+        }
+    }
+
+#ifndef TINYUTC_USE_INT64
+    // The first week of 1970 starts on 1969-12-29, before the epoch
+    if (tinyutc_parse_iso8601_date(&utc_tm, "1970-W01-1") != TINYUTC_ISO8601_INVALID_DATE)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Test '1970-W01-1' should be out of range\n");
+        failures++;
+    }
+#else
+    if (tinyutc_parse_iso8601_date(&utc_tm, "1970-W01-1") != TINYUTC_ISO8601_OK || utc_tm.year != 1969 ||
+        utc_tm.month != 12 || utc_tm.day != 29)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Test '1970-W01-1' should be 1969-12-29\n");
+        failures++;
+    }
+
+    if (tinyutc_parse_iso8601_date(&utc_tm, "1969-W01-1") != TINYUTC_ISO8601_OK || utc_tm.year != 1968 ||
+        utc_tm.month != 12 || utc_tm.day != 30)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Test '1969-W01-1' should be 1968-12-30\n");
+        failures++;
+    }
+#endif
+
+    return failures;
+}
+
+static int build_calendar()
+{
+    struct TinyUTCTime utc_tm = {1970, 1, 1, 0, 0, 0, 0};
+    uint16_t ordinal = 1;
+    uint8_t week_day = 4;
+    int count = 0;
+
+    while (utc_tm.year <= LAST_YEAR)
+    {
+        days[count].utc_tm = utc_tm;
+        days[count].ordinal = ordinal;
+        days[count].week_day = week_day;
+        count++;
+
+        week_day = week_day == 7 ? 1 : week_day + 1;
+        ordinal++;
+
+        if (++utc_tm.day > _TINYUTC_GET_DAYS_IN_MONTH(utc_tm.month - 1, utc_tm.year))
+        {
+            utc_tm.day = 1;
+            if (++utc_tm.month > 12)
+            {
+                utc_tm.month = 1;
+                utc_tm.year++;
+                ordinal = 1;
+            }
+        }
+    }
+
+    return count;
+}
+
+static int test_calendar(int count)
+{
+    struct TinyUTCTime utc_tm;
+    char buffer[32];
+    int failures = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        struct Day *day = &days[i];
+
+        // The thursday of a week gives its year, and its ordinal day gives its number
+        int thursday_index = i + 4 - day->week_day;
+        bool has_thursday = thursday_index >= 0 && thursday_index < count;
+        const struct Day *thursday = &days[has_thursday ? thursday_index : i];
+        uint16_t iso_year = 0;
+        uint8_t week = 0;
+
+        if (tinyutc_get_ordinal_day(&day->utc_tm) != day->ordinal)
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Ordinal day of %04u-%02u-%02u: expected %u, got %d\n", day->utc_tm.year,
+                   day->utc_tm.month, day->utc_tm.day, day->ordinal, tinyutc_get_ordinal_day(&day->utc_tm));
+            failures++;
+        }
+
+        if (tinyutc_get_iso_week(&day->utc_tm, &iso_year, &week) != 0 ||
+            (has_thursday && (iso_year != thursday->utc_tm.year || week != (thursday->ordinal - 1) / 7 + 1)))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t ISO week of %04u-%02u-%02u: got %04u-W%02u\n", day->utc_tm.year,
+                   day->utc_tm.month, day->utc_tm.day, iso_year, week);
+            failures++;
+        }
+
+        if (has_thursday)
+        {
+            snprintf(buffer, sizeof(buffer), i & 1 ? "%04u-W%02u-%u" : "%04uW%02u%u", iso_year, week, day->week_day);
+            if (tinyutc_parse_iso8601_date(&utc_tm, buffer) != TINYUTC_ISO8601_OK || !compare_utc_struct_dates(&utc_tm, &day->utc_tm))
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Week date '%s': got %04u-%02u-%02u\n", buffer, utc_tm.year,
+                       utc_tm.month, utc_tm.day);
+                failures++;
+            }
+        }
+
+        snprintf(buffer, sizeof(buffer), i & 1 ? "%04u-%03u" : "%04u%03u", day->utc_tm.year, day->ordinal);
+        if (tinyutc_parse_iso8601_date(&utc_tm, buffer) != TINYUTC_ISO8601_OK || !compare_utc_struct_dates(&utc_tm, &day->utc_tm))
+        {
+            printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Ordinal date '%s': got %04u-%02u-%02u\n", buffer, utc_tm.year,
+                   utc_tm.month, utc_tm.day);
+            failures++;
+        }
+
+        if (failures > 20)
+        {
+            break;
+        }
+    }
+
+    return failures;
+}
+
+static int test_range_ends()
+{
+    struct TinyUTCTime last_week = {65535, 12, 29, 0, 0, 0, 0};
+    struct TinyUTCTime last_day = {65535, 12, 31, 0, 0, 0, 0};
+    struct TinyUTCTime before_range = {_TINYUTC_MIN_YEAR - 1, 12, 31, 0, 0, 0, 0};
+    struct TinyUTCTime bad_month = {2024, 13, 1, 0, 0, 0, 0};
+    uint16_t iso_year = 0;
+    uint8_t week = 0;
+    int failures = 0;
+
+    // 65535-12-31 is a tuesday, in the first week of 65536
+    if (tinyutc_get_ordinal_day(&last_day) != 365 || tinyutc_get_iso_week(&last_day, &iso_year, &week) != -1 ||
+        tinyutc_get_iso_week(&last_week, &iso_year, &week) != 0 || iso_year != 65535 || week != 52)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Last week of the range: got %04u-W%02u\n", iso_year, week);
+        failures++;
+    }
+
+    if (tinyutc_get_ordinal_day(&before_range) != -1 || tinyutc_get_iso_week(&before_range, &iso_year, &week) != -1 ||
+        tinyutc_get_ordinal_day(&bad_month) != -1 || tinyutc_get_iso_week(&bad_month, &iso_year, &week) != -1)
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Dates out of range should be rejected\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+int main()
+{
+    int failures = 0;
+    int count = build_calendar();
+
+    failures += test_fixed_cases();
+    failures += test_calendar(count);
+    failures += test_range_ends();
+
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t Week and ordinal dates of %d days match the reference calendar\n", count);
+    }
+
+    printf("Week and ordinal dates: %d failures.\n", failures);
+    return failures != 0;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file test_year_table.c
+ * @brief Test cases for the conversions built with TINYUTC_USE_YEAR_TABLE.
+ * @author Ulysse Moreau
+ * @date 2025-05-20
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * The window is narrowed to 2000-2099, so that every day of the 32 bits range
+ * goes either through the table, or through the computation fallback. Both are
+ * checked against the computation, as is every day of the window itself.
+ *
+ * Build it again with the widest window, which expands every block of entries and
+ * goes past 2106: `gcc test_year_table.c -DTINYUTC_YEAR_TABLE_FIRST=1970
+ * -DTINYUTC_YEAR_TABLE_LAST=2369`.
+ */
+
+#define TINYUTC_USE_YEAR_TABLE
+#ifndef TINYUTC_YEAR_TABLE_FIRST
+#define TINYUTC_YEAR_TABLE_FIRST 2000
+#define TINYUTC_YEAR_TABLE_LAST 2099
+#endif
+#define TINYUTC_IMPLEMENTATION
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "../tinyutc.h"
+
+static void print_result(const char *name, int failures)
+{
+    if (failures == 0)
+    {
+        printf("\033[38;5;2m\033[1m[SUCCESS]\033[39m\t %s\n", name);
+    }
+    else
+    {
+        printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %s : %d failures\n", name, failures);
+    }
+}
+
+int test_table()
+{
+    int failures = 0;
+
+    if (sizeof(_tinyutc_year_table) / sizeof(_tinyutc_year_table[0]) != TINYUTC_YEAR_TABLE_LAST - TINYUTC_YEAR_TABLE_FIRST + 2)
+    {
+        failures++;
+    }
+
+    for (uint16_t year = TINYUTC_YEAR_TABLE_FIRST; year <= TINYUTC_YEAR_TABLE_LAST + 1; year++)
+    {
+        if (_tinyutc_year_table[year - TINYUTC_YEAR_TABLE_FIRST] != _tinyutc_days_from_civil(year, 1, 1))
+        {
+            failures++;
+        }
+    }
+
+    print_result("Year table entries", failures);
+
+    return failures;
+}
+
+int test_window_days()
+{
+    uint32_t first = _tinyutc_days_from_civil(TINYUTC_YEAR_TABLE_FIRST, 1, 1);
+    uint32_t end = _tinyutc_days_from_civil(TINYUTC_YEAR_TABLE_LAST + 1, 1, 1);
+    uint16_t year, table_year;
+    uint8_t month, day, table_month, table_day;
+    uint32_t table_days;
+    int failures = 0;
+
+    // One day before and after the window must be rejected
+    if ((first > 0 && _tinyutc_year_table_from_days(first - 1, &table_year, &table_month, &table_day)) ||
+        _tinyutc_year_table_from_days(end, &table_year, &table_month, &table_day))
+    {
+        failures++;
+    }
+
+    for (uint32_t days = first; days < end; days++)
+    {
+        _tinyutc_civil_from_days(days, &year, &month, &day);
+
+        if (!_tinyutc_year_table_from_days(days, &table_year, &table_month, &table_day) || table_year != year ||
+            table_month != month || table_day != day || !_tinyutc_year_table_to_days(year, month, day, &table_days) ||
+            table_days != days)
+        {
+            if (failures < 10)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t Day %lu =/= %04d/%02d/%02d\n", (unsigned long)days, year, month, day);
+            }
+            failures++;
+        }
+    }
+
+    print_result("Every day of the table window", failures);
+
+    return failures;
+}
+
+int test_every_day()
+{
+    struct TinyUTCTime current = {0};
+    uint16_t year;
+    uint8_t month, day;
+    tinyutc_time_t back_ts = 0;
+    int failures = 0;
+
+    for (uint64_t ts = 0; ts <= 0xFFFFFFFF; ts += _TINYUTC_SECS_PER_DAY)
+    {
+        uint32_t days = (uint32_t)(ts / _TINYUTC_SECS_PER_DAY);
+
+        tinyutc_unix_to_utc(&current, (tinyutc_time_t)ts);
+        tinyutc_utc_to_unix(&current, &back_ts);
+        _tinyutc_civil_from_days(days, &year, &month, &day);
+
+        if (current.year != year || current.month != month || current.day != day || back_ts != ts)
+        {
+            if (failures < 10)
+            {
+                printf("\033[38;5;1m\033[1m[FAILED]\033[39m\t %013llu =/= %04d/%02d/%02d\n", (unsigned long long)ts, year, month, day);
+            }
+            failures++;
+        }
+    }
+
+    print_result("Every day of the 32 bits range", failures);
+
+    return failures;
+}
+
+int main()
+{
+    int failures = test_table();
+    failures += test_window_days();
+    failures += test_every_day();
+
+    printf("Year table conversions: %d failures.\n", failures);
+    return failures != 0;
+}
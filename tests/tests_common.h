@@ -17,6 +17,9 @@
 #ifndef _TESTS_COMMON_H
 #define _TESTS_COMMON_H
 
+#include <stdio.h>
+#include <stdlib.h>
+
 #include "../iso8601_parser.h"
 
 struct Iso8601TestCase
@@ -61,20 +64,52 @@ const char *get_err_string(int code)
     return "Unknown error";
 }
 
-bool compare_utc_structs_datetimes(struct TinyUTCTime *a, struct TinyUTCTime *b)
+bool compare_utc_structs_datetimes(const struct TinyUTCTime *a, const struct TinyUTCTime *b)
 {
     return (a->year == b->year && a->month == b->month && a->day == b->day &&
             a->hour == b->hour && a->minute == b->minute && a->second == b->second && a->microseconds == b->microseconds);
 }
 
-bool compare_utc_struct_dates(struct TinyUTCTime *a, struct TinyUTCTime *b)
+bool compare_utc_struct_dates(const struct TinyUTCTime *a, const struct TinyUTCTime *b)
 {
     return (a->year == b->year && a->month == b->month && a->day == b->day);
 }
 
-bool compare_utc_struct_times(struct TinyUTCTime *a, struct TinyUTCTime *b)
+bool compare_utc_struct_times(const struct TinyUTCTime *a, const struct TinyUTCTime *b)
 {
     return (a->hour == b->hour && a->minute == b->minute && a->second == b->second && a->microseconds == b->microseconds);
 }
 
+// Formats a random datetime, in any of the layouts of the parser, of a year in [first_year, first_year + years[
+size_t random_iso8601_datetime(char *str, int first_year, int years)
+{
+    static const char *dates[] = {"%04d-%02d-%02d", "%04d%02d%02d", "%04d-%03d", "%04d%03d", "%04d-W%02d-%d", "%04dW%02d%d"};
+    static const char *times[] = {"", "T%02d", "T%02d:%02d", "T%02d:%02d:%02d", "T%02d%02d%02d", " %02d:%02d:%02d.%d",
+                                  "T%02d:%02d:%02d,%06d"};
+    static const char *offsets[] = {"", "Z", "+%02d", "-%02d:%02d", "+%02d%02d"};
+    int format = rand() % 6;
+    size_t len;
+
+    if (format < 2)
+    {
+        len = sprintf(str, dates[format], first_year + rand() % years, 1 + rand() % 12, 1 + rand() % 31);
+    }
+    else if (format < 4)
+    {
+        len = sprintf(str, dates[format], first_year + rand() % years, 1 + rand() % 366);
+    }
+    else
+    {
+        len = sprintf(str, dates[format], first_year + rand() % years, 1 + rand() % 53, 1 + rand() % 7);
+    }
+
+    int time = rand() % 7;
+    len += sprintf(str + len, times[time], rand() % 25, rand() % 60, rand() % 61, rand() % 1000000);
+    if (time > 0)
+    {
+        len += sprintf(str + len, offsets[rand() % 5], rand() % 24, rand() % 60);
+    }
+    return len;
+}
+
 #endif // _TESTS_COMMON_H
\ No newline at end of file
@@ -19,13 +19,23 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifndef tinyutc_time_t
+#ifdef TINYUTC_USE_INT64
+typedef int64_t tinyutc_time_t;
+#else
 typedef uint32_t tinyutc_time_t;
 #endif
+#endif
 
 typedef int err_t;
 
+#ifdef TINYUTC_NO_HW_DIVIDE
+// Reciprocals are only valid for unsigned 32 bits timestamps, fail to compile otherwise
+typedef char _tinyutc_no_hw_divide_requires_32_bits_time[(sizeof(tinyutc_time_t) == sizeof(uint32_t) && (tinyutc_time_t)-1 > 0) ? 1 : -1];
+#endif
+
 #define _TINYUTC_UNIX_EPOCH_YEAR (1970UL)
 
 #define _TINYUTC_DAYS_PER_YEAR (365UL)
@@ -38,6 +48,44 @@ typedef int err_t;
 #define _TINYUTC_SECS_PER_DAY (_TINYUTC_SECS_PER_HOUR * _TINYUTC_HOUR_PER_DAY)
 #define _TINYUTC_MONTH_PER_YEAR (12UL)
 
+// Number of days from 1970-01-01 to 65535-12-31, the last date a TinyUTCTime can hold
+#define _TINYUTC_MAX_DAYS (23217003UL)
+#define _TINYUTC_MAX_YEAR (65535UL)
+
+/**
+ * Signed timestamps.
+ *
+ * With a signed `tinyutc_time_t` (e.g. TINYUTC_USE_INT64), timestamps before 1970 are
+ * negative, and dates go back to 0001-01-01. With an unsigned one, dates start on 1970-01-01.
+ * These are constants for a given type, so that checks which can never fail are removed
+ * by the compiler. The sign is found by comparing -1 to 1 rather than to 0, which warns
+ * with -Wtype-limits for unsigned types.
+ */
+#define _TINYUTC_TIME_IS_SIGNED ((tinyutc_time_t)((tinyutc_time_t)0 - 1) < (tinyutc_time_t)1)
+#define _TINYUTC_MIN_YEAR (_TINYUTC_TIME_IS_SIGNED ? 1UL : _TINYUTC_UNIX_EPOCH_YEAR)
+#define _TINYUTC_MIN_DAYS (_TINYUTC_TIME_IS_SIGNED ? -719162L : 0L)
+
+// Timestamps of 0001-01-01 00:00:00 and 65535-12-31 23:59:59
+#define _TINYUTC_MIN_TIMESTAMP (INT64_C(-62135596800))
+#define _TINYUTC_MAX_TIMESTAMP (INT64_C(2005949145599))
+
+// Range of tinyutc_time_t. It only matters for types narrower than 64 bits, which can not hold
+// every TinyUTCTime, so 64 bits types use a bound which is large enough, and can not overflow.
+#define _TINYUTC_TIME_MAX \
+    (sizeof(tinyutc_time_t) >= sizeof(int64_t) ? (INT64_C(1) << 62) : (int64_t)(UINT64_MAX >> (64 - 8 * sizeof(tinyutc_time_t) + _TINYUTC_TIME_IS_SIGNED)))
+#define _TINYUTC_TIME_MIN (_TINYUTC_TIME_IS_SIGNED ? -_TINYUTC_TIME_MAX - 1 : 0)
+
+// First and last day of the range of tinyutc_time_t, and first and last second of the time of those days
+#define _TINYUTC_TIME_FIRST_DAY ((_TINYUTC_TIME_MIN - (int64_t)_TINYUTC_SECS_PER_DAY + 1) / (int64_t)_TINYUTC_SECS_PER_DAY)
+#define _TINYUTC_TIME_FIRST_DAY_SECS (_TINYUTC_TIME_MIN - _TINYUTC_TIME_FIRST_DAY * (int64_t)_TINYUTC_SECS_PER_DAY)
+#define _TINYUTC_TIME_LAST_DAY (_TINYUTC_TIME_MAX / (int64_t)_TINYUTC_SECS_PER_DAY)
+#define _TINYUTC_TIME_LAST_DAY_SECS (_TINYUTC_TIME_MAX % (int64_t)_TINYUTC_SECS_PER_DAY)
+
+// An era is a 400 years cycle of the gregorian calendar, which always has the same number of days
+#define _TINYUTC_DAYS_PER_ERA (146097UL)
+// Number of days between 0000-03-01 and 1970-01-01
+#define _TINYUTC_DAYS_FROM_CIVIL_TO_UNIX_EPOCH (719468UL)
+
 /**
  * A leap year occurs
  *  - Every 4 years
@@ -49,8 +97,16 @@ typedef int err_t;
  * - If the year is divisible by 4 and not divisible by 100
  */
 
+#ifdef TINYUTC_NO_HW_DIVIDE
+// Divisible by 100 is divisible by 4 and 25, and divisible by 400 is divisible by 16 and 25.
+// Divisibility by 25 is tested by multiplying with the inverse of 25 modulo 2^32.
+#define _TINYUTC_IS_MULTIPLE_OF_25(YEAR) ((uint32_t)((uint32_t)(YEAR) * 0xC28F5C29UL) <= 0x0A3D70A3UL)
+#define _TINYUTC_IS_LEAP_YEAR(YEAR) \
+    ((((YEAR) & 3) == 0) && (!_TINYUTC_IS_MULTIPLE_OF_25(YEAR) || (((YEAR) & 15) == 0)))
+#else
 #define _TINYUTC_IS_LEAP_YEAR(YEAR) \
     (((YEAR) % 400 == 0) || (((YEAR) % 4 == 0) && ((YEAR) % 100 != 0)))
+#endif
 
 /**
  * The following macros are used to determine the number of days in a month.
@@ -78,6 +134,122 @@ typedef int err_t;
 #define _TINYUTC_GET_DAYS_IN_MONTH(month, year) \
     ((_TINYUTC_IS_FEBRUARY(month)) ? _TINYUTC_GET_DAYS_IN_FEBRUARY(year) : _TINYUTC_GET_DAYS_IN_NON_FEBRUARY(month))
 
+/**
+ * Divisions by constants.
+ *
+ * On cores without a hardware divider (e.g. Cortex-M0+), each `/` and `%` is a call
+ * to a slow software division routine. When TINYUTC_NO_HW_DIVIDE is defined, they are
+ * replaced by a multiplication with a reciprocal and a shift. Each reciprocal has been
+ * checked exhaustively on the range it is applied to (in brackets), and most of them
+ * only need a 32 bits product. This mode requires a 32 bits `tinyutc_time_t`.
+ */
+#ifdef TINYUTC_NO_HW_DIVIDE
+#define _TINYUTC_MUL_SHIFT_32(X, MAGIC, SHIFT) ((uint32_t)(((uint32_t)(X) * (MAGIC)) >> (SHIFT)))
+#define _TINYUTC_MUL_SHIFT_64(X, MAGIC, SHIFT) ((uint32_t)(((uint64_t)(X) * (MAGIC)) >> (SHIFT)))
+
+#define _TINYUTC_DIV_SECS_PER_DAY(X) _TINYUTC_MUL_SHIFT_64(X, 0xC22E4507UL, 48) // [0, 2^32 - 1]
+#define _TINYUTC_DIV_SECS_PER_HOUR(X) _TINYUTC_MUL_SHIFT_32(X, 0x91A3UL, 27)    // [0, 86399]
+#define _TINYUTC_DIV_SECS_PER_MIN(X) _TINYUTC_MUL_SHIFT_32(X, 0x889UL, 17)      // [0, 3599]
+#define _TINYUTC_DIV_DAYS_PER_ERA(X) _TINYUTC_MUL_SHIFT_64(X, 0xE5AC1BUL, 41)   // [0, 24000000]
+#define _TINYUTC_DIV_365(X) _TINYUTC_MUL_SHIFT_64(X, 0xB38CFAUL, 32)            // [0, 146096]
+#define _TINYUTC_DIV_1460(X) _TINYUTC_MUL_SHIFT_32((X) >> 2, 0x59C7UL, 23)      // [0, 146096], as (X / 4) / 365
+#define _TINYUTC_DIV_36524(X) _TINYUTC_MUL_SHIFT_32((X) >> 2, 0x72D7UL, 28)     // [0, 146096], as (X / 4) / 9131
+#define _TINYUTC_DIV_100(X) _TINYUTC_MUL_SHIFT_32((X) >> 2, 0x147BUL, 17)       // [0, 65535], as (X / 4) / 25
+#define _TINYUTC_DIV_400(X) _TINYUTC_MUL_SHIFT_32((X) >> 4, 0x51FUL, 15)        // [0, 65535], as (X / 16) / 25
+#define _TINYUTC_DIV_12(X) _TINYUTC_MUL_SHIFT_64(X, 0xAAAABUL, 23)              // [0, 786431]
+#define _TINYUTC_DIV_153(X) _TINYUTC_MUL_SHIFT_32(X, 0x359UL, 17)               // [0, 1827]
+#define _TINYUTC_DIV_9(X) _TINYUTC_MUL_SHIFT_32(X, 0x39UL, 9)                   // [0, 276]
+#define _TINYUTC_DIV_5(X) _TINYUTC_MUL_SHIFT_32(X, 0x667UL, 13)                 // [0, 1685]
+#define _TINYUTC_DIV_7(X) _TINYUTC_MUL_SHIFT_32(X, 0x4925UL, 17)                // [0, 43692]
+#define _TINYUTC_DIV_10(X) _TINYUTC_MUL_SHIFT_32(X, 0xCDUL, 11)                 // [0, 1028]
+#define _TINYUTC_DIV_10000(X) _TINYUTC_MUL_SHIFT_64(X, 0xD1B71759UL, 45)        // [0, 2^32 - 1]
+// 2^15 = 1 (mod 7), so X is first folded to [0, 32770], then reduced [0, 131071]
+#define _TINYUTC_FOLD_7(X) (((uint32_t)(X) >> 15) + ((uint32_t)(X) & 0x7FFFUL))
+#define _TINYUTC_MOD_7(X) (_TINYUTC_FOLD_7(X) - 7 * _TINYUTC_MUL_SHIFT_32(_TINYUTC_FOLD_7(X), 0x4925UL, 17))
+#else
+#define _TINYUTC_DIV_SECS_PER_DAY(X) ((X) / (tinyutc_time_t)_TINYUTC_SECS_PER_DAY) // Signed with signed timestamps
+#define _TINYUTC_DIV_SECS_PER_HOUR(X) ((X) / _TINYUTC_SECS_PER_HOUR)
+#define _TINYUTC_DIV_SECS_PER_MIN(X) ((X) / _TINYUTC_SECS_PER_MIN)
+#define _TINYUTC_DIV_DAYS_PER_ERA(X) ((X) / _TINYUTC_DAYS_PER_ERA)
+#define _TINYUTC_DIV_365(X) ((X) / 365)
+#define _TINYUTC_DIV_1460(X) ((X) / 1460)
+#define _TINYUTC_DIV_36524(X) ((X) / 36524)
+#define _TINYUTC_DIV_100(X) ((X) / 100)
+#define _TINYUTC_DIV_400(X) ((X) / 400)
+#define _TINYUTC_DIV_12(X) ((X) / 12)
+#define _TINYUTC_DIV_153(X) ((X) / 153)
+#define _TINYUTC_DIV_9(X) ((X) / 9)
+#define _TINYUTC_DIV_5(X) ((X) / 5)
+#define _TINYUTC_DIV_7(X) ((X) / 7)
+#define _TINYUTC_DIV_10(X) ((X) / 10)
+#define _TINYUTC_DIV_10000(X) ((X) / 10000)
+#define _TINYUTC_MOD_7(X) ((X) % 7)
+#endif
+
+// Tells the compiler that batch arrays do not overlap, so that batch loops can be vectorized
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define _TINYUTC_RESTRICT __restrict
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
+#define _TINYUTC_RESTRICT restrict
+#else
+#define _TINYUTC_RESTRICT
+#endif
+
+// Restrict qualifiers are lost when batch functions get inlined, so also tell the
+// compiler that iterations of batch loops are independent
+#if defined(__clang__)
+#define _TINYUTC_VECTORIZE_LOOP _Pragma("clang loop vectorize(assume_safety)")
+#elif defined(__GNUC__)
+#define _TINYUTC_VECTORIZE_LOOP _Pragma("GCC ivdep")
+#else
+#define _TINYUTC_VECTORIZE_LOOP
+#endif
+
+/**
+ * Year table.
+ *
+ * When TINYUTC_USE_YEAR_TABLE is defined, the conversions look up the day number of
+ * each January 1st in a constant (ROM resident) table, instead of computing it. Years
+ * outside of the table window fall back to the computation. The window defaults to
+ * 1970-2106, the whole 32 bits range, for 604 bytes of tables ((LAST - FIRST + 2) * 4
+ * bytes of years, and 52 of months), and can be narrowed to save flash (it can not
+ * exceed 400 years).
+ *
+ * The table is defined once, in the translation unit which defines TINYUTC_IMPLEMENTATION
+ * before including this header.
+ */
+#ifdef TINYUTC_USE_YEAR_TABLE
+#ifndef TINYUTC_YEAR_TABLE_FIRST
+#define TINYUTC_YEAR_TABLE_FIRST 1970
+#endif
+#ifndef TINYUTC_YEAR_TABLE_LAST
+#define TINYUTC_YEAR_TABLE_LAST 2106
+#endif
+
+#if TINYUTC_YEAR_TABLE_FIRST < 1970 || TINYUTC_YEAR_TABLE_LAST < TINYUTC_YEAR_TABLE_FIRST || TINYUTC_YEAR_TABLE_LAST - TINYUTC_YEAR_TABLE_FIRST >= 400
+#error "The year table window must be after 1970, and at most 400 years long"
+#endif
+
+// One more entry than years, holding the January 1st following the window
+#define _TINYUTC_YEAR_TABLE_SIZE (TINYUTC_YEAR_TABLE_LAST - TINYUTC_YEAR_TABLE_FIRST + 2)
+
+// Number of leap years in [1, YEAR[, and day number of the January 1st of YEAR (YEAR >= 1970)
+#define _TINYUTC_LEAP_YEARS_BEFORE(YEAR) (((YEAR) - 1) / 4 - ((YEAR) - 1) / 100 + ((YEAR) - 1) / 400)
+#define _TINYUTC_JANUARY_1ST(YEAR) \
+    (_TINYUTC_DAYS_PER_YEAR * ((YEAR) - _TINYUTC_UNIX_EPOCH_YEAR) + _TINYUTC_LEAP_YEARS_BEFORE(YEAR) - _TINYUTC_LEAP_YEARS_BEFORE(_TINYUTC_UNIX_EPOCH_YEAR))
+
+// Expands to the table entries of N years starting from YEAR, N being a power of 2
+#define _TINYUTC_YEAR_TABLE_1(YEAR) _TINYUTC_JANUARY_1ST(YEAR),
+#define _TINYUTC_YEAR_TABLE_2(YEAR) _TINYUTC_YEAR_TABLE_1(YEAR) _TINYUTC_YEAR_TABLE_1((YEAR) + 1)
+#define _TINYUTC_YEAR_TABLE_4(YEAR) _TINYUTC_YEAR_TABLE_2(YEAR) _TINYUTC_YEAR_TABLE_2((YEAR) + 2)
+#define _TINYUTC_YEAR_TABLE_8(YEAR) _TINYUTC_YEAR_TABLE_4(YEAR) _TINYUTC_YEAR_TABLE_4((YEAR) + 4)
+#define _TINYUTC_YEAR_TABLE_16(YEAR) _TINYUTC_YEAR_TABLE_8(YEAR) _TINYUTC_YEAR_TABLE_8((YEAR) + 8)
+#define _TINYUTC_YEAR_TABLE_32(YEAR) _TINYUTC_YEAR_TABLE_16(YEAR) _TINYUTC_YEAR_TABLE_16((YEAR) + 16)
+#define _TINYUTC_YEAR_TABLE_64(YEAR) _TINYUTC_YEAR_TABLE_32(YEAR) _TINYUTC_YEAR_TABLE_32((YEAR) + 32)
+#define _TINYUTC_YEAR_TABLE_128(YEAR) _TINYUTC_YEAR_TABLE_64(YEAR) _TINYUTC_YEAR_TABLE_64((YEAR) + 64)
+#define _TINYUTC_YEAR_TABLE_256(YEAR) _TINYUTC_YEAR_TABLE_128(YEAR) _TINYUTC_YEAR_TABLE_128((YEAR) + 128)
+#endif
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -104,81 +276,339 @@ extern "C"
         uint32_t microseconds;
     };
 
+#ifdef TINYUTC_USE_YEAR_TABLE
+    // Day number (since 1970-01-01) of each January 1st of the window
+    extern const uint32_t _tinyutc_year_table[_TINYUTC_YEAR_TABLE_SIZE];
+    // Day of the year each month starts on, for common [0] and leap [1] years
+    extern const uint16_t _tinyutc_month_table[2][_TINYUTC_MONTH_PER_YEAR + 1];
+
+#ifdef TINYUTC_IMPLEMENTATION
+    // The window size is decomposed in powers of 2, each one expanding to a block of entries
+    const uint32_t _tinyutc_year_table[_TINYUTC_YEAR_TABLE_SIZE] = {
+#if _TINYUTC_YEAR_TABLE_SIZE & 256
+        _TINYUTC_YEAR_TABLE_256(TINYUTC_YEAR_TABLE_FIRST)
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 128
+        _TINYUTC_YEAR_TABLE_128(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 256))
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 64
+        _TINYUTC_YEAR_TABLE_64(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 384))
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 32
+        _TINYUTC_YEAR_TABLE_32(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 448))
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 16
+        _TINYUTC_YEAR_TABLE_16(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 480))
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 8
+        _TINYUTC_YEAR_TABLE_8(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 496))
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 4
+        _TINYUTC_YEAR_TABLE_4(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 504))
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 2
+        _TINYUTC_YEAR_TABLE_2(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 508))
+#endif
+#if _TINYUTC_YEAR_TABLE_SIZE & 1
+        _TINYUTC_YEAR_TABLE_1(TINYUTC_YEAR_TABLE_FIRST + (_TINYUTC_YEAR_TABLE_SIZE & 510))
+#endif
+    };
+
+    const uint16_t _tinyutc_month_table[2][_TINYUTC_MONTH_PER_YEAR + 1] = {
+        {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+        {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366},
+    };
+#endif // TINYUTC_IMPLEMENTATION
+
     /**
-     * @brief Converts a Unix timestamp to a UTC time structure.
+     * @brief Converts a number of days since the Unix epoch to a calendar date,
+     *        using the year table.
      *
-     * This function takes a Unix timestamp and converts it into a UTC time
-     * representation, storing the result in the provided TinyUTCTime structure.
+     * The year is first estimated by dividing by 365, which may be one year
+     * too far, and corrected with the table. Same for the month, estimated
+     * by dividing the day of the year by 32.
      *
-     * @param[out] utc_tm Pointer to a TinyUTCTime structure where the converted
-     *               UTC time will be stored.
-     * @param[in]  unix_ts The Unix timestamp to be converted.
+     * @param[in]  days  Number of days since 1970-01-01.
+     * @param[out] year  Full year (e.g. 2025).
+     * @param[out] month Month, in range 1-12.
+     * @param[out] day   Day of the month, in range 1-31.
      *
-     * @return A uint8_t value indicating success or failure of the conversion.
-     *         Typically, 0 indicates success, while non-zero values indicate
-     *         an error.
+     * @return true if the date is in the table window, false otherwise
+     *         (outputs are then left untouched).
      */
-    static inline err_t tinyutc_unix_to_utc(struct TinyUTCTime *utc_tm, tinyutc_time_t unix_ts)
+    static inline bool _tinyutc_year_table_from_days(uint32_t days, uint16_t *year, uint8_t *month, uint8_t *day)
     {
-        uint16_t year;
-        uint8_t month, days_in_month;
-        unsigned long days;
+        const uint16_t *month_starts;
+        uint32_t i, doy, m;
 
-        if (unix_ts < 0)
+        if (days < _tinyutc_year_table[0] || days >= _tinyutc_year_table[_TINYUTC_YEAR_TABLE_SIZE - 1])
         {
-            return -1;
+            return false;
         }
 
-        // Compute seconds
-        utc_tm->second = unix_ts % _TINYUTC_SECS_PER_MIN;
+        i = _TINYUTC_DIV_365(days - _tinyutc_year_table[0]);
+        if (_tinyutc_year_table[i] > days)
+        {
+            i--;
+        }
 
-        // Morph seconds to minutes, then compute minutes
-        unix_ts /= _TINYUTC_SECS_PER_MIN;
-        utc_tm->minute = unix_ts % _TINYUTC_MIN_PER_HOUR;
+        doy = days - _tinyutc_year_table[i];
+        month_starts = _tinyutc_month_table[_tinyutc_year_table[i + 1] - _tinyutc_year_table[i] - _TINYUTC_DAYS_PER_YEAR];
 
-        // Morph minutes to hours, then compute hours
-        unix_ts /= _TINYUTC_MIN_PER_HOUR;
-        utc_tm->hour = unix_ts % _TINYUTC_HOUR_PER_DAY;
+        m = doy >> 5;
+        if (doy >= month_starts[m + 1])
+        {
+            m++;
+        }
 
-        // Morph hours to days
-        unix_ts /= _TINYUTC_HOUR_PER_DAY;
+        *day = doy - month_starts[m] + 1;
+        *month = m + 1;
+        *year = TINYUTC_YEAR_TABLE_FIRST + i;
 
-        // To find the year, we have to "manually" count days
-        // until reaching the desired year.
+        return true;
+    }
 
-        year = _TINYUTC_UNIX_EPOCH_YEAR;
-        days = 0;
+    /**
+     * @brief Converts a calendar date to a number of days since the Unix epoch,
+     *        using the year table.
+     *
+     * @param[in]  year  Full year (e.g. 2025).
+     * @param[in]  month Month, in range 1-12.
+     * @param[in]  day   Day of the month, in range 1-31.
+     * @param[out] days  Number of days since 1970-01-01.
+     *
+     * @return true if the year is in the table window, false otherwise.
+     */
+    static inline bool _tinyutc_year_table_to_days(uint16_t year, uint8_t month, uint8_t day, uint32_t *days)
+    {
+        uint32_t i;
 
-        while ((days += (_TINYUTC_IS_LEAP_YEAR(year) ? _TINYUTC_DAYS_PER_LEAP_YEAR : _TINYUTC_DAYS_PER_YEAR)) <= unix_ts)
+        if (year < TINYUTC_YEAR_TABLE_FIRST || year > TINYUTC_YEAR_TABLE_LAST)
         {
-            year++;
+            return false;
         }
-        // Remove the days of the current year, that should not be counted
-        days -= _TINYUTC_IS_LEAP_YEAR(year) ? _TINYUTC_DAYS_PER_LEAP_YEAR : _TINYUTC_DAYS_PER_YEAR;
 
-        // Remove the days of all past years, leaving us with only the day of the current year
-        unix_ts -= days;
+        i = year - TINYUTC_YEAR_TABLE_FIRST;
+        *days = _tinyutc_year_table[i] + day - 1 +
+                _tinyutc_month_table[_tinyutc_year_table[i + 1] - _tinyutc_year_table[i] - _TINYUTC_DAYS_PER_YEAR][month - 1];
+
+        return true;
+    }
+#endif // TINYUTC_USE_YEAR_TABLE
 
-        days = 0;
-        days_in_month = 0;
-        for (month = 0; month < _TINYUTC_MONTH_PER_YEAR; month++)
+    /**
+     * @brief Converts a number of days since the Unix epoch to a calendar date.
+     *
+     * Constant time "civil from days" algorithm: the calendar is shifted to
+     * start on March 1st (so that the leap day is the last day of the year),
+     * and split in eras of 400 years, which always contain 146097 days.
+     * The year, month and day are then found with plain arithmetic, without
+     * any loop.
+     *
+     * @param[in]  days  Number of days since 1970-01-01.
+     * @param[out] year  Full year (e.g. 2025).
+     * @param[out] month Month, in range 1-12.
+     * @param[out] day   Day of the month, in range 1-31.
+     *
+     * @see http://howardhinnant.github.io/date_algorithms.html#civil_from_days
+     */
+    static inline void _tinyutc_civil_from_days(uint32_t days, uint16_t *year, uint8_t *month, uint8_t *day)
+    {
+        uint32_t era, doe, yoe, doy, mp, m;
+
+        // Shift the origin from 1970-01-01 to 0000-03-01
+        days += _TINYUTC_DAYS_FROM_CIVIL_TO_UNIX_EPOCH;
+
+        era = _TINYUTC_DIV_DAYS_PER_ERA(days);
+        doe = days - era * _TINYUTC_DAYS_PER_ERA;                                                     // Day of era, [0, 146096]
+        yoe = _TINYUTC_DIV_365(doe - _TINYUTC_DIV_1460(doe) + _TINYUTC_DIV_36524(doe) - (doe == 146096)); // Year of era, [0, 399]
+        doy = doe - (365 * yoe + yoe / 4 - _TINYUTC_DIV_100(yoe));                                    // Day of (March based) year, [0, 365]
+        mp = _TINYUTC_DIV_153(5 * doy + 2);                                                           // March based month, [0, 11]
+
+        m = mp < 10 ? mp + 3 : mp - 9;
+
+        *day = doy - _TINYUTC_DIV_5(153 * mp + 2) + 1;
+        *month = m;
+        *year = era * 400 + yoe + (m <= 2);
+    }
+
+    /**
+     * @brief Converts a calendar date to a number of days since the Unix epoch.
+     *
+     * Constant time "days from civil" algorithm, the inverse of
+     * `_tinyutc_civil_from_days`: leap days are counted arithmetically over
+     * 400 years eras, and the day of the (March based) year is obtained with
+     * a linear formula instead of summing the days of each month.
+     *
+     * @param[in] year  Full year (e.g. 2025), not before 1970.
+     * @param[in] month Month, in range 1-12.
+     * @param[in] day   Day of the month. Out of range days are not checked,
+     *                  and simply overflow to the next month.
+     *
+     * @return The number of days since 1970-01-01.
+     *
+     * @see http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+     */
+    static inline uint32_t _tinyutc_days_from_civil(uint16_t year, uint8_t month, uint8_t day)
+    {
+        uint32_t y, era, yoe, doy, doe;
+
+        // January and February are counted as the last months of the previous year
+        y = year - (month <= 2);
+
+        era = _TINYUTC_DIV_400(y);
+        yoe = y - era * 400;                                                              // Year of era, [0, 399]
+        doy = _TINYUTC_DIV_5(153 * (month > 2 ? month - 3 : month + 9) + 2) + day - 1; // Day of (March based) year, [0, 365]
+        doe = yoe * 365 + yoe / 4 - _TINYUTC_DIV_100(yoe) + doy;                          // Day of era, [0, 146096]
+
+        return era * _TINYUTC_DAYS_PER_ERA + doe - _TINYUTC_DAYS_FROM_CIVIL_TO_UNIX_EPOCH;
+    }
+
+    /**
+     * @brief Splits a number of seconds since midnight in hours, minutes and seconds.
+     *
+     * @param[in]  secs    Seconds since midnight, in range 0-86399.
+     * @param[out] hour    Hour, in range 0-23.
+     * @param[out] minute  Minute, in range 0-59.
+     * @param[out] second  Second, in range 0-59.
+     */
+    static inline void _tinyutc_split_seconds_of_day(uint32_t secs, uint8_t *hour, uint8_t *minute, uint8_t *second)
+    {
+        *hour = _TINYUTC_DIV_SECS_PER_HOUR(secs);
+        secs -= *hour * _TINYUTC_SECS_PER_HOUR;
+        *minute = _TINYUTC_DIV_SECS_PER_MIN(secs);
+        *second = secs - *minute * _TINYUTC_SECS_PER_MIN;
+    }
+
+    /**
+     * @brief Number of days since the epoch of a Unix timestamp.
+     *
+     * Divisions round towards zero, so days before 1970 are rounded towards minus
+     * infinity instead. This is removed by the compiler with unsigned timestamps.
+     *
+     * @param[in] unix_ts The Unix timestamp.
+     *
+     * @return The number of days since 1970-01-01, negative before.
+     */
+    static inline tinyutc_time_t _tinyutc_floor_days(tinyutc_time_t unix_ts)
+    {
+        tinyutc_time_t days = _TINYUTC_DIV_SECS_PER_DAY(unix_ts);
+
+        if (_TINYUTC_TIME_IS_SIGNED && days * (tinyutc_time_t)_TINYUTC_SECS_PER_DAY > unix_ts)
         {
-            // Compute the number of days in this month
-            days_in_month = _TINYUTC_GET_DAYS_IN_MONTH(month, year);
+            days--;
+        }
 
-            if (unix_ts < days_in_month)
-            {
-                // We are in this month, so we can break the loop
-                break;
-            }
+        return days;
+    }
 
-            unix_ts -= days_in_month;
+    /**
+     * @brief Converts a number of days since the epoch to a timestamp.
+     *
+     * @param[in] days Number of days since 1970-01-01, as returned by `_tinyutc_days_from_civil`
+     *                 (negative counts wrap around, and are sign extended back).
+     *
+     * @return The timestamp of the midnight of that day.
+     */
+    static inline tinyutc_time_t _tinyutc_days_to_time(uint32_t days)
+    {
+        return (tinyutc_time_t)(int32_t)days * (tinyutc_time_t)_TINYUTC_SECS_PER_DAY;
+    }
+
+    /**
+     * @brief Splits a Unix timestamp in days since the epoch, and time of the day.
+     *
+     * @param[in]  unix_ts The Unix timestamp to split.
+     * @param[out] hour    Hour, in range 0-23.
+     * @param[out] minute  Minute, in range 0-59.
+     * @param[out] second  Second, in range 0-59.
+     *
+     * @return The number of days since 1970-01-01. Before 1970, the negative count wraps
+     *         around, which `_tinyutc_civil_from_days` handles (its arithmetic is modulo 2^32).
+     */
+    static inline uint32_t _tinyutc_time_of_day(tinyutc_time_t unix_ts, uint8_t *hour, uint8_t *minute, uint8_t *second)
+    {
+        tinyutc_time_t days = _tinyutc_floor_days(unix_ts);
+
+        _tinyutc_split_seconds_of_day(unix_ts - days * (tinyutc_time_t)_TINYUTC_SECS_PER_DAY, hour, minute, second);
+
+        return (uint32_t)days;
+    }
+
+    /**
+     * @brief Checks that a Unix timestamp is in the range of TinyUTCTime (0001-01-01 to 65535-12-31).
+     *
+     * Always true with 32 bits unsigned timestamps.
+     *
+     * @param[in] unix_ts The Unix timestamp.
+     *
+     * @return true if the timestamp can be converted.
+     */
+    static inline bool _tinyutc_is_time_in_range(tinyutc_time_t unix_ts)
+    {
+        // Compared as 64 bits values, the compiler still removes the checks that can not fail
+        const int64_t signed_ts = (int64_t)unix_ts;
+        const uint64_t unsigned_ts = (uint64_t)unix_ts;
+
+        if (_TINYUTC_TIME_IS_SIGNED)
+        {
+            return signed_ts >= _TINYUTC_MIN_TIMESTAMP && signed_ts <= _TINYUTC_MAX_TIMESTAMP;
         }
+        return unsigned_ts <= (uint64_t)_TINYUTC_MAX_TIMESTAMP;
+    }
+
+    /**
+     * @brief Checks that a date and time fits in tinyutc_time_t.
+     *
+     * Always true with 64 bits timestamps.
+     *
+     * @param[in] days Number of days since 1970-01-01.
+     * @param[in] secs Seconds since midnight.
+     *
+     * @return true if the timestamp can be represented.
+     */
+    static inline bool _tinyutc_does_time_fit(int64_t days, int64_t secs)
+    {
+        return (days < _TINYUTC_TIME_LAST_DAY || (days == _TINYUTC_TIME_LAST_DAY && secs <= _TINYUTC_TIME_LAST_DAY_SECS)) &&
+               (days > _TINYUTC_TIME_FIRST_DAY || (days == _TINYUTC_TIME_FIRST_DAY && secs >= _TINYUTC_TIME_FIRST_DAY_SECS));
+    }
 
-        utc_tm->year = year;
-        // Offset month and day to use human-indexing
-        utc_tm->month = month + 1;
-        utc_tm->day = unix_ts + 1;
+    /**
+     * @brief Converts a Unix timestamp to a UTC time structure.
+     *
+     * This function takes a Unix timestamp and converts it into a UTC time
+     * representation, storing the result in the provided TinyUTCTime structure.
+     *
+     * @param[out] utc_tm Pointer to a TinyUTCTime structure where the converted
+     *               UTC time will be stored.
+     * @param[in]  unix_ts The Unix timestamp to be converted.
+     *
+     * @return A uint8_t value indicating success or failure of the conversion.
+     *         Typically, 0 indicates success, while non-zero values indicate
+     *         an error: the timestamp is out of 0001-01-01 to 65535-12-31
+     *         (only possible with 64 bits or signed timestamps).
+     */
+    static inline err_t tinyutc_unix_to_utc(struct TinyUTCTime *utc_tm, tinyutc_time_t unix_ts)
+    {
+        uint32_t days;
+
+        if (!_tinyutc_is_time_in_range(unix_ts))
+        {
+            return -1;
+        }
+
+        // Split the timestamp in days, and time of the day
+        days = _tinyutc_time_of_day(unix_ts, &utc_tm->hour, &utc_tm->minute, &utc_tm->second);
+
+#ifdef TINYUTC_USE_YEAR_TABLE
+        if (_tinyutc_year_table_from_days(days, &utc_tm->year, &utc_tm->month, &utc_tm->day))
+        {
+            return 0;
+        }
+#endif
+
+        // The date itself is computed in constant time, whatever the year.
+        _tinyutc_civil_from_days(days, &utc_tm->year, &utc_tm->month, &utc_tm->day);
 
         return 0;
     }
@@ -194,46 +624,40 @@ extern "C"
      * @param[out]  unix_ts The Unix timestamp result.
      * @return A uint8_t value indicating success or failure of the conversion.
      *         Typically, 0 indicates success, while non-zero values indicate
-     *         an error.
+     *         an error: the year is before 1970 (year 1 with signed timestamps),
+     *         the month is invalid, or the timestamp does not fit in `tinyutc_time_t`.
      */
     static inline err_t tinyutc_utc_to_unix(const struct TinyUTCTime *utc_tm, tinyutc_time_t *unix_ts)
     {
-        uint8_t days_in_month;
-        int i;
+        uint32_t days, secs;
 
-        if (utc_tm->year < _TINYUTC_UNIX_EPOCH_YEAR)
+        if (utc_tm->year < _TINYUTC_MIN_YEAR)
         {
             return -1;
         }
 
-        // Offset year is the number of years since the Unix epoch (1970).
-
-        // Start by couting the number of seconds in the year,
-        // assuming non-leap year (365 days).
-        *unix_ts = (utc_tm->year - _TINYUTC_UNIX_EPOCH_YEAR) * (_TINYUTC_SECS_PER_DAY * _TINYUTC_DAYS_PER_YEAR);
+        if (utc_tm->month < 1 || utc_tm->month > _TINYUTC_MONTH_PER_YEAR)
+        {
+            return -1;
+        }
 
-        // For each leap year, add an extra day (86400 seconds).
-        for (i = _TINYUTC_UNIX_EPOCH_YEAR; i < utc_tm->year; i++)
+        // Number of days since the Unix epoch, computed in constant time,
+        // then the remaining is trivial: hours, minutes and seconds.
+#ifdef TINYUTC_USE_YEAR_TABLE
+        if (!_tinyutc_year_table_to_days(utc_tm->year, utc_tm->month, utc_tm->day, &days))
+#endif
         {
-            if (_TINYUTC_IS_LEAP_YEAR(i))
-            {
-                *unix_ts += _TINYUTC_SECS_PER_DAY;
-            }
+            days = _tinyutc_days_from_civil(utc_tm->year, utc_tm->month, utc_tm->day);
         }
+        secs = utc_tm->hour * _TINYUTC_SECS_PER_HOUR + utc_tm->minute * _TINYUTC_SECS_PER_MIN + utc_tm->second;
 
-        // For each month, add the number of days in that month.
-        for (i = 1; i < utc_tm->month; i++)
+        // E.g. after 2106-02-07 06:28:15 with 32 bits unsigned timestamps
+        if (!_tinyutc_does_time_fit((int32_t)days, secs))
         {
-            days_in_month = _TINYUTC_GET_DAYS_IN_MONTH(i - 1, utc_tm->year);
-            *unix_ts += _TINYUTC_SECS_PER_DAY * days_in_month;
+            return -1;
         }
 
-        // The remaining is trivial:
-        // days, hours, minutes and seconds.
-        *unix_ts += (utc_tm->day - 1) * _TINYUTC_SECS_PER_DAY;
-        *unix_ts += utc_tm->hour * _TINYUTC_SECS_PER_HOUR;
-        *unix_ts += utc_tm->minute * _TINYUTC_SECS_PER_MIN;
-        *unix_ts += utc_tm->second;
+        *unix_ts = _tinyutc_days_to_time(days) + (tinyutc_time_t)secs;
 
         return 0;
     }
@@ -258,7 +682,7 @@ extern "C"
      *         - 6: Sunday
      *
      *         If the year is before the Unix epoch year (_TINYUTC_UNIX_EPOCH_YEAR),
-     *         the function returns -1.
+     *         or before year 1 with signed timestamps, the function returns -1.
      *
      * @see https://en.wikipedia.org/wiki/Determination_of_the_day_of_the_week#Methods_in_computer_code
      */
@@ -267,11 +691,11 @@ extern "C"
 
         uint8_t w_day;
 
-        uint8_t d = utc_tm->day;
+        uint32_t d = utc_tm->day; // Wide enough for the Keith method, which adds the year to it
         uint8_t m = utc_tm->month;
         uint16_t y = utc_tm->year;
 
-        if (utc_tm->year < _TINYUTC_UNIX_EPOCH_YEAR)
+        if (utc_tm->year < _TINYUTC_MIN_YEAR)
         {
             return -1;
         }
@@ -279,7 +703,9 @@ extern "C"
 
 #ifdef TINYUTC_USE_KEITH_METHOD
         // Implementation of Keith method, verbatim from wikipedia
-        w_day = (d += m < 3 ? y-- : y - 2, 23 * m / 9 + d + 4 + y / 4 - y / 100 + y / 400) % 7;
+        // (the comma expression is split, as _TINYUTC_MOD_7 may evaluate its argument twice)
+        d += m < 3 ? y-- : y - 2;
+        w_day = _TINYUTC_MOD_7(_TINYUTC_DIV_9(23 * m) + d + 4 + y / 4 - _TINYUTC_DIV_100(y) + _TINYUTC_DIV_400(y));
 
 #else
     // Implementation of Sakamoto's method, verbatim from wikipedia
@@ -288,16 +714,626 @@ extern "C"
     {
         y -= 1;
     }
-    w_day = (y + y / 4 - y / 100 + y / 400 + t[m - 1] + d) % 7;
+    w_day = _TINYUTC_MOD_7(y + y / 4 - _TINYUTC_DIV_100(y) + _TINYUTC_DIV_400(y) + t[m - 1] + d);
 
 #endif
         if (!monday_first)
         {
-            w_day = (w_day - 1) % 7;
+            // Shift by 6 instead of -1, so that sunday is 6 and not -1
+            w_day = _TINYUTC_MOD_7(w_day + 6);
         }
         return w_day;
     }
 
+    /**
+     * @brief Number of days since the epoch, made positive for the week day modulo.
+     *
+     * Before 1970 (signed timestamps only), 5 eras of 400 years are added, which
+     * is a whole number of weeks and brings 0001-01-01 after the epoch.
+     *
+     * @param[in] unix_ts The Unix timestamp.
+     *
+     * @return A day count with the same week day as `unix_ts`, 1970-01-01 being 0.
+     */
+    static inline uint32_t _tinyutc_week_day_count(tinyutc_time_t unix_ts)
+    {
+        return (uint32_t)(_tinyutc_floor_days(unix_ts) + (_TINYUTC_TIME_IS_SIGNED ? 5 * _TINYUTC_DAYS_PER_ERA : 0));
+    }
+
+    /**
+     * @brief Calculates the day of the week directly from a Unix timestamp.
+     *
+     * Days since the epoch are counted from 1970-01-01, a thursday, so the
+     * calendar date does not need to be computed at all.
+     *
+     * @param[in] unix_ts      The Unix timestamp.
+     * @param[in] monday_first Same numbering as `tinyutc_get_week_day`.
+     *
+     * @return The day of the week (0-6), the same as `tinyutc_get_week_day`
+     *         would return for the date of `unix_ts`.
+     */
+    static inline uint8_t tinyutc_unix_get_week_day(tinyutc_time_t unix_ts, bool monday_first)
+    {
+        // 1970-01-01 is day 4 when sunday is 0, and day 3 when monday is 0
+        return _TINYUTC_MOD_7(_tinyutc_week_day_count(unix_ts) + (monday_first ? 4 : 3));
+    }
+
+    /**
+     * @brief Week day of a day number, 0 for a monday.
+     *
+     * @param[in] days Number of days since 1970-01-01, negative counts wrapping around
+     *                 (signed timestamps only).
+     */
+    static inline uint32_t _tinyutc_days_week_day(uint32_t days)
+    {
+        // 1970-01-01 is a thursday, and 5 eras (a whole number of weeks) bring year 1 after the epoch
+        return _TINYUTC_MOD_7((uint32_t)(days + (_TINYUTC_TIME_IS_SIGNED ? 5 * _TINYUTC_DAYS_PER_ERA : 0) + 3));
+    }
+
+    /**
+     * @brief Day number of the monday of the first ISO 8601 week of a year,
+     *        the week of January 4th.
+     *
+     * @return The number of days since 1970-01-01, wrapping around when negative.
+     */
+    static inline uint32_t _tinyutc_iso_week_start(uint16_t year)
+    {
+        uint32_t january_4th = _tinyutc_days_from_civil(year, 1, 4);
+
+        return january_4th - _tinyutc_days_week_day(january_4th);
+    }
+
+    /**
+     * @brief Converts an ordinal day to a month and a day of the month.
+     *
+     * January and February are direct, the other months are found with the
+     * linear formula of `_tinyutc_civil_from_days` on the March based year.
+     *
+     * @param[in]  year    Full year (e.g. 2025).
+     * @param[in]  ordinal Day of the year, in range 1-365 (366 for leap years).
+     * @param[out] month   Month, in range 1-12.
+     * @param[out] day     Day of the month, in range 1-31.
+     */
+    static inline void _tinyutc_month_day_from_ordinal(uint16_t year, uint16_t ordinal, uint8_t *month, uint8_t *day)
+    {
+        uint32_t march_1st = 60 + _TINYUTC_IS_LEAP_YEAR(year);
+        uint32_t doy, mp;
+
+        if (ordinal < march_1st)
+        {
+            *month = ordinal > 31 ? 2 : 1;
+            *day = ordinal > 31 ? ordinal - 31 : ordinal;
+            return;
+        }
+
+        doy = ordinal - march_1st;           // Day of (March based) year, [0, 305]
+        mp = _TINYUTC_DIV_153(5 * doy + 2); // March based month, [0, 9]
+
+        *month = mp + 3;
+        *day = doy - _TINYUTC_DIV_5(153 * mp + 2) + 1;
+    }
+
+    /**
+     * @brief Calculates the day of the year of a date.
+     *
+     * @param utc_tm Pointer to a `TinyUTCTime` structure containing the date.
+     *
+     * @return The ordinal day, in range 1-366, or -1 if the year is before the Unix
+     *         epoch year (year 1 with signed timestamps) or the month is invalid.
+     */
+    static inline err_t tinyutc_get_ordinal_day(const struct TinyUTCTime *utc_tm)
+    {
+        if (utc_tm->year < _TINYUTC_MIN_YEAR || utc_tm->month < 1 || utc_tm->month > 12)
+        {
+            return -1;
+        }
+
+        if (utc_tm->month <= 2)
+        {
+            return (utc_tm->month == 2 ? 31 : 0) + utc_tm->day;
+        }
+
+        return 60 + _TINYUTC_IS_LEAP_YEAR(utc_tm->year) + _TINYUTC_DIV_5(153 * (utc_tm->month - 3) + 2) + utc_tm->day - 1;
+    }
+
+    /**
+     * @brief Calculates the ISO 8601 week of a date.
+     *
+     * Weeks start on mondays, and the first week of a year is the one of its first
+     * thursday: the first days of January may belong to the last week of the previous
+     * year, and the last days of December to the first week of the next one. The day
+     * of the week is given by `tinyutc_get_week_day`.
+     *
+     * @param[in]  utc_tm   Pointer to a `TinyUTCTime` structure containing the date.
+     * @param[out] iso_year Year the week belongs to.
+     * @param[out] week     Week number, in range 1-53.
+     *
+     * @return 0 on success, or -1 if the year is before the Unix epoch year (year 1
+     *         with signed timestamps), the month is invalid, or the date is in the
+     *         first week of year 65536.
+     */
+    static inline err_t tinyutc_get_iso_week(const struct TinyUTCTime *utc_tm, uint16_t *iso_year, uint8_t *week)
+    {
+        uint32_t days, start, december_28th, next;
+        uint16_t year = utc_tm->year;
+
+        if (year < _TINYUTC_MIN_YEAR || utc_tm->month < 1 || utc_tm->month > 12)
+        {
+            return -1;
+        }
+
+        days = _tinyutc_days_from_civil(year, utc_tm->month, utc_tm->day);
+        start = _tinyutc_iso_week_start(year);
+
+        // December 28th is always in the last week of its year
+        december_28th = _tinyutc_days_from_civil(year, 12, 28);
+        next = december_28th - _tinyutc_days_week_day(december_28th) + 7;
+
+        // Differences are taken as signed, day numbers wrapping around before 1970
+        if ((int32_t)(days - start) < 0)
+        {
+            start = _tinyutc_iso_week_start(--year);
+        }
+        else if ((int32_t)(days - next) >= 0)
+        {
+            if (year == _TINYUTC_MAX_YEAR)
+            {
+                return -1;
+            }
+
+            start = next;
+            year++;
+        }
+
+        *iso_year = year;
+        *week = _TINYUTC_DIV_7(days - start) + 1;
+        return 0;
+    }
+
+    /**
+     * @struct TinyUTCColumns
+     * @brief  UTC time fields stored as separate arrays (struct of arrays).
+     *
+     * Used by the batch functions, this layout has no padding and lets the
+     * compiler vectorize the conversion loops. Each array must hold at least
+     * as many elements as the batch being converted.
+     */
+    struct TinyUTCColumns
+    {
+        uint16_t *year;
+        uint8_t *month;
+        uint8_t *day;
+        uint8_t *hour;
+        uint8_t *minute;
+        uint8_t *second;
+    };
+
+    /**
+     * @brief Converts an array of Unix timestamps to an array of UTC time structures.
+     *
+     * The microseconds field of each structure is set to 0.
+     *
+     * @param[out] utc_tm  Array of at least `count` TinyUTCTime structures.
+     * @param[in]  unix_ts Array of `count` Unix timestamps to be converted.
+     * @param[in]  count   Number of timestamps to convert.
+     *
+     * @return 0 on success, -1 if at least one timestamp could not be converted
+     *         (only possible with 64 bits or signed timestamps, its structure is
+     *         then set to 1970-01-01 00:00:00).
+     */
+    static inline err_t tinyutc_unix_to_utc_batch(struct TinyUTCTime *_TINYUTC_RESTRICT utc_tm, const tinyutc_time_t *_TINYUTC_RESTRICT unix_ts, size_t count)
+    {
+        uint32_t invalid_count = 0;
+
+        _TINYUTC_VECTORIZE_LOOP
+        for (size_t i = 0; i < count; i++)
+        {
+            // Checks are accumulated instead of breaking the loop
+            bool is_invalid = !_tinyutc_is_time_in_range(unix_ts[i]);
+            uint32_t days = _tinyutc_time_of_day(is_invalid ? 0 : unix_ts[i], &utc_tm[i].hour, &utc_tm[i].minute, &utc_tm[i].second);
+
+            utc_tm[i].microseconds = 0;
+            _tinyutc_civil_from_days(days, &utc_tm[i].year, &utc_tm[i].month, &utc_tm[i].day);
+            invalid_count += is_invalid;
+        }
+
+        return invalid_count ? -1 : 0;
+    }
+
+    static inline err_t _tinyutc_unix_to_utc_columns(uint16_t *_TINYUTC_RESTRICT year, uint8_t *_TINYUTC_RESTRICT month, uint8_t *_TINYUTC_RESTRICT day,
+                                                     uint8_t *_TINYUTC_RESTRICT hour, uint8_t *_TINYUTC_RESTRICT minute, uint8_t *_TINYUTC_RESTRICT second,
+                                                     const tinyutc_time_t *_TINYUTC_RESTRICT unix_ts, size_t count)
+    {
+        uint32_t invalid_count = 0;
+
+        _TINYUTC_VECTORIZE_LOOP
+        for (size_t i = 0; i < count; i++)
+        {
+            // Checks are accumulated instead of breaking the loop
+            bool is_invalid = !_tinyutc_is_time_in_range(unix_ts[i]);
+            uint32_t days = _tinyutc_time_of_day(is_invalid ? 0 : unix_ts[i], &hour[i], &minute[i], &second[i]);
+
+            _tinyutc_civil_from_days(days, &year[i], &month[i], &day[i]);
+            invalid_count += is_invalid;
+        }
+
+        return invalid_count ? -1 : 0;
+    }
+
+    /**
+     * @brief Converts an array of Unix timestamps to UTC time columns.
+     *
+     * Each iteration is branchless and only writes to plain arrays, so that
+     * the loop is auto-vectorized when built with optimizations.
+     *
+     * @param[out] columns Columns receiving the UTC time fields.
+     * @param[in]  unix_ts Array of `count` Unix timestamps to be converted.
+     * @param[in]  count   Number of timestamps to convert.
+     *
+     * @return 0 on success, -1 if at least one timestamp could not be converted
+     *         (as `tinyutc_unix_to_utc_batch`).
+     */
+    static inline err_t tinyutc_unix_to_utc_batch_columns(const struct TinyUTCColumns *columns, const tinyutc_time_t *unix_ts, size_t count)
+    {
+        return _tinyutc_unix_to_utc_columns(columns->year, columns->month, columns->day,
+                                            columns->hour, columns->minute, columns->second, unix_ts, count);
+    }
+
+    /**
+     * @brief Converts an array of UTC time structures to an array of Unix timestamps.
+     *
+     * @param[out] unix_ts Array of at least `count` Unix timestamps.
+     * @param[in]  utc_tm  Array of `count` TinyUTCTime structures to be converted.
+     * @param[in]  count   Number of structures to convert.
+     *
+     * @return 0 on success, -1 if at least one structure could not be converted
+     *         (its timestamp is then set to 0).
+     */
+    static inline err_t tinyutc_utc_to_unix_batch(tinyutc_time_t *_TINYUTC_RESTRICT unix_ts, const struct TinyUTCTime *_TINYUTC_RESTRICT utc_tm, size_t count)
+    {
+        uint32_t invalid_count = 0;
+
+        _TINYUTC_VECTORIZE_LOOP
+        for (size_t i = 0; i < count; i++)
+        {
+            // Checks are accumulated instead of breaking the loop
+            uint32_t days = _tinyutc_days_from_civil(utc_tm[i].year, utc_tm[i].month, utc_tm[i].day);
+            uint32_t secs = utc_tm[i].hour * _TINYUTC_SECS_PER_HOUR + utc_tm[i].minute * _TINYUTC_SECS_PER_MIN + utc_tm[i].second;
+            bool is_invalid = (utc_tm[i].year < _TINYUTC_MIN_YEAR) | ((uint8_t)(utc_tm[i].month - 1) >= _TINYUTC_MONTH_PER_YEAR) |
+                              !_tinyutc_does_time_fit((int32_t)days, secs);
+            tinyutc_time_t ts = _tinyutc_days_to_time(days) + (tinyutc_time_t)secs;
+
+            unix_ts[i] = is_invalid ? 0 : ts;
+            invalid_count += is_invalid;
+        }
+
+        return invalid_count ? -1 : 0;
+    }
+
+    static inline err_t _tinyutc_utc_to_unix_columns(tinyutc_time_t *_TINYUTC_RESTRICT unix_ts,
+                                                     const uint16_t *_TINYUTC_RESTRICT year, const uint8_t *_TINYUTC_RESTRICT month, const uint8_t *_TINYUTC_RESTRICT day,
+                                                     const uint8_t *_TINYUTC_RESTRICT hour, const uint8_t *_TINYUTC_RESTRICT minute, const uint8_t *_TINYUTC_RESTRICT second,
+                                                     size_t count)
+    {
+        uint32_t invalid_count = 0;
+
+        _TINYUTC_VECTORIZE_LOOP
+        for (size_t i = 0; i < count; i++)
+        {
+            // Checks are accumulated instead of breaking the loop
+            uint32_t days = _tinyutc_days_from_civil(year[i], month[i], day[i]);
+            uint32_t secs = hour[i] * _TINYUTC_SECS_PER_HOUR + minute[i] * _TINYUTC_SECS_PER_MIN + second[i];
+            bool is_invalid = (year[i] < _TINYUTC_MIN_YEAR) | ((uint8_t)(month[i] - 1) >= _TINYUTC_MONTH_PER_YEAR) |
+                              !_tinyutc_does_time_fit((int32_t)days, secs);
+            tinyutc_time_t ts = _tinyutc_days_to_time(days) + (tinyutc_time_t)secs;
+
+            unix_ts[i] = is_invalid ? 0 : ts;
+            invalid_count += is_invalid;
+        }
+
+        return invalid_count ? -1 : 0;
+    }
+
+    /**
+     * @brief Converts UTC time columns to an array of Unix timestamps.
+     *
+     * @param[out] unix_ts Array of at least `count` Unix timestamps.
+     * @param[in]  columns Columns holding the UTC time fields to be converted.
+     * @param[in]  count   Number of elements to convert.
+     *
+     * @return 0 on success, -1 if at least one element could not be converted
+     *         (its timestamp is then set to 0).
+     */
+    static inline err_t tinyutc_utc_to_unix_batch_columns(tinyutc_time_t *unix_ts, const struct TinyUTCColumns *columns, size_t count)
+    {
+        return _tinyutc_utc_to_unix_columns(unix_ts, columns->year, columns->month, columns->day,
+                                            columns->hour, columns->minute, columns->second, count);
+    }
+
+    /**
+     * @brief Calculates the days of the week of an array of Unix timestamps.
+     *
+     * @param[out] week_day     Array of at least `count` days of the week.
+     * @param[in]  unix_ts      Array of `count` Unix timestamps.
+     * @param[in]  count        Number of timestamps.
+     * @param[in]  monday_first Same numbering as `tinyutc_get_week_day`.
+     */
+    static inline void tinyutc_unix_get_week_day_batch(uint8_t *_TINYUTC_RESTRICT week_day, const tinyutc_time_t *_TINYUTC_RESTRICT unix_ts,
+                                                       size_t count, bool monday_first)
+    {
+        uint32_t offset = monday_first ? 4 : 3;
+
+        _TINYUTC_VECTORIZE_LOOP
+        for (size_t i = 0; i < count; i++)
+        {
+            week_day[i] = _TINYUTC_MOD_7(_tinyutc_week_day_count(unix_ts[i]) + offset);
+        }
+    }
+
+    /**
+     * @struct TinyUTCCursor
+     * @brief  Incremental converter, for timestamps that mostly increase by small steps.
+     *
+     * The cursor remembers the start of the day of the last converted timestamp, and
+     * its date. A timestamp in the same day only needs its time of the day to be split,
+     * and a timestamp in the next day moves the date by one day. Any other timestamp
+     * (backward jump, gap of more than a day) is a full conversion.
+     *
+     * Initialize with `tinyutc_cursor_init`. Fields are not meant to be written by
+     * the user, but the counters can be read (and reset) freely.
+     */
+    struct TinyUTCCursor
+    {
+        tinyutc_time_t day_start; // Timestamp of the midnight of the cached day
+        uint16_t year;            // Date of the cached day
+        uint8_t month;
+        uint8_t day;
+        bool is_valid;   // False until a first conversion succeeds
+        uint32_t hits;   // Conversions in the cached day, or the next one
+        uint32_t misses; // Full conversions
+    };
+
+    /**
+     * @brief Initializes a cursor, with an empty cache and counters set to 0.
+     *
+     * @param[out] cursor The cursor to initialize.
+     */
+    static inline void tinyutc_cursor_init(struct TinyUTCCursor *cursor)
+    {
+        cursor->day_start = 0;
+        cursor->year = 0;
+        cursor->month = 0;
+        cursor->day = 0;
+        cursor->is_valid = false;
+        cursor->hits = 0;
+        cursor->misses = 0;
+    }
+
+    /**
+     * @brief Converts a Unix timestamp to a UTC time structure, reusing the date
+     *        of the previous conversion when possible.
+     *
+     * Results are the same as `tinyutc_unix_to_utc`.
+     *
+     * @param[in,out] cursor  The cursor, updated to the day of `unix_ts`.
+     * @param[out]    utc_tm  Pointer to a TinyUTCTime structure receiving the result.
+     * @param[in]     unix_ts The Unix timestamp to be converted.
+     *
+     * @return 0 on success, -1 if the timestamp can not be converted (the cursor is then left unchanged).
+     */
+    static inline err_t tinyutc_cursor_unix_to_utc(struct TinyUTCCursor *cursor, struct TinyUTCTime *utc_tm, tinyutc_time_t unix_ts)
+    {
+        // Computed as unsigned, so that it can not overflow with signed timestamps
+        uint64_t elapsed = (uint64_t)unix_ts - (uint64_t)cursor->day_start;
+        // The day after 65535-12-31 can not be held, it goes to the full conversion which rejects it
+        bool can_carry = cursor->year < _TINYUTC_MAX_YEAR || cursor->month < _TINYUTC_MONTH_PER_YEAR || cursor->day < 31;
+
+        if (cursor->is_valid && unix_ts >= cursor->day_start && elapsed < (can_carry ? 2 : 1) * _TINYUTC_SECS_PER_DAY)
+        {
+            if (elapsed >= _TINYUTC_SECS_PER_DAY)
+            {
+                // Carry to the next day, then month, then year
+                elapsed -= _TINYUTC_SECS_PER_DAY;
+                cursor->day_start += _TINYUTC_SECS_PER_DAY;
+
+                if (++cursor->day > _TINYUTC_GET_DAYS_IN_MONTH(cursor->month - 1, cursor->year))
+                {
+                    cursor->day = 1;
+                    if (++cursor->month > _TINYUTC_MONTH_PER_YEAR)
+                    {
+                        cursor->month = 1;
+                        cursor->year++;
+                    }
+                }
+            }
+
+            _tinyutc_split_seconds_of_day((uint32_t)elapsed, &utc_tm->hour, &utc_tm->minute, &utc_tm->second);
+            utc_tm->year = cursor->year;
+            utc_tm->month = cursor->month;
+            utc_tm->day = cursor->day;
+
+            cursor->hits++;
+            return 0;
+        }
+
+        if (tinyutc_unix_to_utc(utc_tm, unix_ts) != 0)
+        {
+            return -1;
+        }
+
+        cursor->day_start = unix_ts - (utc_tm->hour * _TINYUTC_SECS_PER_HOUR + utc_tm->minute * _TINYUTC_SECS_PER_MIN + utc_tm->second);
+        cursor->year = utc_tm->year;
+        cursor->month = utc_tm->month;
+        cursor->day = utc_tm->day;
+        cursor->is_valid = true;
+
+        cursor->misses++;
+        return 0;
+    }
+
+    /**
+     * @enum TinyUTCMonthPolicy
+     * @brief What `tinyutc_add_months` does when the day does not exist in the resulting month.
+     */
+    enum TinyUTCMonthPolicy
+    {
+        TINYUTC_MONTH_CLAMP = 0,    // Use the last day of the month: 01/31 + 1 month = 02/28
+        TINYUTC_MONTH_OVERFLOW = 1, // Carry the extra days to the next month: 01/31 + 1 month = 03/03
+    };
+
+    /**
+     * @brief Adds a number of days to a UTC time structure, in place.
+     *
+     * Staying in the same month, or moving to a neighbouring month by less than
+     * 28 days, is a simple carry. Larger deltas go through the day count.
+     *
+     * @param[in,out] utc_tm Pointer to a valid TinyUTCTime structure.
+     * @param[in]     days   Number of days to add, may be negative.
+     *
+     * @return 0 on success, -1 if the result is before 1970 (year 1 with signed
+     *         timestamps), or after 65535 (the structure is then left unchanged).
+     */
+    static inline err_t tinyutc_add_days(struct TinyUTCTime *utc_tm, int32_t days)
+    {
+        uint8_t days_in_month = _TINYUTC_GET_DAYS_IN_MONTH(utc_tm->month - 1, utc_tm->year);
+        int32_t count;
+
+        // Every month has at least 28 days, so small deltas carry at most one month
+        if (days > -28 && days < 28)
+        {
+            int32_t day = (int32_t)utc_tm->day + days;
+
+            if (day >= 1 && day <= days_in_month)
+            {
+                utc_tm->day = day;
+                return 0;
+            }
+            if (day > days_in_month && (utc_tm->month < _TINYUTC_MONTH_PER_YEAR || utc_tm->year < _TINYUTC_MAX_YEAR))
+            {
+                utc_tm->day = day - days_in_month;
+                utc_tm->year += utc_tm->month == _TINYUTC_MONTH_PER_YEAR;
+                utc_tm->month = utc_tm->month == _TINYUTC_MONTH_PER_YEAR ? 1 : utc_tm->month + 1;
+                return 0;
+            }
+            if (day < 1 && (utc_tm->month > 1 || utc_tm->year > _TINYUTC_MIN_YEAR))
+            {
+                utc_tm->year -= utc_tm->month == 1;
+                utc_tm->month = utc_tm->month == 1 ? (uint8_t)_TINYUTC_MONTH_PER_YEAR : (uint8_t)(utc_tm->month - 1);
+                utc_tm->day = day + _TINYUTC_GET_DAYS_IN_MONTH(utc_tm->month - 1, utc_tm->year);
+                return 0;
+            }
+            return -1;
+        }
+
+        // Negative before 1970, with signed timestamps
+        count = (int32_t)_tinyutc_days_from_civil(utc_tm->year, utc_tm->month, utc_tm->day);
+
+        if (days < 0 ? days < _TINYUTC_MIN_DAYS - count : days > (int32_t)_TINYUTC_MAX_DAYS - count)
+        {
+            return -1;
+        }
+
+        _tinyutc_civil_from_days((uint32_t)(count + days), &utc_tm->year, &utc_tm->month, &utc_tm->day);
+
+        return 0;
+    }
+
+    /**
+     * @brief Adds a number of seconds to a UTC time structure, in place.
+     *
+     * The delta is split in days and seconds, the seconds are added to the time
+     * of the day, and the days (with the carry) are added by `tinyutc_add_days`.
+     * Minutes and hours are added with this function too, e.g. `3 * 60` seconds.
+     *
+     * @param[in,out] utc_tm  Pointer to a valid TinyUTCTime structure.
+     * @param[in]     seconds Number of seconds to add, may be negative.
+     *
+     * @return 0 on success, -1 if the result is before 1970 (year 1 with signed
+     *         timestamps), or after 65535 (the structure is then left unchanged).
+     */
+    static inline err_t tinyutc_add_seconds(struct TinyUTCTime *utc_tm, int32_t seconds)
+    {
+        uint32_t magnitude = seconds < 0 ? 0U - (uint32_t)seconds : (uint32_t)seconds;
+        int32_t days = _TINYUTC_DIV_SECS_PER_DAY(magnitude);
+        int32_t secs = magnitude - days * _TINYUTC_SECS_PER_DAY;
+
+        if (seconds < 0)
+        {
+            days = -days;
+            secs = -secs;
+        }
+
+        secs += utc_tm->hour * _TINYUTC_SECS_PER_HOUR + utc_tm->minute * _TINYUTC_SECS_PER_MIN + utc_tm->second;
+        if (secs >= (int32_t)_TINYUTC_SECS_PER_DAY)
+        {
+            secs -= _TINYUTC_SECS_PER_DAY;
+            days++;
+        }
+        else if (secs < 0)
+        {
+            secs += _TINYUTC_SECS_PER_DAY;
+            days--;
+        }
+
+        if (days != 0 && tinyutc_add_days(utc_tm, days) != 0)
+        {
+            return -1;
+        }
+
+        _tinyutc_split_seconds_of_day(secs, &utc_tm->hour, &utc_tm->minute, &utc_tm->second);
+
+        return 0;
+    }
+
+    /**
+     * @brief Adds a number of months to a UTC time structure, in place.
+     *
+     * The time of the day is kept. When the day does not exist in the resulting
+     * month (e.g. the 31st), `policy` either clamps it to the last day of the
+     * month, or carries the extra days to the next month.
+     *
+     * @param[in,out] utc_tm Pointer to a valid TinyUTCTime structure.
+     * @param[in]     months Number of months to add, may be negative.
+     * @param[in]     policy What to do with days past the end of the month.
+     *
+     * @return 0 on success, -1 if the result is before 1970 (year 1 with signed
+     *         timestamps), or after 65535 (the structure is then left unchanged).
+     */
+    static inline err_t tinyutc_add_months(struct TinyUTCTime *utc_tm, int32_t months, enum TinyUTCMonthPolicy policy)
+    {
+        const int32_t first = _TINYUTC_MIN_YEAR * _TINYUTC_MONTH_PER_YEAR;
+        const int32_t last = _TINYUTC_MAX_YEAR * _TINYUTC_MONTH_PER_YEAR + _TINYUTC_MONTH_PER_YEAR - 1;
+        struct TinyUTCTime result = *utc_tm;
+        int32_t total, extra_days;
+        uint8_t days_in_month;
+
+        // Months since year 0, checked before adding to not overflow
+        total = utc_tm->year * _TINYUTC_MONTH_PER_YEAR + utc_tm->month - 1;
+        if (months < first - total || months > last - total)
+        {
+            return -1;
+        }
+        total += months;
+
+        result.year = _TINYUTC_DIV_12(total);
+        result.month = total - result.year * _TINYUTC_MONTH_PER_YEAR + 1;
+
+        days_in_month = _TINYUTC_GET_DAYS_IN_MONTH(result.month - 1, result.year);
+        extra_days = (int32_t)result.day - days_in_month;
+        if (extra_days > 0)
+        {
+            result.day = days_in_month;
+            if (policy == TINYUTC_MONTH_OVERFLOW && tinyutc_add_days(&result, extra_days) != 0)
+            {
+                return -1;
+            }
+        }
+
+        *utc_tm = result;
+
+        return 0;
+    }
+
 #ifdef __cplusplus
 }
 #endif
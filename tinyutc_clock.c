@@ -0,0 +1,117 @@
+/**
+ * @file tinyutc_clock.c
+ * @brief Cached clock for TinyUTC library.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * The sequence lock follows H.-J. Boehm, "Can Seqlocks Get Along With Programming
+ * Language Memory Models?": the protected words are atomics accessed with relaxed
+ * ordering, so a reader racing with the updater copies torn words, but never reads
+ * them as a data race, and throws them away when the sequence moved.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "tinyutc.h"
+#include "iso8601_formatter.h"
+#include "http_date.h"
+#include "tinyutc_clock.h"
+
+void tinyutc_clock_init(struct TinyUTCClock *clock, int32_t utc_offset, uint32_t flags)
+{
+    atomic_init(&clock->sequence, 0);
+    for (size_t i = 0; i < _TINYUTC_CLOCK_WORDS; i++)
+    {
+        atomic_init(&clock->words[i], 0);
+    }
+    atomic_init(&clock->unix_ts, 0);
+    tinyutc_format_cache_init(&clock->format, utc_offset, flags);
+    tinyutc_cursor_init(&clock->cursor);
+    clock->http[0] = '\0';
+}
+
+err_t tinyutc_clock_update(struct TinyUTCClock *clock, tinyutc_time_t unix_ts, uint32_t micros)
+{
+    uint64_t words[_TINYUTC_CLOCK_WORDS] = {0};
+    struct TinyUTCClockTime time;
+    bool is_new_second = !clock->format.is_valid || clock->format.second != unix_ts;
+    uint32_t sequence;
+    size_t len;
+
+    memset(&time, 0, sizeof(time)); // Padding bytes too, as they are published
+    time.unix_ts = unix_ts;
+    if (tinyutc_cursor_unix_to_utc(&clock->cursor, &time.utc, unix_ts) != 0)
+    {
+        return -1;
+    }
+    time.utc.microseconds = micros;
+
+    len = tinyutc_format_cache_unix_iso8601(&clock->format, unix_ts, micros, time.iso, sizeof(time.iso));
+    if (len == 0)
+    {
+        return -1;
+    }
+    time.iso_len = (uint8_t)len;
+
+    // Year 10000 in UTC can still be 9999 in local time, the HTTP-date is then empty
+    if (is_new_second && tinyutc_format_http_date(&time.utc, clock->http, sizeof(clock->http)) == 0)
+    {
+        clock->http[0] = '\0';
+    }
+    memcpy(time.http, clock->http, sizeof(time.http));
+    memcpy(words, &time, sizeof(time));
+
+    // Odd sequence, ordered before the words by the release fence
+    sequence = atomic_load_explicit(&clock->sequence, memory_order_relaxed);
+    atomic_store_explicit(&clock->sequence, sequence + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    for (size_t i = 0; i < _TINYUTC_CLOCK_WORDS; i++)
+    {
+        atomic_store_explicit(&clock->words[i], words[i], memory_order_relaxed);
+    }
+    atomic_store_explicit(&clock->unix_ts, unix_ts, memory_order_relaxed);
+
+    // Even sequence, released after the words
+    atomic_store_explicit(&clock->sequence, sequence + 2, memory_order_release);
+    return 0;
+}
+
+err_t tinyutc_clock_read(struct TinyUTCClock *clock, struct TinyUTCClockTime *time)
+{
+    uint64_t words[_TINYUTC_CLOCK_WORDS];
+    uint32_t begin, end;
+
+    do
+    {
+        begin = atomic_load_explicit(&clock->sequence, memory_order_acquire);
+        for (size_t i = 0; i < _TINYUTC_CLOCK_WORDS; i++)
+        {
+            words[i] = atomic_load_explicit(&clock->words[i], memory_order_relaxed);
+        }
+
+        // Words loaded before the sequence is checked again
+        atomic_thread_fence(memory_order_acquire);
+        end = atomic_load_explicit(&clock->sequence, memory_order_relaxed);
+    } while ((begin & 1) != 0 || begin != end);
+
+    // Words are still zero when nothing was published, but a published datetime is never empty
+    memcpy(time, words, sizeof(*time));
+    return time->iso_len != 0 ? 0 : -1;
+}
+
+tinyutc_time_t tinyutc_clock_now(struct TinyUTCClock *clock)
+{
+    return atomic_load_explicit(&clock->unix_ts, memory_order_relaxed);
+}
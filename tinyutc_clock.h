@@ -0,0 +1,118 @@
+/**
+ * @file tinyutc_clock.h
+ * @brief Cached clock, shared by many reader threads and updated by a single one.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * The updater converts and formats the current time once, and publishes it behind
+ * a sequence lock: readers copy the published time without any lock or conversion,
+ * and only retry when an update was in progress. Needs C11 atomics.
+ */
+
+#ifndef TINYUTC_CLOCK_H
+#define TINYUTC_CLOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "tinyutc.h"
+#include "iso8601_formatter.h"
+#include "http_date.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**
+     * @struct TinyUTCClockTime
+     * @brief  Time published by a `TinyUTCClock`.
+     */
+    struct TinyUTCClockTime
+    {
+        tinyutc_time_t unix_ts;            // Unix timestamp, in seconds
+        struct TinyUTCTime utc;            // Same time in UTC, microseconds included
+        uint8_t iso_len;                   // Length of `iso`
+        char iso[TINYUTC_FORMAT_MAX_SIZE]; // ISO 8601 datetime, with the offset and flags of the clock
+        char http[TINYUTC_HTTP_DATE_SIZE]; // HTTP-date, for `Date:` headers
+    };
+
+#define _TINYUTC_CLOCK_WORDS ((sizeof(struct TinyUTCClockTime) + 7) / 8)
+
+    /**
+     * @struct TinyUTCClock
+     * @brief  Shared clock, written by `tinyutc_clock_update` and read by `tinyutc_clock_read`.
+     *
+     * The published time is stored as atomic words, written between two increments of
+     * `sequence`: a reader that sees the same even sequence before and after its copy has
+     * a consistent time. Only one thread may update the clock at a time, any number may
+     * read it.
+     *
+     * Initialize with `tinyutc_clock_init`. Fields are not meant to be accessed by the user.
+     */
+    struct TinyUTCClock
+    {
+        _Atomic(uint32_t) sequence;                    // Odd while an update is in progress
+        _Atomic(uint64_t) words[_TINYUTC_CLOCK_WORDS]; // Published TinyUTCClockTime
+        _Atomic(tinyutc_time_t) unix_ts;               // Published timestamp alone, for `tinyutc_clock_now`
+        struct TinyUTCFormatCache format;              // Updater only
+        struct TinyUTCCursor cursor;                   // Updater only
+        char http[TINYUTC_HTTP_DATE_SIZE];             // Updater only, HTTP-date of `format.second`
+    };
+
+    /**
+     * @brief Initializes a clock, with no time published.
+     *
+     * @param[out] clock      The clock to initialize.
+     * @param[in]  utc_offset Offset of the ISO 8601 datetime, as in `tinyutc_format_unix_iso8601`.
+     * @param[in]  flags      Combination of `TINYUTC_FORMAT_*` flags for the ISO 8601 datetime, or 0.
+     */
+    void tinyutc_clock_init(struct TinyUTCClock *clock, int32_t utc_offset, uint32_t flags);
+
+    /**
+     * @brief Converts and formats a time, then publishes it to the readers.
+     *
+     * Must not be called by two threads at the same time. Timestamps of the same
+     * second as the previous update are only formatted again for their fraction,
+     * and keep the HTTP-date of the previous update.
+     *
+     * @param[in,out] clock   The clock.
+     * @param[in]     unix_ts The current Unix timestamp.
+     * @param[in]     micros  Microseconds of the timestamp, in range 0-999999.
+     * @return err_t 0 on success, -1 if the time can not be converted or formatted
+     *         (the published time is then left unchanged).
+     */
+    err_t tinyutc_clock_update(struct TinyUTCClock *clock, tinyutc_time_t unix_ts, uint32_t micros);
+
+    /**
+     * @brief Copies the last time published, without any lock.
+     *
+     * @param[in]  clock The clock.
+     * @param[out] time  The time, consistent with a single update.
+     * @return err_t 0 on success, -1 if no time was published yet.
+     */
+    err_t tinyutc_clock_read(struct TinyUTCClock *clock, struct TinyUTCClockTime *time);
+
+    /**
+     * @brief Returns the timestamp of the last time published, with a single atomic load.
+     *
+     * @param[in] clock The clock.
+     * @return tinyutc_time_t The timestamp, 0 if no time was published yet.
+     */
+    tinyutc_time_t tinyutc_clock_now(struct TinyUTCClock *clock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TINYUTC_CLOCK_H
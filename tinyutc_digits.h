@@ -0,0 +1,77 @@
+/**
+ * @file tinyutc_digits.h
+ * @brief Digit writers shared by the ISO 8601, HTTP-date and pattern formatters.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Private header, only included by the formatters. Numbers are written two digits
+ * at a time from a lookup table, and split with the `_TINYUTC_DIV_*` macros, so that
+ * `TINYUTC_NO_HW_DIVIDE` applies to them too.
+ */
+
+#ifndef TINYUTC_DIGITS_H
+#define TINYUTC_DIGITS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "tinyutc.h"
+
+/**
+ * @brief Writes a number from 0 to 99 as two digits.
+ */
+static inline void _tinyutc_format_pair(char *buf, uint32_t value)
+{
+    // Two characters for each number from 00 to 99
+    static const char digit_pairs[201] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    buf[0] = digit_pairs[2 * value];
+    buf[1] = digit_pairs[2 * value + 1];
+}
+
+/**
+ * @brief Writes a fraction of second, without its '.'.
+ *
+ * @param[out] buf          Buffer receiving the digits, without a terminator.
+ * @param[in]  microseconds Microseconds of the second, in range 0-999999.
+ * @param[in]  digits       6 for microseconds, or 3 for milliseconds (truncated).
+ *
+ * @return The end of the fraction.
+ */
+static inline char *_tinyutc_format_fraction(char *buf, uint32_t microseconds, size_t digits)
+{
+    uint32_t high = _TINYUTC_DIV_10000(microseconds); // First two digits
+    uint32_t low = microseconds - high * 10000;       // Last four digits
+    uint32_t middle = _TINYUTC_DIV_100(low);
+
+    _tinyutc_format_pair(buf, high);
+    if (digits == 6)
+    {
+        _tinyutc_format_pair(buf + 2, middle);
+        _tinyutc_format_pair(buf + 4, low - middle * 100);
+        return buf + 6;
+    }
+
+    buf[2] = (char)('0' + _TINYUTC_DIV_10(middle));
+    return buf + 3;
+}
+
+#endif // TINYUTC_DIGITS_H
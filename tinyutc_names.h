@@ -0,0 +1,100 @@
+/**
+ * @file tinyutc_names.h
+ * @brief English week day and month abbreviations, shared by the HTTP-date and pattern modules.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Private header, only included by `http_date.c` and `tinyutc_pattern.c`, so that
+ * the name tables stay out of the translation units which only include `tinyutc.h`.
+ */
+
+#ifndef TINYUTC_NAMES_H
+#define TINYUTC_NAMES_H
+
+#include <stdint.h>
+
+// Three letters packed in a word, the first one in the low byte
+#define _TINYUTC_NAME(A, B, C) ((uint32_t)(A) | (uint32_t)(B) << 8 | (uint32_t)(C) << 16)
+
+// Perfect hashes of the packed English abbreviations: multipliers found by search, so that
+// the high bits of the product are different for each name, and a single compare confirms it
+#define _TINYUTC_WEEK_DAY_NAME_SLOT(WORD) ((uint32_t)((WORD) * 2522UL) >> 29)
+#define _TINYUTC_MONTH_NAME_SLOT(WORD) ((uint32_t)((WORD) * 26596UL) >> 28)
+
+/**
+ * @brief English abbreviation of a week day ("Mon"), numbered as `tinyutc_get_week_day(utc_tm, false)`.
+ */
+static inline const char *_tinyutc_week_day_name(uint8_t week_day)
+{
+    static const char names[7][4] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+    return names[week_day];
+}
+
+/**
+ * @brief English abbreviation of a month ("Jan"), from 1.
+ */
+static inline const char *_tinyutc_month_name(uint8_t month)
+{
+    static const char names[12][4] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    return names[month - 1];
+}
+
+static inline uint32_t _tinyutc_load_name(const char *str)
+{
+    return _TINYUTC_NAME((unsigned char)str[0], (unsigned char)str[1], (unsigned char)str[2]);
+}
+
+/**
+ * @brief Week day of a case-sensitive English abbreviation, without scanning the names.
+ *
+ * @param[in] str At least three characters.
+ *
+ * @return The week day, numbered as `tinyutc_get_week_day(utc_tm, false)`, or -1.
+ */
+static inline int _tinyutc_week_day_from_name(const char *str)
+{
+    // Week day and name, by hash slot
+    static const uint32_t slots[8][2] = {
+        {_TINYUTC_NAME('F', 'r', 'i'), 4}, {_TINYUTC_NAME('M', 'o', 'n'), 0}, {_TINYUTC_NAME('S', 'u', 'n'), 6},
+        {_TINYUTC_NAME('S', 'a', 't'), 5}, {_TINYUTC_NAME('T', 'h', 'u'), 3}, {0, 0},
+        {_TINYUTC_NAME('W', 'e', 'd'), 2}, {_TINYUTC_NAME('T', 'u', 'e'), 1},
+    };
+    uint32_t word = _tinyutc_load_name(str);
+    const uint32_t *slot = slots[_TINYUTC_WEEK_DAY_NAME_SLOT(word)];
+
+    return slot[0] == word ? (int)slot[1] : -1;
+}
+
+/**
+ * @brief Month of a case-sensitive English abbreviation, without scanning the names.
+ *
+ * @param[in] str At least three characters.
+ *
+ * @return The month, from 1, or -1.
+ */
+static inline int _tinyutc_month_from_name(const char *str)
+{
+    // Month and name, by hash slot
+    static const uint32_t slots[16][2] = {
+        {_TINYUTC_NAME('J', 'u', 'l'), 7}, {_TINYUTC_NAME('N', 'o', 'v'), 11}, {0, 0},
+        {_TINYUTC_NAME('O', 'c', 't'), 10}, {_TINYUTC_NAME('M', 'a', 'y'), 5}, {_TINYUTC_NAME('D', 'e', 'c'), 12},
+        {_TINYUTC_NAME('M', 'a', 'r'), 3}, {_TINYUTC_NAME('A', 'p', 'r'), 4}, {0, 0},
+        {_TINYUTC_NAME('S', 'e', 'p'), 9}, {0, 0}, {0, 0},
+        {_TINYUTC_NAME('J', 'a', 'n'), 1}, {_TINYUTC_NAME('J', 'u', 'n'), 6}, {_TINYUTC_NAME('F', 'e', 'b'), 2},
+        {_TINYUTC_NAME('A', 'u', 'g'), 8},
+    };
+    uint32_t word = _tinyutc_load_name(str);
+    const uint32_t *slot = slots[_TINYUTC_MONTH_NAME_SLOT(word)];
+
+    return slot[0] == word ? (int)slot[1] : -1;
+}
+
+#endif // TINYUTC_NAMES_H
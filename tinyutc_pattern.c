@@ -0,0 +1,448 @@
+/**
+ * @file tinyutc_pattern.c
+ * @brief Precompiled date and time patterns for TinyUTC library.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "tinyutc.h"
+#include "iso8601_parser.h"
+#include "tinyutc_pattern.h"
+#include "tinyutc_digits.h"
+#include "tinyutc_names.h"
+
+enum _TinyUTCPatternOp
+{
+    _TINYUTC_PATTERN_YEAR,          // %Y
+    _TINYUTC_PATTERN_YEAR_2,        // %y
+    _TINYUTC_PATTERN_MONTH,         // %m
+    _TINYUTC_PATTERN_MONTH_NAME,    // %b
+    _TINYUTC_PATTERN_DAY,           // %d
+    _TINYUTC_PATTERN_DAY_SPACE,     // %e
+    _TINYUTC_PATTERN_WEEK_DAY_NAME, // %a
+    _TINYUTC_PATTERN_HOUR,          // %H
+    _TINYUTC_PATTERN_MINUTE,        // %M
+    _TINYUTC_PATTERN_SECOND,        // %S
+    _TINYUTC_PATTERN_MICROSECONDS,  // %f
+    _TINYUTC_PATTERN_MILLISECONDS,  // %L
+};
+
+#define _TINYUTC_PATTERN_BIT(OP) (1U << (OP))
+#define _TINYUTC_PATTERN_DATE_OPS                                                                                                       \
+    (_TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_YEAR) | _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_YEAR_2) |                                      \
+     _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_MONTH) | _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_MONTH_NAME) |                                 \
+     _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_DAY) | _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_DAY_SPACE) |                                    \
+     _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_WEEK_DAY_NAME))
+#define _TINYUTC_PATTERN_TIME_OPS                                                                                                       \
+    (_TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_HOUR) | _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_MINUTE) |                                      \
+     _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_SECOND))
+#define _TINYUTC_PATTERN_FRACTION_OPS                                                                                                   \
+    (_TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_MICROSECONDS) | _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_MILLISECONDS))
+
+#define _TINYUTC_PATTERN_ONES 0x0101010101010101ULL
+
+/**
+ * @brief Finds the op of a directive, with its width and the characters which are always digits.
+ *
+ * @return false for an unknown directive.
+ */
+static bool _pattern_directive(char directive, uint8_t *op, uint8_t *width, uint8_t *first_digit)
+{
+    // Op, width, and first digit (the width for names) of each directive
+    static const struct
+    {
+        char directive;
+        uint8_t op, width, first_digit;
+    } directives[] = {
+        {'Y', _TINYUTC_PATTERN_YEAR, 4, 0},          {'y', _TINYUTC_PATTERN_YEAR_2, 2, 0},
+        {'m', _TINYUTC_PATTERN_MONTH, 2, 0},         {'b', _TINYUTC_PATTERN_MONTH_NAME, 3, 3},
+        {'d', _TINYUTC_PATTERN_DAY, 2, 0},           {'e', _TINYUTC_PATTERN_DAY_SPACE, 2, 1},
+        {'a', _TINYUTC_PATTERN_WEEK_DAY_NAME, 3, 3}, {'H', _TINYUTC_PATTERN_HOUR, 2, 0},
+        {'M', _TINYUTC_PATTERN_MINUTE, 2, 0},        {'S', _TINYUTC_PATTERN_SECOND, 2, 0},
+        {'f', _TINYUTC_PATTERN_MICROSECONDS, 6, 0},  {'L', _TINYUTC_PATTERN_MILLISECONDS, 3, 0},
+    };
+
+    // Searched only when a pattern is compiled
+    for (size_t i = 0; i < sizeof(directives) / sizeof(directives[0]); i++)
+    {
+        if (directives[i].directive == directive)
+        {
+            *op = directives[i].op;
+            *width = directives[i].width;
+            *first_digit = directives[i].first_digit;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Loads 8 characters in a word, the first one in the low byte.
+ */
+static inline uint64_t _pattern_load(const char *str)
+{
+    uint64_t word;
+
+    memcpy(&word, str, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+/**
+ * @brief Loads less than 8 characters in a word, the first one in the low byte.
+ */
+static inline uint64_t _pattern_load_short(const char *str, size_t count)
+{
+    uint64_t word = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        word |= (uint64_t)(unsigned char)str[i] << (8 * i);
+    }
+    return word;
+}
+
+err_t tinyutc_pattern_compile(struct TinyUTCPattern *pattern, const char *format)
+{
+    uint8_t digits[TINYUTC_PATTERN_MAX_WIDTH] = {0};
+    uint8_t literal_mask[TINYUTC_PATTERN_MAX_WIDTH] = {0};
+    uint8_t literals[TINYUTC_PATTERN_MAX_WIDTH] = {0};
+    size_t pos = 0;
+
+    if (pattern == 0 || format == 0)
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+    if (format[0] == '\0')
+    {
+        return TINYUTC_ISO8601_EMPTY_STRING;
+    }
+    memset(pattern, 0, sizeof(*pattern));
+
+    for (const char *c = format; *c != '\0'; c++)
+    {
+        uint8_t op, width, first_digit;
+
+        if (*c != '%' || c[1] == '%')
+        {
+            if (pos == TINYUTC_PATTERN_MAX_WIDTH)
+            {
+                return TINYUTC_ISO8601_INVALID_FORMAT;
+            }
+            c += *c == '%'; // "%%"
+            pattern->text[pos] = *c;
+            literals[pos] = (uint8_t)*c;
+            literal_mask[pos] = 0xFF;
+            pos++;
+            continue;
+        }
+
+        c++;
+        if (!_pattern_directive(*c, &op, &width, &first_digit) || pos + width > TINYUTC_PATTERN_MAX_WIDTH)
+        {
+            return TINYUTC_ISO8601_INVALID_FORMAT;
+        }
+        pattern->fields[pattern->field_count].op = op;
+        pattern->fields[pattern->field_count].pos = (uint8_t)pos;
+        pattern->field_count++;
+        pattern->field_set |= (uint16_t)_TINYUTC_PATTERN_BIT(op);
+        for (uint8_t i = 0; i < width; i++)
+        {
+            pattern->text[pos + i] = '0';
+            digits[pos + i] = i >= first_digit ? 0xFF : 0;
+        }
+        pos += width;
+    }
+
+    pattern->width = (uint8_t)pos;
+    pattern->word_count = (uint8_t)((pos + 7) / 8);
+    for (size_t w = 0; w < _TINYUTC_PATTERN_WORDS; w++)
+    {
+        pattern->digits[w] = _pattern_load((const char *)digits + 8 * w);
+        pattern->literal_mask[w] = _pattern_load((const char *)literal_mask + 8 * w);
+        pattern->literals[w] = _pattern_load((const char *)literals + 8 * w);
+    }
+    return TINYUTC_ISO8601_OK;
+}
+
+size_t tinyutc_pattern_width(const struct TinyUTCPattern *pattern)
+{
+    return pattern->width;
+}
+
+/**
+ * @brief Copies 1 to 33 bytes with fixed size copies, which overlap, as a variable size
+ *        copy would be a call, or a string instruction slow to start.
+ */
+static inline void _pattern_copy(char *dst, const char *src, size_t count)
+{
+    if (count >= 16)
+    {
+        memcpy(dst, src, 16);
+        memcpy(dst + count - 16, src + count - 16, 16);
+        if (count > 32)
+        {
+            dst[16] = src[16];
+        }
+    }
+    else if (count >= 8)
+    {
+        memcpy(dst, src, 8);
+        memcpy(dst + count - 8, src + count - 8, 8);
+    }
+    else if (count >= 4)
+    {
+        memcpy(dst, src, 4);
+        memcpy(dst + count - 4, src + count - 4, 4);
+    }
+    else
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            dst[i] = src[i];
+        }
+    }
+}
+
+/**
+ * @brief Reads a number of digits already checked.
+ */
+static inline uint32_t _pattern_number(const char *str, int count)
+{
+    uint32_t value = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        value = value * 10 + (uint32_t)(str[i] - '0');
+    }
+    return value;
+}
+
+/**
+ * @brief Checks the literal characters and the digits of a string of the width of a pattern.
+ *
+ * A digit byte has its high nibble at 3, still 3 after adding 6 (low nibble up to 9);
+ * other bytes are replaced by '0' for the check.
+ */
+static inline bool _pattern_check(const struct TinyUTCPattern *pattern, const char *str, size_t len)
+{
+    uint64_t mismatch = 0;
+
+    for (uint8_t w = 0; w < pattern->word_count; w++)
+    {
+        size_t count = len - 8 * (size_t)w;
+        uint64_t word, value;
+
+        if (count >= 8)
+        {
+            word = _pattern_load(str + 8 * w);
+        }
+        else if (len >= 8)
+        {
+            // Last characters, loaded with the ones before them rather than one by one
+            word = _pattern_load(str + len - 8) >> (8 * (8 - count));
+        }
+        else
+        {
+            word = _pattern_load_short(str, count);
+        }
+
+        value = (word & pattern->digits[w]) | (0x30 * _TINYUTC_PATTERN_ONES & ~pattern->digits[w]);
+        mismatch |= (word & pattern->literal_mask[w]) ^ pattern->literals[w];
+        mismatch |= ((value & 0xF0 * _TINYUTC_PATTERN_ONES) | (((value + 0x06 * _TINYUTC_PATTERN_ONES) & 0xF0 * _TINYUTC_PATTERN_ONES) >> 4)) ^
+                    0x33 * _TINYUTC_PATTERN_ONES;
+    }
+    return mismatch == 0;
+}
+
+err_t tinyutc_pattern_parse(const struct TinyUTCPattern *pattern, struct TinyUTCTime *utc_tm, const char *str, size_t len)
+{
+    struct TinyUTCTime local;
+    int week_day = -1;
+
+    if (pattern == 0 || utc_tm == 0 || str == 0 || len != pattern->width || !_pattern_check(pattern, str, len))
+    {
+        return TINYUTC_ISO8601_INVALID_FORMAT;
+    }
+
+    local = *utc_tm;
+    for (uint8_t i = 0; i < pattern->field_count; i++)
+    {
+        const char *field = str + pattern->fields[i].pos;
+        int value;
+
+        switch (pattern->fields[i].op)
+        {
+        case _TINYUTC_PATTERN_YEAR:
+            local.year = (uint16_t)_pattern_number(field, 4);
+            break;
+        case _TINYUTC_PATTERN_YEAR_2:
+            value = (int)_pattern_number(field, 2);
+            local.year = (uint16_t)(value < 69 ? 2000 + value : 1900 + value);
+            break;
+        case _TINYUTC_PATTERN_MONTH:
+            local.month = (uint8_t)_pattern_number(field, 2);
+            break;
+        case _TINYUTC_PATTERN_MONTH_NAME:
+            value = _tinyutc_month_from_name(field);
+            if (value < 0)
+            {
+                return TINYUTC_ISO8601_INVALID_FORMAT;
+            }
+            local.month = (uint8_t)value;
+            break;
+        case _TINYUTC_PATTERN_DAY:
+            local.day = (uint8_t)_pattern_number(field, 2);
+            break;
+        case _TINYUTC_PATTERN_DAY_SPACE:
+            // The second character is a checked digit, the first a space or a digit
+            if (field[0] != ' ' && (uint8_t)(field[0] - '0') > 9)
+            {
+                return TINYUTC_ISO8601_INVALID_FORMAT;
+            }
+            local.day = (uint8_t)(field[0] == ' ' ? (uint32_t)(field[1] - '0') : _pattern_number(field, 2));
+            break;
+        case _TINYUTC_PATTERN_WEEK_DAY_NAME:
+            week_day = _tinyutc_week_day_from_name(field);
+            if (week_day < 0)
+            {
+                return TINYUTC_ISO8601_INVALID_FORMAT;
+            }
+            break;
+        case _TINYUTC_PATTERN_HOUR:
+            local.hour = (uint8_t)_pattern_number(field, 2);
+            break;
+        case _TINYUTC_PATTERN_MINUTE:
+            local.minute = (uint8_t)_pattern_number(field, 2);
+            break;
+        case _TINYUTC_PATTERN_SECOND:
+            local.second = (uint8_t)_pattern_number(field, 2);
+            break;
+        case _TINYUTC_PATTERN_MICROSECONDS:
+            local.microseconds = _pattern_number(field, 6);
+            break;
+        case _TINYUTC_PATTERN_MILLISECONDS:
+            local.microseconds = _pattern_number(field, 3) * 1000;
+            break;
+        }
+    }
+
+    if ((pattern->field_set & _TINYUTC_PATTERN_TIME_OPS) && (local.hour > 23 || local.minute > 59 || local.second > 60))
+    {
+        return TINYUTC_ISO8601_INVALID_TIME;
+    }
+    if ((pattern->field_set & _TINYUTC_PATTERN_DATE_OPS) &&
+        (local.year < _TINYUTC_MIN_YEAR || local.month < 1 || local.month > 12 || local.day < 1 ||
+         local.day > _TINYUTC_GET_DAYS_IN_MONTH(local.month - 1, local.year) ||
+         (week_day >= 0 && tinyutc_get_week_day(&local, false) != week_day)))
+    {
+        return TINYUTC_ISO8601_INVALID_DATE;
+    }
+
+    *utc_tm = local;
+    return TINYUTC_ISO8601_OK;
+}
+
+/**
+ * @brief Checks the fields of a structure which a pattern writes.
+ */
+static bool _pattern_is_formattable(const struct TinyUTCPattern *pattern, const struct TinyUTCTime *utc_tm)
+{
+    uint16_t set = pattern->field_set;
+
+    if ((set & _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_YEAR)) && utc_tm->year > 9999)
+    {
+        return false;
+    }
+    if ((set & _TINYUTC_PATTERN_DATE_OPS) && (utc_tm->month < 1 || utc_tm->month > 12 || utc_tm->day < 1 || utc_tm->day > 31))
+    {
+        return false;
+    }
+    if ((set & _TINYUTC_PATTERN_BIT(_TINYUTC_PATTERN_WEEK_DAY_NAME)) && utc_tm->year < _TINYUTC_MIN_YEAR)
+    {
+        return false;
+    }
+    if ((set & _TINYUTC_PATTERN_TIME_OPS) && (utc_tm->hour > 23 || utc_tm->minute > 59 || utc_tm->second > 60))
+    {
+        return false;
+    }
+    return !(set & _TINYUTC_PATTERN_FRACTION_OPS) || utc_tm->microseconds <= 999999;
+}
+
+size_t tinyutc_pattern_format(const struct TinyUTCPattern *pattern, const struct TinyUTCTime *utc_tm, char *buf, size_t cap)
+{
+    if (pattern == 0 || utc_tm == 0 || buf == 0 || cap <= pattern->width || !_pattern_is_formattable(pattern, utc_tm))
+    {
+        return 0;
+    }
+
+    // Literals first, then the fields over their placeholders
+    _pattern_copy(buf, pattern->text, (size_t)pattern->width + 1);
+    for (uint8_t i = 0; i < pattern->field_count; i++)
+    {
+        char *field = buf + pattern->fields[i].pos;
+        uint32_t century;
+
+        switch (pattern->fields[i].op)
+        {
+        case _TINYUTC_PATTERN_YEAR:
+            century = _TINYUTC_DIV_100(utc_tm->year);
+            _tinyutc_format_pair(field, century);
+            _tinyutc_format_pair(field + 2, utc_tm->year - century * 100);
+            break;
+        case _TINYUTC_PATTERN_YEAR_2:
+            _tinyutc_format_pair(field, utc_tm->year - _TINYUTC_DIV_100(utc_tm->year) * 100);
+            break;
+        case _TINYUTC_PATTERN_MONTH:
+            _tinyutc_format_pair(field, utc_tm->month);
+            break;
+        case _TINYUTC_PATTERN_MONTH_NAME:
+            memcpy(field, _tinyutc_month_name(utc_tm->month), 3);
+            break;
+        case _TINYUTC_PATTERN_DAY:
+            _tinyutc_format_pair(field, utc_tm->day);
+            break;
+        case _TINYUTC_PATTERN_DAY_SPACE:
+            _tinyutc_format_pair(field, utc_tm->day);
+            if (field[0] == '0')
+            {
+                field[0] = ' ';
+            }
+            break;
+        case _TINYUTC_PATTERN_WEEK_DAY_NAME:
+            memcpy(field, _tinyutc_week_day_name((uint8_t)tinyutc_get_week_day(utc_tm, false)), 3);
+            break;
+        case _TINYUTC_PATTERN_HOUR:
+            _tinyutc_format_pair(field, utc_tm->hour);
+            break;
+        case _TINYUTC_PATTERN_MINUTE:
+            _tinyutc_format_pair(field, utc_tm->minute);
+            break;
+        case _TINYUTC_PATTERN_SECOND:
+            _tinyutc_format_pair(field, utc_tm->second);
+            break;
+        case _TINYUTC_PATTERN_MICROSECONDS:
+            _tinyutc_format_fraction(field, utc_tm->microseconds, 6);
+            break;
+        case _TINYUTC_PATTERN_MILLISECONDS:
+            _tinyutc_format_fraction(field, utc_tm->microseconds, 3);
+            break;
+        }
+    }
+
+    return pattern->width;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file tinyutc_pattern.h
+ * @brief Precompiled date and time patterns, for layouts other than ISO 8601.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * A pattern is written with `strftime` directives, e.g. "%d/%m/%Y %H:%M:%S", and
+ * compiled once to a program: the position of each field, and masks of the digits
+ * and literal characters. As every directive has a fixed width, parsing checks all
+ * digits and literals a word at a time, then reads the fields without any other
+ * check, and formatting copies the literals then writes the fields.
+ *
+ * Directives:
+ * - `%Y` year (4 digits), `%y` year of the century (2 digits, 1969 to 2068 when parsed)
+ * - `%m` month (2 digits), `%b` month abbreviation ("Jan")
+ * - `%d` day of the month (2 digits), `%e` day of the month padded with a space (" 6")
+ * - `%a` week day abbreviation ("Sun"), checked against the date when parsed
+ * - `%H` hour, `%M` minute, `%S` second (2 digits each)
+ * - `%f` microseconds (6 digits), `%L` milliseconds (3 digits)
+ * - `%%` a '%' character
+ */
+
+#ifndef TINYUTC_PATTERN_H
+#define TINYUTC_PATTERN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "tinyutc.h"
+#include "iso8601_parser.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define TINYUTC_PATTERN_MAX_WIDTH 32 // Characters of the dates, not of the pattern
+#define _TINYUTC_PATTERN_WORDS (TINYUTC_PATTERN_MAX_WIDTH / 8)
+#define _TINYUTC_PATTERN_MAX_FIELDS (TINYUTC_PATTERN_MAX_WIDTH / 2)
+
+    /**
+     * @struct TinyUTCPatternField
+     * @brief  Instruction of a compiled pattern: a field and its position in the dates.
+     */
+    struct TinyUTCPatternField
+    {
+        uint8_t op;
+        uint8_t pos;
+    };
+
+    /**
+     * @struct TinyUTCPattern
+     * @brief  Compiled pattern, see `tinyutc_pattern_compile`.
+     *
+     * Fields are not meant to be written by the user.
+     */
+    struct TinyUTCPattern
+    {
+        uint64_t digits[_TINYUTC_PATTERN_WORDS];       // 0xFF on the bytes of digit-only fields
+        uint64_t literal_mask[_TINYUTC_PATTERN_WORDS]; // 0xFF on the bytes of literal characters
+        uint64_t literals[_TINYUTC_PATTERN_WORDS];     // Literal characters, 0 elsewhere
+        char text[TINYUTC_PATTERN_MAX_WIDTH + 1];      // Literal characters, '0' in the fields, and a terminator
+        struct TinyUTCPatternField fields[_TINYUTC_PATTERN_MAX_FIELDS];
+        uint8_t field_count;
+        uint8_t width;      // Number of characters of the dates
+        uint8_t word_count; // Words covering `width` characters
+        uint16_t field_set; // Bit of each op used, to check only the fields of the pattern
+    };
+
+    /**
+     * @brief Compiles a pattern of `strftime` directives.
+     *
+     * @param[out] pattern The compiled pattern.
+     * @param[in]  format  Null-terminated pattern, e.g. "%d/%m/%Y %H:%M:%S".
+     * @return TINYUTC_ISO8601_OK on success, TINYUTC_ISO8601_INVALID_FORMAT for an unknown
+     *         or unfinished directive, or dates longer than `TINYUTC_PATTERN_MAX_WIDTH`, and
+     *         TINYUTC_ISO8601_EMPTY_STRING for an empty pattern.
+     */
+    err_t tinyutc_pattern_compile(struct TinyUTCPattern *pattern, const char *format);
+
+    /**
+     * @brief Returns the number of characters of the dates of a compiled pattern.
+     */
+    size_t tinyutc_pattern_width(const struct TinyUTCPattern *pattern);
+
+    /**
+     * @brief Parses a date with a compiled pattern.
+     *
+     * The whole string must match the pattern. Fields missing from the pattern are left
+     * as they are in `utc_tm`, e.g. the year of syslog dates ("%b %e %H:%M:%S"), and are
+     * used to check the others: the day of the month needs the month and the year.
+     *
+     * @param[in]     pattern The compiled pattern.
+     * @param[in,out] utc_tm  Pointer to the TinyUTCTime structure, updated on success only.
+     * @param[in]     str     The date, not necessarily null-terminated.
+     * @param[in]     len     Number of characters of `str`.
+     * @return TINYUTC_ISO8601_OK on success, TINYUTC_ISO8601_INVALID_FORMAT if the string does
+     *         not match the pattern, TINYUTC_ISO8601_INVALID_DATE for a date out of range or a
+     *         wrong week day, TINYUTC_ISO8601_INVALID_TIME for a time out of range.
+     */
+    err_t tinyutc_pattern_parse(const struct TinyUTCPattern *pattern, struct TinyUTCTime *utc_tm, const char *str, size_t len);
+
+    /**
+     * @brief Formats a UTC time structure with a compiled pattern.
+     *
+     * @param[in]  pattern The compiled pattern.
+     * @param[in]  utc_tm  Pointer to the TinyUTCTime structure to format.
+     * @param[out] buf     Buffer receiving the date and a terminating '\0'.
+     * @param[in]  cap     Size of `buf`, `tinyutc_pattern_width(pattern) + 1` is enough.
+     * @return The number of characters written, without the terminator, or 0 if `buf` is
+     *         too small or a field of the pattern is out of range (year after 9999 for `%Y`).
+     */
+    size_t tinyutc_pattern_format(const struct TinyUTCPattern *pattern, const struct TinyUTCTime *utc_tm, char *buf, size_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TINYUTC_PATTERN_H
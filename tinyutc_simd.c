@@ -0,0 +1,538 @@
+/**
+ * @file tinyutc_simd.c
+ * @brief SIMD kernels for bulk Unix timestamp to UTC time conversions.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "tinyutc.h"
+#include "tinyutc_simd.h"
+
+#if !defined(TINYUTC_NO_SIMD) && defined(__GNUC__) && defined(__SSE2__)
+#define _TINYUTC_SIMD_X86
+#include <immintrin.h>
+#define _TINYUTC_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if !defined(TINYUTC_NO_SIMD) && defined(__ARM_NEON) && defined(__aarch64__)
+#define _TINYUTC_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// Kernels load timestamps as 32 bits unsigned lanes
+#define _TINYUTC_SIMD_TIME_IS_U32 (sizeof(tinyutc_time_t) == sizeof(uint32_t) && (tinyutc_time_t)-1 > 0)
+
+/**
+ * Divisions by constants are computed as (x * MAGIC) >> (32 + SHIFT), with the
+ * high half of a 32x32->64 multiplication. Each magic number has been checked
+ * exhaustively over the range of values it is applied to:
+ *  - 86400:  whole 32 bits range (timestamp to days)
+ *  - 3600:   [0, 86399]  (seconds of the day to hours)
+ *  - 60:     [0, 3599]   (seconds of the hour to minutes)
+ *  - 1460, 36524 and 365: [0, 146096] (day of era)
+ *  - 100:    [0, 399]    (year of era)
+ *  - 153:    [0, 1827]   (5 * day of year + 2)
+ *  - 5:      [0, 1685]   (153 * month + 2)
+ */
+#define _TINYUTC_MAGIC_DIV_86400 0xC22E4507U
+#define _TINYUTC_SHIFT_DIV_86400 16
+#define _TINYUTC_MAGIC_DIV_3600 0x00123457U
+#define _TINYUTC_MAGIC_DIV_60 0x04444445U
+#define _TINYUTC_MAGIC_DIV_1460 0x002CE33FU
+#define _TINYUTC_MAGIC_DIV_36524 0x000396B3U
+#define _TINYUTC_SHIFT_DIV_36524 1
+#define _TINYUTC_MAGIC_DIV_365 0x00B38CFAU
+#define _TINYUTC_MAGIC_DIV_100 0x028F5C29U
+#define _TINYUTC_MAGIC_DIV_153 0x01AC5702U
+#define _TINYUTC_MAGIC_DIV_5 0x33333334U
+
+/**
+ * 32 bits timestamps span days [0, 49710], so once shifted to start on 0000-03-01
+ * (see `_tinyutc_civil_from_days`), they all belong to era 4 or 5. The era is
+ * then a single comparison instead of a division.
+ */
+#define _TINYUTC_ERA_4_FIRST_DAY (4 * _TINYUTC_DAYS_PER_ERA)
+#define _TINYUTC_ERA_5_FIRST_DAY (5 * _TINYUTC_DAYS_PER_ERA)
+
+enum _TinyUTCSimdField
+{
+    _TINYUTC_FIELD_YEAR,
+    _TINYUTC_FIELD_MONTH,
+    _TINYUTC_FIELD_DAY,
+    _TINYUTC_FIELD_HOUR,
+    _TINYUTC_FIELD_MINUTE,
+    _TINYUTC_FIELD_SECOND,
+    _TINYUTC_FIELD_COUNT,
+};
+
+typedef void (*_tinyutc_columns_kernel_t)(const struct TinyUTCColumns *columns, const uint32_t *unix_ts, size_t count);
+
+// Scalar kernel, also used for the tail of the other kernels
+static void _tinyutc_scalar_kernel(const struct TinyUTCColumns *columns, const uint32_t *unix_ts, size_t count)
+{
+    // 32 bits timestamps are always in range
+    (void)_tinyutc_unix_to_utc_columns(columns->year, columns->month, columns->day,
+                                       columns->hour, columns->minute, columns->second, (const tinyutc_time_t *)unix_ts, count);
+}
+
+static void _tinyutc_scalar_tail(const struct TinyUTCColumns *columns, const uint32_t *unix_ts, size_t done, size_t count)
+{
+    struct TinyUTCColumns tail = {
+        columns->year + done,
+        columns->month + done,
+        columns->day + done,
+        columns->hour + done,
+        columns->minute + done,
+        columns->second + done};
+
+    _tinyutc_scalar_kernel(&tail, unix_ts + done, count - done);
+}
+
+#ifdef _TINYUTC_SIMD_X86
+
+/*
+ * SSE2 kernel, 4 lanes per vector, 2 vectors per iteration.
+ */
+
+static inline __m128i _tinyutc_sse2_mulhi(__m128i a, uint32_t magic)
+{
+    __m128i m = _mm_set1_epi32((int)magic);
+    __m128i even = _mm_srli_epi64(_mm_mul_epu32(a, m), 32);
+    __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+
+    return _mm_or_si128(even, _mm_and_si128(odd, _mm_set_epi32(-1, 0, -1, 0)));
+}
+
+// SSE2 has no 32 bits low multiplication, build it from two 32x32->64 ones
+static inline __m128i _tinyutc_sse2_mullo(__m128i a, uint32_t factor)
+{
+    __m128i f = _mm_set1_epi32((int)factor);
+    __m128i even = _mm_shuffle_epi32(_mm_mul_epu32(a, f), _MM_SHUFFLE(0, 0, 2, 0));
+    __m128i odd = _mm_shuffle_epi32(_mm_mul_epu32(_mm_srli_epi64(a, 32), f), _MM_SHUFFLE(0, 0, 2, 0));
+
+    return _mm_unpacklo_epi32(even, odd);
+}
+
+static inline void _tinyutc_sse2_decompose(__m128i ts, __m128i fields[_TINYUTC_FIELD_COUNT])
+{
+    __m128i days, secs, is_era_5, doe, yoe, doy, mp, is_jan_feb;
+
+    // Time of the day
+    days = _mm_srli_epi32(_tinyutc_sse2_mulhi(ts, _TINYUTC_MAGIC_DIV_86400), _TINYUTC_SHIFT_DIV_86400);
+    secs = _mm_sub_epi32(ts, _tinyutc_sse2_mullo(days, _TINYUTC_SECS_PER_DAY));
+    fields[_TINYUTC_FIELD_HOUR] = _tinyutc_sse2_mulhi(secs, _TINYUTC_MAGIC_DIV_3600);
+    secs = _mm_sub_epi32(secs, _tinyutc_sse2_mullo(fields[_TINYUTC_FIELD_HOUR], _TINYUTC_SECS_PER_HOUR));
+    fields[_TINYUTC_FIELD_MINUTE] = _tinyutc_sse2_mulhi(secs, _TINYUTC_MAGIC_DIV_60);
+    fields[_TINYUTC_FIELD_SECOND] = _mm_sub_epi32(secs, _tinyutc_sse2_mullo(fields[_TINYUTC_FIELD_MINUTE], _TINYUTC_SECS_PER_MIN));
+
+    // Civil from days, see _tinyutc_civil_from_days
+    days = _mm_add_epi32(days, _mm_set1_epi32(_TINYUTC_DAYS_FROM_CIVIL_TO_UNIX_EPOCH));
+    is_era_5 = _mm_cmpgt_epi32(days, _mm_set1_epi32(_TINYUTC_ERA_5_FIRST_DAY - 1));
+    doe = _mm_sub_epi32(_mm_sub_epi32(days, _mm_set1_epi32(_TINYUTC_ERA_4_FIRST_DAY)),
+                        _mm_and_si128(is_era_5, _mm_set1_epi32(_TINYUTC_DAYS_PER_ERA)));
+
+    // yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365, the last division being a comparison
+    yoe = _mm_sub_epi32(doe, _tinyutc_sse2_mulhi(doe, _TINYUTC_MAGIC_DIV_1460));
+    yoe = _mm_add_epi32(yoe, _mm_srli_epi32(_tinyutc_sse2_mulhi(doe, _TINYUTC_MAGIC_DIV_36524), _TINYUTC_SHIFT_DIV_36524));
+    yoe = _mm_add_epi32(yoe, _mm_cmpeq_epi32(doe, _mm_set1_epi32(_TINYUTC_DAYS_PER_ERA - 1)));
+    yoe = _tinyutc_sse2_mulhi(yoe, _TINYUTC_MAGIC_DIV_365);
+
+    // doy = doe - (365 * yoe + yoe / 4 - yoe / 100)
+    doy = _mm_add_epi32(_tinyutc_sse2_mullo(yoe, 365), _mm_srli_epi32(yoe, 2));
+    doy = _mm_sub_epi32(doe, _mm_sub_epi32(doy, _tinyutc_sse2_mulhi(yoe, _TINYUTC_MAGIC_DIV_100)));
+
+    // mp = (5 * doy + 2) / 153, day = doy - (153 * mp + 2) / 5 + 1
+    mp = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(doy, 2), doy), _mm_set1_epi32(2));
+    mp = _tinyutc_sse2_mulhi(mp, _TINYUTC_MAGIC_DIV_153);
+    fields[_TINYUTC_FIELD_DAY] = _mm_add_epi32(_tinyutc_sse2_mullo(mp, 153), _mm_set1_epi32(2));
+    fields[_TINYUTC_FIELD_DAY] = _tinyutc_sse2_mulhi(fields[_TINYUTC_FIELD_DAY], _TINYUTC_MAGIC_DIV_5);
+    fields[_TINYUTC_FIELD_DAY] = _mm_add_epi32(_mm_sub_epi32(doy, fields[_TINYUTC_FIELD_DAY]), _mm_set1_epi32(1));
+
+    // January and February (mp >= 10) are the last months of the March based year
+    is_jan_feb = _mm_cmpgt_epi32(mp, _mm_set1_epi32(9));
+    fields[_TINYUTC_FIELD_MONTH] = _mm_sub_epi32(_mm_add_epi32(mp, _mm_set1_epi32(3)), _mm_and_si128(is_jan_feb, _mm_set1_epi32(12)));
+    fields[_TINYUTC_FIELD_YEAR] = _mm_add_epi32(_mm_add_epi32(yoe, _mm_set1_epi32(4 * 400)), _mm_and_si128(is_era_5, _mm_set1_epi32(400)));
+    fields[_TINYUTC_FIELD_YEAR] = _mm_sub_epi32(fields[_TINYUTC_FIELD_YEAR], is_jan_feb);
+}
+
+static void _tinyutc_sse2_kernel(const struct TinyUTCColumns *columns, const uint32_t *unix_ts, size_t count)
+{
+    __m128i lo[_TINYUTC_FIELD_COUNT], hi[_TINYUTC_FIELD_COUNT];
+    uint8_t *bytes_columns[_TINYUTC_FIELD_COUNT] = {0, columns->month, columns->day, columns->hour, columns->minute, columns->second};
+    size_t i;
+
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        _tinyutc_sse2_decompose(_mm_loadu_si128((const __m128i *)(unix_ts + i)), lo);
+        _tinyutc_sse2_decompose(_mm_loadu_si128((const __m128i *)(unix_ts + i + 4)), hi);
+
+        // All fields fit in signed 16 bits, and all but the year fit in 8 bits
+        _mm_storeu_si128((__m128i *)(columns->year + i), _mm_packs_epi32(lo[_TINYUTC_FIELD_YEAR], hi[_TINYUTC_FIELD_YEAR]));
+        for (int field = _TINYUTC_FIELD_MONTH; field < _TINYUTC_FIELD_COUNT; field++)
+        {
+            __m128i words = _mm_packs_epi32(lo[field], hi[field]);
+            _mm_storel_epi64((__m128i *)(bytes_columns[field] + i), _mm_packus_epi16(words, words));
+        }
+    }
+
+    _tinyutc_scalar_tail(columns, unix_ts, i, count);
+}
+
+/*
+ * AVX2 kernel, 8 lanes per vector.
+ */
+
+_TINYUTC_TARGET("avx2")
+static inline __m256i _tinyutc_avx2_mulhi(__m256i a, uint32_t magic)
+{
+    __m256i m = _mm256_set1_epi32((int)magic);
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, m), 32);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+
+_TINYUTC_TARGET("avx2")
+static inline __m256i _tinyutc_avx2_mullo(__m256i a, uint32_t factor)
+{
+    return _mm256_mullo_epi32(a, _mm256_set1_epi32((int)factor));
+}
+
+_TINYUTC_TARGET("avx2")
+static inline void _tinyutc_avx2_decompose(__m256i ts, __m256i fields[_TINYUTC_FIELD_COUNT])
+{
+    __m256i days, secs, is_era_5, doe, yoe, doy, mp, is_jan_feb;
+
+    // Time of the day
+    days = _mm256_srli_epi32(_tinyutc_avx2_mulhi(ts, _TINYUTC_MAGIC_DIV_86400), _TINYUTC_SHIFT_DIV_86400);
+    secs = _mm256_sub_epi32(ts, _tinyutc_avx2_mullo(days, _TINYUTC_SECS_PER_DAY));
+    fields[_TINYUTC_FIELD_HOUR] = _tinyutc_avx2_mulhi(secs, _TINYUTC_MAGIC_DIV_3600);
+    secs = _mm256_sub_epi32(secs, _tinyutc_avx2_mullo(fields[_TINYUTC_FIELD_HOUR], _TINYUTC_SECS_PER_HOUR));
+    fields[_TINYUTC_FIELD_MINUTE] = _tinyutc_avx2_mulhi(secs, _TINYUTC_MAGIC_DIV_60);
+    fields[_TINYUTC_FIELD_SECOND] = _mm256_sub_epi32(secs, _tinyutc_avx2_mullo(fields[_TINYUTC_FIELD_MINUTE], _TINYUTC_SECS_PER_MIN));
+
+    // Civil from days, see _tinyutc_civil_from_days
+    days = _mm256_add_epi32(days, _mm256_set1_epi32(_TINYUTC_DAYS_FROM_CIVIL_TO_UNIX_EPOCH));
+    is_era_5 = _mm256_cmpgt_epi32(days, _mm256_set1_epi32(_TINYUTC_ERA_5_FIRST_DAY - 1));
+    doe = _mm256_sub_epi32(_mm256_sub_epi32(days, _mm256_set1_epi32(_TINYUTC_ERA_4_FIRST_DAY)),
+                           _mm256_and_si256(is_era_5, _mm256_set1_epi32(_TINYUTC_DAYS_PER_ERA)));
+
+    yoe = _mm256_sub_epi32(doe, _tinyutc_avx2_mulhi(doe, _TINYUTC_MAGIC_DIV_1460));
+    yoe = _mm256_add_epi32(yoe, _mm256_srli_epi32(_tinyutc_avx2_mulhi(doe, _TINYUTC_MAGIC_DIV_36524), _TINYUTC_SHIFT_DIV_36524));
+    yoe = _mm256_add_epi32(yoe, _mm256_cmpeq_epi32(doe, _mm256_set1_epi32(_TINYUTC_DAYS_PER_ERA - 1)));
+    yoe = _tinyutc_avx2_mulhi(yoe, _TINYUTC_MAGIC_DIV_365);
+
+    doy = _mm256_add_epi32(_tinyutc_avx2_mullo(yoe, 365), _mm256_srli_epi32(yoe, 2));
+    doy = _mm256_sub_epi32(doe, _mm256_sub_epi32(doy, _tinyutc_avx2_mulhi(yoe, _TINYUTC_MAGIC_DIV_100)));
+
+    mp = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(doy, 2), doy), _mm256_set1_epi32(2));
+    mp = _tinyutc_avx2_mulhi(mp, _TINYUTC_MAGIC_DIV_153);
+    fields[_TINYUTC_FIELD_DAY] = _mm256_add_epi32(_tinyutc_avx2_mullo(mp, 153), _mm256_set1_epi32(2));
+    fields[_TINYUTC_FIELD_DAY] = _tinyutc_avx2_mulhi(fields[_TINYUTC_FIELD_DAY], _TINYUTC_MAGIC_DIV_5);
+    fields[_TINYUTC_FIELD_DAY] = _mm256_add_epi32(_mm256_sub_epi32(doy, fields[_TINYUTC_FIELD_DAY]), _mm256_set1_epi32(1));
+
+    is_jan_feb = _mm256_cmpgt_epi32(mp, _mm256_set1_epi32(9));
+    fields[_TINYUTC_FIELD_MONTH] = _mm256_sub_epi32(_mm256_add_epi32(mp, _mm256_set1_epi32(3)), _mm256_and_si256(is_jan_feb, _mm256_set1_epi32(12)));
+    fields[_TINYUTC_FIELD_YEAR] = _mm256_add_epi32(_mm256_add_epi32(yoe, _mm256_set1_epi32(4 * 400)), _mm256_and_si256(is_era_5, _mm256_set1_epi32(400)));
+    fields[_TINYUTC_FIELD_YEAR] = _mm256_sub_epi32(fields[_TINYUTC_FIELD_YEAR], is_jan_feb);
+}
+
+_TINYUTC_TARGET("avx2")
+static void _tinyutc_avx2_kernel(const struct TinyUTCColumns *columns, const uint32_t *unix_ts, size_t count)
+{
+    __m256i fields[_TINYUTC_FIELD_COUNT];
+    uint8_t *bytes_columns[_TINYUTC_FIELD_COUNT] = {0, columns->month, columns->day, columns->hour, columns->minute, columns->second};
+    size_t i;
+
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        _tinyutc_avx2_decompose(_mm256_loadu_si256((const __m256i *)(unix_ts + i)), fields);
+
+        // Packing works on 128 bits lanes, so split the vectors first
+        _mm_storeu_si128((__m128i *)(columns->year + i), _mm_packs_epi32(_mm256_castsi256_si128(fields[_TINYUTC_FIELD_YEAR]),
+                                                                         _mm256_extracti128_si256(fields[_TINYUTC_FIELD_YEAR], 1)));
+        for (int field = _TINYUTC_FIELD_MONTH; field < _TINYUTC_FIELD_COUNT; field++)
+        {
+            __m128i words = _mm_packs_epi32(_mm256_castsi256_si128(fields[field]), _mm256_extracti128_si256(fields[field], 1));
+            _mm_storel_epi64((__m128i *)(bytes_columns[field] + i), _mm_packus_epi16(words, words));
+        }
+    }
+
+    _tinyutc_scalar_tail(columns, unix_ts, i, count);
+}
+
+/*
+ * AVX-512 kernel, 16 lanes per vector. Comparisons produce masks instead of vectors.
+ */
+
+_TINYUTC_TARGET("avx512f")
+static inline __m512i _tinyutc_avx512_mulhi(__m512i a, uint32_t magic)
+{
+    __m512i m = _mm512_set1_epi32((int)magic);
+    __m512i even = _mm512_srli_epi64(_mm512_mul_epu32(a, m), 32);
+    __m512i odd = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), m);
+
+    return _mm512_mask_blend_epi32(0xAAAA, even, odd);
+}
+
+_TINYUTC_TARGET("avx512f")
+static inline __m512i _tinyutc_avx512_mullo(__m512i a, uint32_t factor)
+{
+    return _mm512_mullo_epi32(a, _mm512_set1_epi32((int)factor));
+}
+
+_TINYUTC_TARGET("avx512f")
+static inline void _tinyutc_avx512_decompose(__m512i ts, __m512i fields[_TINYUTC_FIELD_COUNT])
+{
+    __m512i days, secs, doe, yoe, doy, mp;
+    __mmask16 is_era_5, is_jan_feb;
+
+    // Time of the day
+    days = _mm512_srli_epi32(_tinyutc_avx512_mulhi(ts, _TINYUTC_MAGIC_DIV_86400), _TINYUTC_SHIFT_DIV_86400);
+    secs = _mm512_sub_epi32(ts, _tinyutc_avx512_mullo(days, _TINYUTC_SECS_PER_DAY));
+    fields[_TINYUTC_FIELD_HOUR] = _tinyutc_avx512_mulhi(secs, _TINYUTC_MAGIC_DIV_3600);
+    secs = _mm512_sub_epi32(secs, _tinyutc_avx512_mullo(fields[_TINYUTC_FIELD_HOUR], _TINYUTC_SECS_PER_HOUR));
+    fields[_TINYUTC_FIELD_MINUTE] = _tinyutc_avx512_mulhi(secs, _TINYUTC_MAGIC_DIV_60);
+    fields[_TINYUTC_FIELD_SECOND] = _mm512_sub_epi32(secs, _tinyutc_avx512_mullo(fields[_TINYUTC_FIELD_MINUTE], _TINYUTC_SECS_PER_MIN));
+
+    // Civil from days, see _tinyutc_civil_from_days
+    days = _mm512_add_epi32(days, _mm512_set1_epi32(_TINYUTC_DAYS_FROM_CIVIL_TO_UNIX_EPOCH));
+    is_era_5 = _mm512_cmpge_epu32_mask(days, _mm512_set1_epi32(_TINYUTC_ERA_5_FIRST_DAY));
+    doe = _mm512_sub_epi32(days, _mm512_set1_epi32(_TINYUTC_ERA_4_FIRST_DAY));
+    doe = _mm512_mask_sub_epi32(doe, is_era_5, doe, _mm512_set1_epi32(_TINYUTC_DAYS_PER_ERA));
+
+    yoe = _mm512_sub_epi32(doe, _tinyutc_avx512_mulhi(doe, _TINYUTC_MAGIC_DIV_1460));
+    yoe = _mm512_add_epi32(yoe, _mm512_srli_epi32(_tinyutc_avx512_mulhi(doe, _TINYUTC_MAGIC_DIV_36524), _TINYUTC_SHIFT_DIV_36524));
+    yoe = _mm512_mask_sub_epi32(yoe, _mm512_cmpeq_epu32_mask(doe, _mm512_set1_epi32(_TINYUTC_DAYS_PER_ERA - 1)), yoe, _mm512_set1_epi32(1));
+    yoe = _tinyutc_avx512_mulhi(yoe, _TINYUTC_MAGIC_DIV_365);
+
+    doy = _mm512_add_epi32(_tinyutc_avx512_mullo(yoe, 365), _mm512_srli_epi32(yoe, 2));
+    doy = _mm512_sub_epi32(doe, _mm512_sub_epi32(doy, _tinyutc_avx512_mulhi(yoe, _TINYUTC_MAGIC_DIV_100)));
+
+    mp = _mm512_add_epi32(_mm512_add_epi32(_mm512_slli_epi32(doy, 2), doy), _mm512_set1_epi32(2));
+    mp = _tinyutc_avx512_mulhi(mp, _TINYUTC_MAGIC_DIV_153);
+    fields[_TINYUTC_FIELD_DAY] = _mm512_add_epi32(_tinyutc_avx512_mullo(mp, 153), _mm512_set1_epi32(2));
+    fields[_TINYUTC_FIELD_DAY] = _tinyutc_avx512_mulhi(fields[_TINYUTC_FIELD_DAY], _TINYUTC_MAGIC_DIV_5);
+    fields[_TINYUTC_FIELD_DAY] = _mm512_add_epi32(_mm512_sub_epi32(doy, fields[_TINYUTC_FIELD_DAY]), _mm512_set1_epi32(1));
+
+    is_jan_feb = _mm512_cmpgt_epu32_mask(mp, _mm512_set1_epi32(9));
+    fields[_TINYUTC_FIELD_MONTH] = _mm512_add_epi32(mp, _mm512_set1_epi32(3));
+    fields[_TINYUTC_FIELD_MONTH] = _mm512_mask_sub_epi32(fields[_TINYUTC_FIELD_MONTH], is_jan_feb, fields[_TINYUTC_FIELD_MONTH], _mm512_set1_epi32(12));
+    fields[_TINYUTC_FIELD_YEAR] = _mm512_add_epi32(yoe, _mm512_set1_epi32(4 * 400));
+    fields[_TINYUTC_FIELD_YEAR] = _mm512_mask_add_epi32(fields[_TINYUTC_FIELD_YEAR], is_era_5, fields[_TINYUTC_FIELD_YEAR], _mm512_set1_epi32(400));
+    fields[_TINYUTC_FIELD_YEAR] = _mm512_mask_add_epi32(fields[_TINYUTC_FIELD_YEAR], is_jan_feb, fields[_TINYUTC_FIELD_YEAR], _mm512_set1_epi32(1));
+}
+
+_TINYUTC_TARGET("avx512f")
+static void _tinyutc_avx512_kernel(const struct TinyUTCColumns *columns, const uint32_t *unix_ts, size_t count)
+{
+    __m512i fields[_TINYUTC_FIELD_COUNT];
+    uint8_t *bytes_columns[_TINYUTC_FIELD_COUNT] = {0, columns->month, columns->day, columns->hour, columns->minute, columns->second};
+    size_t i;
+
+    for (i = 0; i + 16 <= count; i += 16)
+    {
+        _tinyutc_avx512_decompose(_mm512_loadu_si512((const void *)(unix_ts + i)), fields);
+
+        _mm256_storeu_si256((__m256i *)(columns->year + i), _mm512_cvtepi32_epi16(fields[_TINYUTC_FIELD_YEAR]));
+        for (int field = _TINYUTC_FIELD_MONTH; field < _TINYUTC_FIELD_COUNT; field++)
+        {
+            _mm_storeu_si128((__m128i *)(bytes_columns[field] + i), _mm512_cvtepi32_epi8(fields[field]));
+        }
+    }
+
+    _tinyutc_scalar_tail(columns, unix_ts, i, count);
+}
+
+#endif // _TINYUTC_SIMD_X86
+
+#ifdef _TINYUTC_SIMD_NEON
+
+/*
+ * NEON kernel, 4 lanes per vector, 2 vectors per iteration.
+ */
+
+static inline uint32x4_t _tinyutc_neon_mulhi(uint32x4_t a, uint32_t magic)
+{
+    uint64x2_t low = vmull_n_u32(vget_low_u32(a), magic);
+    uint64x2_t high = vmull_high_n_u32(a, magic);
+
+    return vcombine_u32(vshrn_n_u64(low, 32), vshrn_n_u64(high, 32));
+}
+
+// Comparison results are all ones in true lanes, turn them into a constant
+static inline uint32x4_t _tinyutc_neon_select(uint32x4_t mask, uint32_t value)
+{
+    return vandq_u32(mask, vdupq_n_u32(value));
+}
+
+static inline void _tinyutc_neon_decompose(uint32x4_t ts, uint32x4_t fields[_TINYUTC_FIELD_COUNT])
+{
+    uint32x4_t days, secs, is_era_5, doe, yoe, doy, mp, is_jan_feb;
+
+    // Time of the day
+    days = vshrq_n_u32(_tinyutc_neon_mulhi(ts, _TINYUTC_MAGIC_DIV_86400), _TINYUTC_SHIFT_DIV_86400);
+    secs = vmlsq_n_u32(ts, days, _TINYUTC_SECS_PER_DAY);
+    fields[_TINYUTC_FIELD_HOUR] = _tinyutc_neon_mulhi(secs, _TINYUTC_MAGIC_DIV_3600);
+    secs = vmlsq_n_u32(secs, fields[_TINYUTC_FIELD_HOUR], _TINYUTC_SECS_PER_HOUR);
+    fields[_TINYUTC_FIELD_MINUTE] = _tinyutc_neon_mulhi(secs, _TINYUTC_MAGIC_DIV_60);
+    fields[_TINYUTC_FIELD_SECOND] = vmlsq_n_u32(secs, fields[_TINYUTC_FIELD_MINUTE], _TINYUTC_SECS_PER_MIN);
+
+    // Civil from days, see _tinyutc_civil_from_days
+    days = vaddq_u32(days, vdupq_n_u32(_TINYUTC_DAYS_FROM_CIVIL_TO_UNIX_EPOCH));
+    is_era_5 = vcgeq_u32(days, vdupq_n_u32(_TINYUTC_ERA_5_FIRST_DAY));
+    doe = vsubq_u32(vsubq_u32(days, vdupq_n_u32(_TINYUTC_ERA_4_FIRST_DAY)), _tinyutc_neon_select(is_era_5, _TINYUTC_DAYS_PER_ERA));
+
+    yoe = vsubq_u32(doe, _tinyutc_neon_mulhi(doe, _TINYUTC_MAGIC_DIV_1460));
+    yoe = vaddq_u32(yoe, vshrq_n_u32(_tinyutc_neon_mulhi(doe, _TINYUTC_MAGIC_DIV_36524), _TINYUTC_SHIFT_DIV_36524));
+    yoe = vaddq_u32(yoe, vceqq_u32(doe, vdupq_n_u32(_TINYUTC_DAYS_PER_ERA - 1)));
+    yoe = _tinyutc_neon_mulhi(yoe, _TINYUTC_MAGIC_DIV_365);
+
+    doy = vmlaq_n_u32(vshrq_n_u32(yoe, 2), yoe, 365);
+    doy = vsubq_u32(doe, vsubq_u32(doy, _tinyutc_neon_mulhi(yoe, _TINYUTC_MAGIC_DIV_100)));
+
+    mp = vmlaq_n_u32(vdupq_n_u32(2), doy, 5);
+    mp = _tinyutc_neon_mulhi(mp, _TINYUTC_MAGIC_DIV_153);
+    fields[_TINYUTC_FIELD_DAY] = _tinyutc_neon_mulhi(vmlaq_n_u32(vdupq_n_u32(2), mp, 153), _TINYUTC_MAGIC_DIV_5);
+    fields[_TINYUTC_FIELD_DAY] = vaddq_u32(vsubq_u32(doy, fields[_TINYUTC_FIELD_DAY]), vdupq_n_u32(1));
+
+    is_jan_feb = vcgtq_u32(mp, vdupq_n_u32(9));
+    fields[_TINYUTC_FIELD_MONTH] = vsubq_u32(vaddq_u32(mp, vdupq_n_u32(3)), _tinyutc_neon_select(is_jan_feb, 12));
+    fields[_TINYUTC_FIELD_YEAR] = vaddq_u32(vaddq_u32(yoe, vdupq_n_u32(4 * 400)), _tinyutc_neon_select(is_era_5, 400));
+    fields[_TINYUTC_FIELD_YEAR] = vsubq_u32(fields[_TINYUTC_FIELD_YEAR], is_jan_feb);
+}
+
+static void _tinyutc_neon_kernel(const struct TinyUTCColumns *columns, const uint32_t *unix_ts, size_t count)
+{
+    uint32x4_t lo[_TINYUTC_FIELD_COUNT], hi[_TINYUTC_FIELD_COUNT];
+    uint8_t *bytes_columns[_TINYUTC_FIELD_COUNT] = {0, columns->month, columns->day, columns->hour, columns->minute, columns->second};
+    size_t i;
+
+    for (i = 0; i + 8 <= count; i += 8)
+    {
+        _tinyutc_neon_decompose(vld1q_u32(unix_ts + i), lo);
+        _tinyutc_neon_decompose(vld1q_u32(unix_ts + i + 4), hi);
+
+        vst1q_u16(columns->year + i, vcombine_u16(vmovn_u32(lo[_TINYUTC_FIELD_YEAR]), vmovn_u32(hi[_TINYUTC_FIELD_YEAR])));
+        for (int field = _TINYUTC_FIELD_MONTH; field < _TINYUTC_FIELD_COUNT; field++)
+        {
+            vst1_u8(bytes_columns[field] + i, vmovn_u16(vcombine_u16(vmovn_u32(lo[field]), vmovn_u32(hi[field]))));
+        }
+    }
+
+    _tinyutc_scalar_tail(columns, unix_ts, i, count);
+}
+
+#endif // _TINYUTC_SIMD_NEON
+
+static _tinyutc_columns_kernel_t _tinyutc_get_kernel_function(enum TinyUTCSimdKernel kernel)
+{
+    if (!_TINYUTC_SIMD_TIME_IS_U32)
+    {
+        return kernel == TINYUTC_SIMD_SCALAR ? _tinyutc_scalar_kernel : 0;
+    }
+
+    switch (kernel)
+    {
+    case TINYUTC_SIMD_SCALAR:
+        return _tinyutc_scalar_kernel;
+#ifdef _TINYUTC_SIMD_X86
+    case TINYUTC_SIMD_SSE2:
+        return _tinyutc_sse2_kernel;
+    case TINYUTC_SIMD_AVX2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? _tinyutc_avx2_kernel : 0;
+    case TINYUTC_SIMD_AVX512:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") ? _tinyutc_avx512_kernel : 0;
+#endif
+#ifdef _TINYUTC_SIMD_NEON
+    case TINYUTC_SIMD_NEON:
+        return _tinyutc_neon_kernel;
+#endif
+    default:
+        return 0;
+    }
+}
+
+// Kernel in use, 0 until detected. A single atomic, so that threads calling the bulk API
+// at the same time never race on it, and racing detections all store the same kernel.
+static _Atomic(_tinyutc_columns_kernel_t) _tinyutc_kernel_function = 0;
+
+static _tinyutc_columns_kernel_t _tinyutc_load_kernel(void)
+{
+    _tinyutc_columns_kernel_t function = atomic_load_explicit(&_tinyutc_kernel_function, memory_order_relaxed);
+
+    if (function == 0)
+    {
+        // From the best to the worst
+        static const enum TinyUTCSimdKernel candidates[] = {TINYUTC_SIMD_AVX512, TINYUTC_SIMD_AVX2, TINYUTC_SIMD_SSE2, TINYUTC_SIMD_NEON};
+
+        for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]) && function == 0; i++)
+        {
+            function = _tinyutc_get_kernel_function(candidates[i]);
+        }
+        if (function == 0)
+        {
+            function = _tinyutc_scalar_kernel;
+        }
+        atomic_store_explicit(&_tinyutc_kernel_function, function, memory_order_relaxed);
+    }
+
+    return function;
+}
+
+err_t tinyutc_simd_set_kernel(enum TinyUTCSimdKernel kernel)
+{
+    _tinyutc_columns_kernel_t function = _tinyutc_get_kernel_function(kernel);
+
+    if (function == 0)
+    {
+        return -1; // Not available
+    }
+
+    atomic_store_explicit(&_tinyutc_kernel_function, function, memory_order_relaxed);
+
+    return 0;
+}
+
+enum TinyUTCSimdKernel tinyutc_simd_get_kernel(void)
+{
+    _tinyutc_columns_kernel_t function = _tinyutc_load_kernel();
+
+    // Found back from the function, each kernel having its own
+    for (int kernel = TINYUTC_SIMD_SCALAR; kernel <= TINYUTC_SIMD_NEON; kernel++)
+    {
+        if (_tinyutc_get_kernel_function((enum TinyUTCSimdKernel)kernel) == function)
+        {
+            return (enum TinyUTCSimdKernel)kernel;
+        }
+    }
+
+    return TINYUTC_SIMD_SCALAR;
+}
+
+err_t tinyutc_simd_unix_to_utc_columns(const struct TinyUTCColumns *columns, const tinyutc_time_t *unix_ts, size_t count)
+{
+    // Wider timestamps have no vector kernel, and may be out of range
+    if (!_TINYUTC_SIMD_TIME_IS_U32)
+    {
+        return tinyutc_unix_to_utc_batch_columns(columns, unix_ts, count);
+    }
+
+    _tinyutc_load_kernel()(columns, (const uint32_t *)unix_ts, count);
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file tinyutc_simd.h
+ * @brief SIMD kernels for bulk Unix timestamp to UTC time conversions.
+ * @author Ulysse Moreau
+ * @date 2025-05-02
+ * @version 2.0
+ * @license WTFPL (Do What The F*ck You Want To Public License)
+ *
+ * This program is free software. It comes without any warranty, to
+ * the extent permitted by applicable law. You can redistribute it
+ * and/or modify it under the terms of the Do What The Fuck You Want
+ * To Public License, Version 2, as published by Sam Hocevar. See
+ * http://www.wtfpl.net/ for more details.
+ *
+ * Kernels are written with SSE2, AVX2 and AVX-512 intrinsics on x86 (selected
+ * at runtime depending on the CPU), and NEON intrinsics on AArch64. They only
+ * apply to 32 bits timestamps: with any other `tinyutc_time_t`, or when built
+ * with `TINYUTC_NO_SIMD`, the scalar batch conversion is used. The kernel is
+ * detected on first use, and kept in an atomic, so any thread can convert (or
+ * change the kernel) at any time.
+ *
+ * The ISO 8601 datetime parser has its own SSE4.1, AVX2 and NEON kernels, for
+ * any `tinyutc_time_t`, in `iso8601_simd.c`.
+ */
+
+#ifndef TINYUTC_SIMD_H
+#define TINYUTC_SIMD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "tinyutc.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    enum TinyUTCSimdKernel
+    {
+        TINYUTC_SIMD_SCALAR = 0,
+        TINYUTC_SIMD_SSE2 = 1,
+        TINYUTC_SIMD_AVX2 = 2,
+        TINYUTC_SIMD_AVX512 = 3,
+        TINYUTC_SIMD_NEON = 4,
+        TINYUTC_SIMD_SSE41 = 5, // ISO 8601 parser only (iso8601_simd.h)
+    };
+
+    /**
+     * @brief Converts an array of Unix timestamps to UTC time columns, using the best
+     *        kernel available on the running CPU.
+     *
+     * Results are bit-identical to `tinyutc_unix_to_utc_batch_columns`.
+     *
+     * @param[out] columns Columns receiving the UTC time fields.
+     * @param[in]  unix_ts Array of `count` Unix timestamps to be converted.
+     * @param[in]  count   Number of timestamps to convert.
+     * @return err_t 0 on success, -1 if at least one timestamp is out of range
+     *         (as `tinyutc_unix_to_utc_batch_columns`).
+     */
+    err_t tinyutc_simd_unix_to_utc_columns(const struct TinyUTCColumns *columns, const tinyutc_time_t *unix_ts, size_t count);
+
+    /**
+     * @brief Returns the kernel used by `tinyutc_simd_unix_to_utc_columns`.
+     *
+     * The first call detects the best kernel supported by the running CPU.
+     *
+     * @return enum TinyUTCSimdKernel The kernel in use.
+     */
+    enum TinyUTCSimdKernel tinyutc_simd_get_kernel(void);
+
+    /**
+     * @brief Forces the kernel used by `tinyutc_simd_unix_to_utc_columns`.
+     *
+     * Mostly useful for tests and benchmarks.
+     *
+     * @param[in] kernel The kernel to use.
+     * @return err_t 0 on success, -1 if the kernel is not available on this build or CPU
+     *         (the kernel in use is then left unchanged).
+     */
+    err_t tinyutc_simd_set_kernel(enum TinyUTCSimdKernel kernel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TINYUTC_SIMD_H